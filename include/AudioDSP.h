@@ -0,0 +1,87 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <stddef.h>
+#include <imgui.h>
+#include <immat.h>
+
+// Float audio kernels for the built in audio nodes, processing in place.
+// Sample kernels use AVX2, SSE or NEON, whichever the target was built for,
+// and plain C otherwise. The biquad cascade addresses buffers as one pointer
+// per channel plus a sample stride, so the same call covers planar (stride 1)
+// and interleaved (stride = channels) layouts.
+namespace BluePrint
+{
+struct BiquadCoeffs
+{
+    float m_B0 {1.f};
+    float m_B1 {0.f};
+    float m_B2 {0.f};
+    float m_A1 {0.f};   // normalized by a0
+    float m_A2 {0.f};
+};
+
+// peaking band with its width in Hz (Q = freq / width), identity above Nyquist
+IMGUI_API BiquadCoeffs MakePeakingEQ(double sample_rate, double freq, double width, double gain_db);
+
+// Cascade of biquads sharing coefficients across channels, one vector lane per
+// channel. Coefficient changes ramp per sample over m_RampSamples so live
+// tweaks don't click.
+struct IMGUI_API BiquadCascade
+{
+    void Configure(int channels, int bands);    // clears the filter state
+    void SetTarget(int band, const BiquadCoeffs& coeffs, bool immediate = false);
+    void ClearState();
+    // channel c sample n is data[c][n * stride]
+    void Process(float* const* data, int stride, int frames);
+
+    int Channels() const { return m_Channels; }
+    int Bands() const { return m_Bands; }
+
+    int m_RampSamples {256};
+
+private:
+    struct Band
+    {
+        float m_Coeffs[5];      // b0 b1 b2 a1 a2 in use
+        float m_Target[5];
+        float m_Step[5];
+        int   m_RampLeft {0};
+    };
+
+    int m_Channels {0};
+    int m_Bands {0};
+    std::vector<Band> m_BandState;
+    std::vector<float> m_Z;     // per lane group, per band: z1[4] z2[4]
+    std::vector<float> m_Scratch;   // coefficients of one group while ramping
+};
+
+// ---[ Sample kernels ]---
+// count samples of one contiguous run, a plane or a whole interleaved block.
+// Ramps move linearly per sample from `from` to `to`, so a gain change spread
+// over a block doesn't produce zipper noise. dst may alias a source.
+enum class AudioFadeCurve : int32_t
+{
+    Linear = 0,
+    EqualPower,     // sqrt gains, the summed power stays constant through the fade
+};
+
+IMGUI_API void AudioGain(float* data, size_t count, float from, float to, bool clip = false);
+IMGUI_API void AudioClip(float* data, size_t count, float lo = -1.f, float hi = 1.f);
+// t goes from `from` to `to`, dst = a * (1 - t) + b * t for the linear curve
+IMGUI_API void AudioCrossfade(float* dst, const float* a, const float* b, size_t count, float from, float to, AudioFadeCurve curve, bool clip = false);
+IMGUI_API void AudioMix(float* dst, const float* src, size_t count, float gain);    // dst += src * gain
+IMGUI_API void AudioInterleave(float* dst, const float* const* planes, int channels, size_t frames);
+IMGUI_API void AudioDeinterleave(float* const* planes, const float* src, int channels, size_t frames);
+
+// ---[ ImMat helpers ]---
+// float32 mat the kernels can write to: src itself when nothing else holds its
+// buffer, a copy otherwise, and integer samples converted to planar float
+IMGUI_API ImGui::ImMat AudioWritableMat(ImGui::ImMat& src);
+// pointer to the first sample of each channel of a float mat, returns the sample stride
+IMGUI_API int AudioChannelPointers(ImGui::ImMat& mat, std::vector<float*>& channels);
+// interleaved float copy of any audio mat, resized to w * c
+IMGUI_API void AudioInterleaveMat(ImGui::ImMat& src, std::vector<float>& dst);
+
+IMGUI_API const char* AudioDSPBackend();    // "AVX2", "SSE", "NEON" or "C"
+} // namespace BluePrint
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <functional>
 #include <imgui_json.h>
 #include <variant.hpp> // variant
 # define span_FEATURE_MAKE_SPAN 1
@@ -53,7 +54,7 @@ using std::unique_ptr;
 namespace BluePrint
 {
 # pragma region fnv1a
-inline uint64_t fnv1a_hash_64(string str) 
+inline uint64_t fnv1a_hash_64(const string& str)
 {
     uint64_t prime = PRIME_64;
     uint64_t hash = OFFSET_64;
@@ -66,7 +67,7 @@ inline uint64_t fnv1a_hash_64(string str)
     return hash;
 }
 
-inline uint32_t fnv1a_hash_32(string str) 
+inline uint32_t fnv1a_hash_32(const string& str)
 {
     uint32_t prime = PRIME_32;
     uint32_t hash = OFFSET_32;
@@ -78,10 +79,19 @@ inline uint32_t fnv1a_hash_32(string str)
     // return correct digits, based on size
     return hash;
 }
+
+// compile-time variant, seed chains several strings into one hash
+constexpr uint32_t fnv1a_hash_32(const char* str, uint32_t hash = OFFSET_32)
+{
+    for (; *str; str++)
+        hash = (hash ^ *str) * PRIME_32;
+    return hash;
+}
 # pragma endregion
 
 struct NodeRegistry;
 struct Node;
+struct BinaryBlueprint;
 struct Context;
 enum class StepResult
 {
@@ -90,6 +100,62 @@ enum class StepResult
     Error
 };
 
+IMGUI_API const char * StepResultToString(StepResult stepResult);
+IMGUI_API std::string IDToHexString(const ID_TYPE i);
+IMGUI_API ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID);
+IMGUI_API std::string GetUserCacheDir(const std::string& sub = ""); // per user cache directory, created on demand, empty if unavailable
+
+# pragma region EditorHooks
+// Callbacks into the node editor. The UI layer installs them, a headless
+// BluePrintCore runs without them and every Editor:: call becomes a no-op.
+struct EditorHooks
+{
+    void   (*NodeChanged)(ID_TYPE node) {nullptr};
+    void   (*PinChanged)(ID_TYPE pin) {nullptr};
+    void   (*LinkChanged)(ID_TYPE link) {nullptr};
+    ImVec2 (*GetNodePosition)(ID_TYPE node) {nullptr};
+    void   (*SetNodePosition)(ID_TYPE node, const ImVec2& pos) {nullptr};
+    ImVec2 (*GetNodeSize)(ID_TYPE node) {nullptr};
+    void   (*SetNodeSize)(ID_TYPE node, const ImVec2& size) {nullptr};
+    ImVec2 (*GetGroupSize)(ID_TYPE node) {nullptr};
+    void   (*SetGroupSize)(ID_TYPE node, const ImVec2& size) {nullptr};
+    void   (*SetNodeGroupID)(ID_TYPE node, ID_TYPE group) {nullptr};
+    void   (*SetNodeZPosition)(ID_TYPE node, float z) {nullptr};
+    void   (*GetGroupedNodes)(ID_TYPE group, vector<ID_TYPE>& nodes) {nullptr};
+    void   (*BeginFlow)() {nullptr};
+    void   (*Flow)(ID_TYPE pin, bool forward) {nullptr};
+    void   (*EndFlow)() {nullptr};
+    ImVec2 (*ScreenToCanvas)(const ImVec2& pos) {nullptr};
+    void   (*Suspend)() {nullptr};
+    void   (*Resume)() {nullptr};
+};
+
+IMGUI_API void SetEditorHooks(const EditorHooks* hooks); // hooks must outlive every BP, nullptr for headless
+IMGUI_API const EditorHooks* GetEditorHooks();
+
+namespace Editor
+{
+IMGUI_API void SetNodeChanged(ID_TYPE node);
+IMGUI_API void SetPinChanged(ID_TYPE pin);
+IMGUI_API void SetLinkChanged(ID_TYPE link);
+IMGUI_API ImVec2 GetNodePosition(ID_TYPE node);
+IMGUI_API void SetNodePosition(ID_TYPE node, const ImVec2& pos);
+IMGUI_API ImVec2 GetNodeSize(ID_TYPE node);
+IMGUI_API void SetNodeSize(ID_TYPE node, const ImVec2& size);
+IMGUI_API ImVec2 GetGroupSize(ID_TYPE node);
+IMGUI_API void SetGroupSize(ID_TYPE node, const ImVec2& size);
+IMGUI_API void SetNodeGroupID(ID_TYPE node, ID_TYPE group);
+IMGUI_API void SetNodeZPosition(ID_TYPE node, float z);
+IMGUI_API void GetGroupedNodes(ID_TYPE group, vector<ID_TYPE>& nodes);
+IMGUI_API bool BeginFlow();
+IMGUI_API void Flow(ID_TYPE pin, bool forward);
+IMGUI_API void EndFlow();
+IMGUI_API ImVec2 ScreenToCanvas(const ImVec2& pos); // returns pos unchanged when headless
+IMGUI_API void Suspend(); // leave the editor canvas to draw popups in screen space
+IMGUI_API void Resume();
+} // namespace Editor
+# pragma endregion
+
 # pragma region IDGenerator
 struct IDGenerator
 {
@@ -297,6 +363,7 @@ struct IMGUI_API BP
     void InsertNode(Node* node);
 
     void ForgetPin(Pin* pin);
+    int ReloadNodes(ID_TYPE fromTypeId, ID_TYPE toTypeId); // recreate nodes of a reloaded type, keeping ids and links
 
     void Clear();
 
@@ -350,9 +417,12 @@ struct IMGUI_API BP
     int Load(const imgui_json::value& value);
     int Import(const imgui_json::value& value, ImVec2 pos);
     void Save(imgui_json::value& value) const;
+    // Same output as Save(), but Node::Save is only called for dirty nodes, clean ones reuse the cached json
+    void SaveIncremental(imgui_json::value& value, std::vector<ID_TYPE>* changed = nullptr, std::vector<ID_TYPE>* removed = nullptr) const;
 
-    int Load(std::string path);
-    bool Save(std::string path) const;
+    int Load(std::string path);     // json or binary, detected by file magic
+    bool Save(std::string path) const; // binary when path has BP_BINARY_EXTENSION
+    int Load(const BinaryBlueprint& file);
 
     ID_TYPE MakeNodeID(Node* node);
     ID_TYPE MakePinID(Pin* pin);
@@ -364,6 +434,11 @@ struct IMGUI_API BP
 
     std::vector<Pin*> FindPinsLinkedTo(const Pin& pin) const;
 
+    // Changes whenever a pin is added or removed or a link is made or broken,
+    // unique across blueprints so a cache keyed on it also notices a new document.
+    uint32_t GetLinkRevision() const { return m_LinkRevision; }
+    void TouchLinks();
+
     void OnContextRunDone();
     void OnContextPause();
     void OnContextResume();
@@ -374,6 +449,10 @@ struct IMGUI_API BP
 
 private:
     void ResetState();
+    using NodeTypeGetter = std::function<bool(size_t index, ID_TYPE& typeId)>;
+    using NodeValueGetter = std::function<const imgui_json::value*(size_t index, imgui_json::value& storage)>;
+    int LoadNodes(size_t count, const NodeTypeGetter& getType, const NodeValueGetter& getValue);
+    Node* LoadNode(Node* node, const imgui_json::value& nodeValue);
     Node * CreateDummyNode(const imgui_json::value& value, BP* blueprint);
 
     shared_ptr<NodeRegistry>        m_NodeRegistry;
@@ -381,9 +460,12 @@ private:
     IDGenerator                     m_Generator;
     std::vector<Node*>              m_Nodes;
     std::vector<Pin*>               m_Pins;
+    mutable std::map<ID_TYPE, imgui_json::value> m_SaveCache; // last json of every node, see SaveIncremental
+    std::atomic<uint32_t>           m_LinkRevision {0};
     Context                         m_Context;
     bool                            m_StyleLight {false};
     bool                            m_IsOpen {false};
+    bool                            m_DeferPinRegistration {false}; // set while LoadNodes workers are running
 };
 # pragma endregion
 
@@ -399,12 +481,17 @@ namespace BluePrint
 IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
 } // namespace BluePrint
 
+// type id is fnv1a("type*catalog"), folded at compile time
+# define BP_NODE_TYPE_ID(type, node_catalog) \
+    ::BluePrint::fnv1a_hash_32(node_catalog, ::BluePrint::fnv1a_hash_32("*", ::BluePrint::fnv1a_hash_32(#type)))
+
 # define BP_NODE(type, node_version, node_type, node_style, node_catalog) \
-    static ::BluePrint::NodeTypeInfo GetStaticTypeInfo() \
+    static constexpr ID_TYPE s_TypeID = BP_NODE_TYPE_ID(type, node_catalog); \
+    static const ::BluePrint::NodeTypeInfo& GetStaticTypeInfo() \
     { \
-        return \
+        static const ::BluePrint::NodeTypeInfo info \
         { \
-            fnv1a_hash_32(#type + string("*") + node_catalog), \
+            s_TypeID, \
             #type, \
             #type, \
             "CodeWin", \
@@ -415,19 +502,21 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
         }; \
+        return info; \
     } \
     \
-    ::BluePrint::NodeTypeInfo GetTypeInfo() const override \
+    const ::BluePrint::NodeTypeInfo& GetTypeInfo() const override \
     { \
         return GetStaticTypeInfo(); \
     }
 
 # define BP_NODE_WITH_NAME(type, name, node_version, node_type, node_style, node_catalog) \
-    static ::BluePrint::NodeTypeInfo GetStaticTypeInfo() \
+    static constexpr ID_TYPE s_TypeID = BP_NODE_TYPE_ID(type, node_catalog); \
+    static const ::BluePrint::NodeTypeInfo& GetStaticTypeInfo() \
     { \
-        return \
+        static const ::BluePrint::NodeTypeInfo info \
         { \
-            fnv1a_hash_32(#type + string("*") + node_catalog), \
+            s_TypeID, \
             #type, \
             name, \
             "CodeWin", \
@@ -438,9 +527,10 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_catalog, \
             [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
         }; \
+        return info; \
     } \
     \
-    ::BluePrint::NodeTypeInfo GetTypeInfo() const override \
+    const ::BluePrint::NodeTypeInfo& GetTypeInfo() const override \
     { \
         return GetStaticTypeInfo(); \
     }
@@ -459,7 +549,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
     extern "C" EXPORT BluePrint::NodeTypeInfo* create(BluePrint::BP* blueprint) { \
         return new BluePrint::NodeTypeInfo\
         ( \
-            BluePrint::fnv1a_hash_32(#type + string("*") + node_catalog), \
+            BP_NODE_TYPE_ID(type, node_catalog), \
             #type, \
             #type, \
             #author, \
@@ -0,0 +1,189 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <imgui_json.h>
+#include <imgui.h>
+
+// Binary blueprint container (*.bpb)
+//
+// The file is a flat little-endian image designed to be mapped in memory and
+// read in place. Everything BP::Save/Node::Save/Pin::Save writes with a fixed
+// meaning goes into fixed size records, every string is interned once in the
+// string table, and whatever a node (or pin) adds on top of that is kept as
+// an opaque compact json blob, so the JSON <-> binary round trip is lossless.
+//
+//   BinaryHeader
+//   BinaryString[string_count] + string bytes (NUL terminated)
+//   BinaryNode[node_count]
+//   BinaryPin[pin_count]         (input pins then output pins of each node)
+//   uint32_t[link_count]         (Pin::m_LinkFrom of every pin)
+//   blob area                    (compact json text)
+
+#define BP_BINARY_MAGIC             0x4E425042  // "BPBN"
+#define BP_BINARY_VERSION           1
+#define BP_BINARY_EXTENSION         ".bpb"
+
+namespace BluePrint
+{
+# pragma region BinaryRecords
+enum BinaryFileFlags : uint32_t
+{
+    BP_BINARY_FILE_DOCUMENT     = 1 << 0,   // blueprint lives at ["document"]["blueprint"]
+    BP_BINARY_FILE_STATE        = 1 << 1,   // m_GeneratorState is valid
+};
+
+enum BinaryNodeFields : uint32_t
+{
+    BP_BINARY_NODE_RAW          = 1 << 0,   // node isn't an object, whole value is in m_Extra
+    BP_BINARY_NODE_TYPE_ID      = 1 << 1,
+    BP_BINARY_NODE_ID           = 1 << 2,
+    BP_BINARY_NODE_GROUP_ID     = 1 << 3,
+    BP_BINARY_NODE_NAME         = 1 << 4,
+    BP_BINARY_NODE_TYPE_NAME    = 1 << 5,
+    BP_BINARY_NODE_TYPE         = 1 << 6,
+    BP_BINARY_NODE_STYLE        = 1 << 7,
+    BP_BINARY_NODE_CATALOG      = 1 << 8,
+    BP_BINARY_NODE_VERSION      = 1 << 9,
+    BP_BINARY_NODE_ENABLED      = 1 << 10,
+    BP_BINARY_NODE_BREAK_POINT  = 1 << 11,
+    BP_BINARY_NODE_INPUT_PINS   = 1 << 12,
+    BP_BINARY_NODE_OUTPUT_PINS  = 1 << 13,
+    BP_BINARY_NODE_ENABLED_ON   = 1 << 14,  // value of "enabled"
+    BP_BINARY_NODE_BREAK_ON     = 1 << 15,  // value of "break_point"
+};
+
+enum BinaryPinFields : uint32_t
+{
+    BP_BINARY_PIN_RAW           = 1 << 0,   // pin isn't an object, whole value is in m_Extra
+    BP_BINARY_PIN_ID            = 1 << 1,
+    BP_BINARY_PIN_LINK          = 1 << 2,
+    BP_BINARY_PIN_MAP           = 1 << 3,
+    BP_BINARY_PIN_FLAGS         = 1 << 4,
+    BP_BINARY_PIN_TYPE          = 1 << 5,
+    BP_BINARY_PIN_NAME          = 1 << 6,
+    BP_BINARY_PIN_LINK_FROM     = 1 << 7,
+};
+
+struct BinaryBlob
+{
+    uint64_t m_Offset;  // relative to BinaryHeader::m_BlobOffset
+    uint64_t m_Size;    // 0 means no blob
+};
+
+struct BinaryString
+{
+    uint32_t m_Offset;  // relative to the first byte after the BinaryString array
+    uint32_t m_Size;    // without the NUL terminator
+};
+
+struct BinaryHeader
+{
+    uint32_t    m_Magic;
+    uint32_t    m_Version;
+    uint32_t    m_SDK_Version;
+    uint32_t    m_Flags;
+    uint32_t    m_GeneratorState;
+    uint32_t    m_StringCount;
+    uint32_t    m_NodeCount;
+    uint32_t    m_PinCount;
+    uint32_t    m_LinkCount;
+    uint32_t    m_Reserved;
+    uint64_t    m_StringOffset;
+    uint64_t    m_NodeOffset;
+    uint64_t    m_PinOffset;
+    uint64_t    m_LinkOffset;
+    uint64_t    m_BlobOffset;
+    uint64_t    m_BlobSize;
+    uint64_t    m_FileSize;
+    BinaryBlob  m_Root;     // document/blueprint json without the nodes array
+};
+
+struct BinaryNode
+{
+    uint32_t    m_Fields;   // BinaryNodeFields
+    uint32_t    m_TypeID;
+    uint32_t    m_ID;
+    uint32_t    m_GroupID;
+    uint32_t    m_Name;     // string indices
+    uint32_t    m_TypeName;
+    uint32_t    m_Type;
+    uint32_t    m_Style;
+    uint32_t    m_Catalog;
+    uint32_t    m_Version;
+    uint32_t    m_InputPinStart;
+    uint32_t    m_InputPinCount;
+    uint32_t    m_OutputPinStart;
+    uint32_t    m_OutputPinCount;
+    BinaryBlob  m_Extra;
+};
+
+struct BinaryPin
+{
+    uint32_t    m_Fields;   // BinaryPinFields
+    uint32_t    m_ID;
+    uint32_t    m_Link;
+    uint32_t    m_Map;
+    uint32_t    m_Flags;
+    uint32_t    m_Type;     // string indices
+    uint32_t    m_Name;
+    uint32_t    m_LinkFromStart;
+    uint32_t    m_LinkFromCount;
+    uint32_t    m_Reserved;
+    BinaryBlob  m_Extra;
+};
+# pragma endregion
+
+# pragma region BinaryBlueprint
+// Read-only view over a binary blueprint, either memory mapped from a file or
+// borrowed from a caller owned buffer. Open() only validates the header and
+// section bounds, records are decoded on demand.
+struct IMGUI_API BinaryBlueprint
+{
+    BinaryBlueprint() = default;
+    ~BinaryBlueprint();
+    BinaryBlueprint(const BinaryBlueprint&) = delete;
+    BinaryBlueprint& operator=(const BinaryBlueprint&) = delete;
+
+    int Open(const std::string& path);
+    int Open(const void* data, size_t size);
+    void Close();
+    bool IsOpened() const { return m_Header != nullptr; }
+
+    const BinaryHeader& GetHeader() const { return *m_Header; }
+    uint32_t GetNodeCount() const { return m_Header ? m_Header->m_NodeCount : 0; }
+    const BinaryNode* GetNode(uint32_t index) const;
+    const BinaryPin* GetPin(uint32_t index) const;
+    const char* GetString(uint32_t index, uint32_t* size = nullptr) const;
+    const char* GetBlob(const BinaryBlob& blob) const;
+
+    int GetNodeValue(uint32_t index, imgui_json::value& value) const;   // same as Node::Save output
+    int GetValue(imgui_json::value& value) const;                       // whole document
+    int GetBlueprintValue(imgui_json::value& value) const;              // blueprint object without the nodes array
+
+private:
+    int GetPinValue(uint32_t index, imgui_json::value& value) const;
+    int GetPinsValue(uint32_t start, uint32_t count, imgui_json::value& value) const;
+    bool ParseBlob(const BinaryBlob& blob, imgui_json::value& value) const;
+
+    const uint8_t*      m_Data      {nullptr};
+    size_t              m_Size      {0};
+    const BinaryHeader* m_Header    {nullptr};
+    void*               m_Mapping   {nullptr};  // mapped view, owned
+    size_t              m_MappingSize {0};
+#if defined(_WIN32)
+    void*               m_File      {nullptr};
+    void*               m_MapHandle {nullptr};
+#endif
+};
+# pragma endregion
+
+IMGUI_API bool IsBinaryBlueprint(const std::string& path);
+IMGUI_API bool IsBinaryBlueprintPath(const std::string& path); // by extension, for choosing the save format
+IMGUI_API int  BinaryBlueprintFromJson(const imgui_json::value& value, std::vector<uint8_t>& data);
+IMGUI_API int  LoadBinaryBlueprint(const std::string& path, imgui_json::value& value);
+IMGUI_API bool SaveBinaryBlueprint(const imgui_json::value& value, const std::string& path);
+IMGUI_API int  ConvertJsonToBinary(const std::string& json_path, const std::string& binary_path);
+IMGUI_API int  ConvertBinaryToJson(const std::string& binary_path, const std::string& json_path);
+} // namespace BluePrint
@@ -3,21 +3,7 @@
 #include <imgui_helper.h>
 #include <BluePrint.h>
 #include <Node.h>
-
-enum class LogLevel: int32_t
-{
-    Verbose,
-    Info,
-    Debug,
-    Warning,
-    Error,
-};
-
-# define LOGV(...)
-# define LOGD(...)
-# define LOGI(...)
-# define LOGW(...)
-# define LOGE(...)
+#include <Log.h>
 
 namespace BluePrint
 {
@@ -5,8 +5,14 @@
 #include <BluePrint.h>
 #include <vector>
 #include <map>
+#include <deque>
 #include <memory>
 #include <string>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <stdint.h>
 
 namespace ed = ax::NodeEditor;
@@ -14,6 +20,9 @@ namespace BluePrint
 {
 struct IMGUI_API Document
 {
+    Document() = default;
+    ~Document();
+
     struct DocumentState
     {
         imgui_json::value m_NodesState;
@@ -36,6 +45,42 @@ struct IMGUI_API Document
         DocumentState   m_State;
     };
 
+    // Undo/redo stack. Every m_CheckpointInterval entries a full DocumentState is
+    // kept, entries in between only store the structural delta from the previous
+    // one (nodes added/removed, changed node keys, editor and selection state).
+    // The oldest entries are evicted once the estimated size exceeds m_Budget.
+    struct UndoHistory
+    {
+        void Push(UndoState&& state);
+        UndoState Pop();
+        void Clear();
+        void SetBudget(size_t bytes, int checkpoint_interval = 32);
+
+        bool   IsEmpty()  const { return m_Entries.empty(); }
+        size_t GetSize()  const { return m_Entries.size(); }
+        size_t GetBytes() const { return m_Bytes; }
+
+    private:
+        struct Entry
+        {
+            string              m_Name;
+            bool                m_Checkpoint {false};
+            DocumentState       m_State;    // checkpoint only
+            imgui_json::value   m_Delta;    // from previous entry, delta only
+            size_t              m_Bytes {0};
+        };
+
+        DocumentState Materialize(size_t index) const;
+        void Evict();
+
+        std::deque<Entry>   m_Entries;
+        DocumentState       m_Tail;         // state of m_Entries.back()
+        size_t              m_Bytes {0};
+        size_t              m_Budget {256 * 1024 * 1024};
+        int                 m_CheckpointInterval {32};
+        int                 m_SinceCheckpoint {0};
+    };
+
     struct UndoTransaction
         : std::enable_shared_from_this<UndoTransaction>
     {
@@ -82,8 +127,14 @@ struct IMGUI_API Document
     bool Save(std::string path) const;
     bool Save() const;
 
+    // Incremental save, changed nodes are appended to "<path>.journal" which
+    // Load() replays on top of the base file, a full Save() folds it back.
+    bool SaveIncremental();
+    void EnableAutosave(int interval_ms); // 0 to stop, journal is written by a background thread
+
     bool Undo();
     bool Redo();
+    void SetUndoBudget(size_t bytes, int checkpoint_interval = 32);
 
     DocumentState BuildDocumentState();
     void ApplyState(const DocumentState& state);
@@ -106,8 +157,8 @@ struct IMGUI_API Document
     string                  m_Name;
     string                  m_CatalogFilter;
     bool                    m_IsModified = false;
-    vector<UndoState>       m_Undo;
-    vector<UndoState>       m_Redo;
+    UndoHistory             m_Undo;
+    UndoHistory             m_Redo;
 
     DocumentState           m_DocumentState;
     NavigationState         m_NavigationState;
@@ -118,6 +169,33 @@ struct IMGUI_API Document
 
     BP                      m_Blueprint;
     void *                  m_UserData {nullptr};
+
+private:
+    struct JournalRecord
+    {
+        std::map<ID_TYPE, imgui_json::value>    m_Nodes;
+        std::set<ID_TYPE>                       m_Removed;
+        imgui_json::value                       m_Root;     // document without blueprint nodes
+        imgui_json::value                       m_Full;     // whole document, rewrites the base file
+        std::string                             m_Path;
+        uint32_t                                m_Generation {0};
+    };
+
+    void QueueJournal(const DocumentState& state, const std::vector<ID_TYPE>& changed, const std::vector<ID_TYPE>& removed);
+    bool FlushJournal();
+    void AutosaveThread();
+
+    mutable std::mutex          m_JournalMutex;         // m_Journal, m_Generation
+    mutable std::mutex          m_FileMutex;            // document and journal files
+    mutable JournalRecord       m_Journal;              // pending, not yet written
+    mutable uint32_t            m_Generation {0};       // bumped by every full Save
+    bool                        m_JournalEnabled {false};
+    std::atomic<bool>           m_JournalCompact {false};
+    std::thread*                m_AutosaveThread {nullptr};
+    std::mutex                  m_AutosaveMutex;    // held to set m_AutosaveQuit and while waiting
+    std::condition_variable     m_AutosaveCond;
+    std::atomic<bool>           m_AutosaveQuit {false};
+    int                         m_AutosaveInterval {0};
 };
 
 } // namespace BluePrint
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+
+enum class LogLevel: int32_t
+{
+    Verbose,
+    Info,
+    Debug,
+    Warning,
+    Error,
+};
+
+# define LOGV(...)
+# define LOGD(...)
+# define LOGI(...)
+# define LOGW(...)
+# define LOGE(...)
@@ -1,14 +1,22 @@
 #pragma once
 #include <BluePrint.h>
 #include <Pin.h>
-#include <Debug.h>
-#include <imgui_node_editor.h>
+#include <Log.h>
 #include <imgui_extra_widget.h>
 #include <imgui_curve.h>
 #include <inttypes.h>
+#include <list>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
 #include <DynObjectLoader.h>
-
-namespace ed = ax::NodeEditor;
+#include <PluginManifest.h>
+#if IMGUI_ICONS
+#include <icons.h>
+#define ICON_RESET              u8"\ue042"
+#else
+#define ICON_RESET              "R"
+#endif
 
 namespace BluePrint
 {
@@ -205,7 +213,7 @@ struct IMGUI_API Node
             return false;
     }
 
-    virtual NodeTypeInfo    GetTypeInfo() const { return {}; }
+    virtual const NodeTypeInfo& GetTypeInfo() const { static const NodeTypeInfo info {}; return info; }
 
     virtual NodeType        GetType() const;
     virtual VERSION_TYPE    GetVersion() const;
@@ -217,9 +225,11 @@ struct IMGUI_API Node
     virtual bool            HasSetting() const;
     virtual bool            CustomLayout() const;
     virtual bool            Skippable() const;
+    virtual bool            ParallelLoad() const; // return true if the constructor and Load() only touch the node itself, both then run on a loader thread
     virtual std::string     GetName() const;
     virtual void            SetName(std::string name);
     virtual void            SetBreakPoint(bool breaken);
+    void                    SetGroupID(ID_TYPE group_id);
 
     virtual LinkQueryResult AcceptLink(const Pin& receiver, const Pin& provider) const; // Checks if node accept link between these two pins. There node can filter out unsupported link types.
     virtual void            WasLinked(const Pin& receiver, const Pin& provider); // Notifies node that link involving one of its pins has been made.
@@ -233,6 +243,7 @@ struct IMGUI_API Node
     virtual vector<Pin*>    GetAutoLinkOutputDataPin() { return {}; } // Return auto link data pin which as output
     virtual FlowPin*        GetOutputFlowPin() { return nullptr; } // return Output FlowPin point
     virtual void            OnNodeDelete(Node * node = nullptr) {};
+    virtual void            OnNodeReplaced(Node * from, Node * to) {};   // plugin reload swapped a node instance, both are still alive
 
     virtual int  Load(const imgui_json::value& value);
     virtual void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {});
@@ -243,6 +254,12 @@ struct IMGUI_API Node
     virtual void DrawNodeLogo(ImGuiContext * ctx, ImVec2 size) const;
     virtual void DrawNodeLogo(ImTextureID logo, int& index, int cols, int rows, ImVec2 size) const;
     virtual ImTextureID LoadNodeLogo(void * data, int size) const;
+    // Logo textures shared by every node using the same compressed blob, decoded
+    // on first acquire and destroyed when the last reference is released. Nodes
+    // keep the blob in a function-local static (GetLogoData), so there is one
+    // copy per type instead of one per instance.
+    static ImTextureID AcquireNodeLogo(const void * data, int size);
+    static void ReleaseNodeLogo(ImTextureID logo);
 
     ID_TYPE         m_ID                {0};
     string          m_Name              {""};
@@ -256,6 +273,7 @@ struct IMGUI_API Node
     bool            m_Enabled           {true};
     bool            m_NeedUpdate        {false};
     ID_TYPE         m_GroupID           {0};
+    std::atomic<bool> m_Dirty           {true}; // changed since BP::SaveIncremental last serialized it
     std::mutex      m_mutex;
 
     // for Node banchmark
@@ -264,15 +282,17 @@ struct IMGUI_API Node
     double          m_NodeTimeMs    {0.f};
 };
 
+IMGUI_API const vector<Node*> GetGroupedNodes(Node& node); // Returns grouped nodes as a vector, empty without editor hooks.
+
 struct ClipNode
 {
     ClipNode(Node* node)
     {
         m_NodeInfo = node->GetTypeInfo();
         m_Name = node->m_Name;
-        m_Pos = ed::GetNodePosition(node->m_ID);
-        m_Size = ed::GetNodeSize(node->m_ID);
-        m_GroupSize = ed::GetGroupSize(node->m_ID);
+        m_Pos = Editor::GetNodePosition(node->m_ID);
+        m_Size = Editor::GetNodeSize(node->m_ID);
+        m_GroupSize = Editor::GetGroupSize(node->m_ID);
         m_HasSetting = node->m_HasSetting;
         m_Skippable = node->m_Skippable;
         m_HasCustomLayout = node->m_HasCustomLayout;
@@ -292,24 +312,72 @@ struct IMGUI_API NodeRegistry
 {
     NodeRegistry();
     ~NodeRegistry();
+    static shared_ptr<NodeRegistry> GetShared(); // registry shared by every BP created without one, lives until exit
     ID_TYPE RegisterNodeType(shared_ptr<NodeTypeInfo> info);
     ID_TYPE RegisterNodeType(std::string Path, BP* blueprint);
+    int RegisterNodeTypes(const std::vector<std::string>& paths, PluginManifest* manifest = nullptr); // libraries are opened in parallel, unchanged ones on first use
     void UnregisterNodeType(std::string name);
     Node* Create(ID_TYPE typeId, BP* blueprint);
     Node* Create(std::string typeName, BP* blueprint);
     span<const NodeTypeInfo* const> GetTypes() const;
+    span<const NodeTypeInfo* const> GetTypes(const std::string& catalog) const;
     span<const std::string> GetCatalogs() const;
-    span<const Node * const> GetNodes() const;
+    std::vector<const Node*> GetNodes() const;      // prototype of every type, missing ones are created on the way
+    const Node* GetNode(ID_TYPE typeId) const;      // prototype of one type, created on first access
     const NodeTypeInfo* GetTypeInfo(ID_TYPE typeId) const;
+    const NodeTypeInfo* GetTypeInfo(const std::string& typeName) const;
+    uint32_t GetRevision() const { return m_Revision; } // changes whenever a type is added or removed
+
+    // Hot reload of plugins registered from a path. Changed libraries are found
+    // with inotify on linux (mtime/size polling elsewhere), loaded side by side
+    // from a shadow copy, live nodes of every attached BP are migrated through
+    // Node::Save/Node::Load and the old library is unloaded.
+    void EnablePluginWatch(bool enable);
+    int  CheckPluginUpdates();                  // UI thread, returns the number of reloaded plugins
+    bool IsPluginWatchPolling() const;          // no inotify, CheckPluginUpdates stats every plugin
+    void AttachBlueprint(BP* blueprint);        // called by BP
+    void DetachBlueprint(BP* blueprint);
 
 private:
-    void RebuildTypes();
-    std::vector<NodeTypeInfo>   m_BuildInNodes;
-    std::vector<NodeTypeInfo>   m_CustomNodes;
-    std::vector<NodeTypeInfo*>  m_Types;
-    std::vector<std::string>    m_Catalogs;
+    struct PluginRecord
+    {
+        std::string             m_Path;
+        std::string             m_LoadedPath;   // shadow copy once reloaded
+        DLClass<NodeTypeInfo>*  m_Object    {nullptr};
+        ID_TYPE                 m_TypeID    {0};
+        int64_t                 m_MTime     {0};
+        int64_t                 m_Size      {0};
+    };
+    void AddPlugin(const std::string& path, DLClass<NodeTypeInfo>* object, ID_TYPE id);
+    bool ReloadPlugin(PluginRecord& plugin);
+    void DropPrototype(ID_TYPE typeId);
+    NodeTypeInfo::Factory GetFactory(const NodeTypeInfo* info) const;
+    void LoadDeferredPlugin(ID_TYPE typeId);
+
+    void AddType(const NodeTypeInfo* info);     // caller holds m_TypesMutex exclusively
+    void RemoveType(const NodeTypeInfo* info);
+    std::vector<const NodeTypeInfo*>    m_BuildInNodes; // static descriptors from BP_NODE
+    std::list<NodeTypeInfo>             m_CustomNodes;  // list keeps the indexed pointers valid
+    std::vector<const NodeTypeInfo*>    m_Types;        // sorted by id, custom types shadow build-in ones
+    std::vector<std::string>            m_Catalogs;
+    std::unordered_map<ID_TYPE, const NodeTypeInfo*>                    m_TypeIndex;
+    std::unordered_map<std::string, const NodeTypeInfo*>                m_NameIndex;
+    std::unordered_map<std::string, std::vector<const NodeTypeInfo*>>   m_CatalogIndex;
+    mutable std::shared_timed_mutex     m_TypesMutex;   // type indexes change on reload while loader threads create nodes
     std::vector<DLClass<NodeTypeInfo>*> m_ExternalObject;
-    std::vector<Node *>         m_Nodes;
+    // prototypes are only built on demand
+    mutable std::vector<Node *> m_Nodes;
+    mutable std::unordered_map<ID_TYPE, Node*>                      m_NodeIndex;
+    mutable std::mutex          m_NodesMutex;
+    std::vector<PluginRecord>   m_Plugins;
+    std::set<ID_TYPE>           m_DeferredTypes;    // registered from the manifest, library opened on first create
+    mutable std::mutex          m_PluginMutex;
+    std::set<BP*>               m_Blueprints;
+    std::mutex                  m_BlueprintsMutex;
+    int                         m_WatchFD   {-1};
+    std::map<int, std::string>  m_WatchDirs;
+    uint32_t                    m_ReloadCount {0};
+    uint32_t                    m_Revision {0};
 };
 
 } // namespace BluePrint
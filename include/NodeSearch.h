@@ -0,0 +1,39 @@
+#pragma once
+#include <Node.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Search index behind the new node menu. Type names and catalog paths are
+// split and lower cased once per registry revision, and the results of each
+// query are cached, so typing one more character only rescans the hits of
+// the previous query.
+namespace BluePrint
+{
+struct NodeSearchIndex
+{
+    struct Entry
+    {
+        const NodeTypeInfo*         m_Type {nullptr};
+        std::vector<std::string>    m_Catalogs;     // m_Catalog split on '#'
+        std::string                 m_MenuLabel;    // "catalog > ... > name" used by the flat result list
+        std::string                 m_Name;         // lower case
+        std::string                 m_TypeName;     // lower case
+        std::string                 m_Path;         // lower case catalogs joined by ' '
+    };
+
+    void Update(const NodeRegistry* registry);  // rebuilds when the registry changed
+    // entries under catalog_filter matching filter, best match first, or sorted by name for an empty filter
+    const std::vector<const Entry*>& Query(const std::string& filter, const std::string& catalog_filter);
+
+    static int FuzzyScore(const std::string& text, const std::string& pattern); // 0 when pattern doesn't match
+
+private:
+    bool MatchCatalog(const Entry& entry, const std::vector<std::string>& filters) const;
+
+    const NodeRegistry*     m_Registry {nullptr};
+    uint32_t                m_Revision {0};
+    std::vector<Entry>      m_Entries;
+    std::unordered_map<std::string, std::vector<const Entry*>> m_Cache;
+};
+} // namespace BluePrint
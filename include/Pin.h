@@ -2,6 +2,7 @@
 #include <iostream>
 #include <BluePrint.h>
 #include <immat.h>
+#include <PluginManifest.h>
 
 #define PIN_FLAG_NONE       (0)
 #define PIN_FLAG_IN         (1<<0)
@@ -155,6 +156,7 @@ struct IMGUI_API Pin
 
     bool IsMappedPin() const;                           // Pin is Bridge/Shadow pin
     bool IsLinkedExportedPin() const;                   // Pin is linked with group export pin
+    void SetFlag(ID_TYPE flag, bool enable);            // Set or clear m_Flags bits, marks the node dirty on change
 
     virtual bool Load(const imgui_json::value& value);
     virtual void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const;
@@ -669,11 +671,15 @@ public:
     ~PinExRegistry();
 
     const PinTypeEx* RegisterPinEx(std::string module_path);
+    int RegisterPinExs(const std::vector<std::string>& module_paths, PluginManifest* manifest = nullptr); // libraries are opened in parallel
     PinEx* Create(std::string typeName);
 
 private:
+    const PinExModuleInfo* OpenPinEx(const std::string& module_path, void*& handle);
+    const PinTypeEx* AddPinEx(const std::string& module_path, const PinExModuleInfo* pModInfo, void* handle);
+
     std::vector<const PinExModuleInfo*>  m_TypeInfos;
-    void* m_dll_handle {nullptr};
+    std::vector<void*> m_dll_handles;
 };
 } // namespace BluePrint
 
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <imgui_json.h>
+#include <imgui.h>
+
+// On-disk cache of plugin probe results, keyed by path + mtime + size.
+// A library that failed to load is not opened again until it changes on disk,
+// and the type info of a good one lets it register without being opened.
+namespace BluePrint
+{
+struct IMGUI_API PluginManifest
+{
+    bool Load(const std::string& path);
+    bool Save() const;
+
+    bool IsKnownBad(const std::string& plugin) const;                   // unchanged and failed last time
+    const imgui_json::value* GetInfo(const std::string& plugin) const;  // unchanged and loaded last time
+    void Update(const std::string& plugin, bool valid, const imgui_json::value& info = {});
+
+    // run job(index) for every index on a small worker pool
+    static void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+    static bool Stat(const std::string& plugin, int64_t& mtime, int64_t& size);
+    // manifest of a plugin directory, kept in the user cache since the directory may be read only
+    static std::string DefaultPath(const std::string& plugin_dir);
+
+private:
+    struct Entry
+    {
+        int64_t             m_MTime {0};
+        int64_t             m_Size  {0};
+        bool                m_Valid {false};
+        imgui_json::value   m_Info;
+    };
+
+    const Entry* Find(const std::string& plugin) const;
+
+    std::string                     m_Path;
+    std::map<std::string, Entry>    m_Entries;
+    bool                            m_Modified {false};
+};
+} // namespace BluePrint
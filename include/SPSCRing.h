@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <stddef.h>
+#include <string.h>
+
+// Lock free ring for exactly one producer thread and one consumer thread.
+// Positions only ever grow, the slot is the position masked by the power of
+// two capacity, so neither side has to compare against a wrapped index.
+// Reset() is the only call that isn't thread safe, do it while both sides are
+// stopped.
+namespace BluePrint
+{
+template<typename T>
+struct SPSCRing
+{
+    void Reset(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        m_Buffer.assign(size, T());
+        m_Mask = size - 1;
+        m_Write.store(0, std::memory_order_relaxed);
+        m_Read.store(0, std::memory_order_relaxed);
+    }
+
+    size_t Capacity() const { return m_Buffer.size(); }
+
+    // ---[ Producer ]---
+    size_t Writable() const { return Capacity() - (m_Write.load(std::memory_order_relaxed) - m_Read.load(std::memory_order_acquire)); }
+    size_t WritePos() const { return m_Write.load(std::memory_order_relaxed); }
+    T& Slot(size_t pos) { return m_Buffer[pos & m_Mask]; }    // fill Slot(WritePos() + i) for i < Writable(), then Commit()
+    void Commit(size_t count) { m_Write.store(m_Write.load(std::memory_order_relaxed) + count, std::memory_order_release); }
+
+    // copy up to count items from data in at most two runs, returns the count written
+    size_t Write(const T* data, size_t count)
+    {
+        size_t room = Writable();
+        if (count > room) count = room;
+        size_t start = WritePos() & m_Mask;
+        size_t first = count < Capacity() - start ? count : Capacity() - start;
+        memcpy(&m_Buffer[start], data, first * sizeof(T));
+        memcpy(&m_Buffer[0], data + first, (count - first) * sizeof(T));
+        Commit(count);
+        return count;
+    }
+
+    bool Push(const T& item)
+    {
+        if (Writable() == 0)
+            return false;
+        Slot(WritePos()) = item;
+        Commit(1);
+        return true;
+    }
+
+    // ---[ Consumer ]---
+    size_t Readable() const { return m_Write.load(std::memory_order_acquire) - m_Read.load(std::memory_order_relaxed); }
+    size_t ReadPos() const { return m_Read.load(std::memory_order_relaxed); }
+    const T* Peek(size_t index = 0) const { return index < Readable() ? &m_Buffer[(ReadPos() + index) & m_Mask] : nullptr; }
+    void Pop(size_t count = 1) { m_Read.store(m_Read.load(std::memory_order_relaxed) + count, std::memory_order_release); }
+
+    // copy up to count items into out in at most two runs, returns the count read
+    size_t Read(T* out, size_t count)
+    {
+        size_t available = Readable();
+        if (count > available) count = available;
+        size_t start = ReadPos() & m_Mask;
+        size_t first = count < Capacity() - start ? count : Capacity() - start;
+        memcpy(out, &m_Buffer[start], first * sizeof(T));
+        memcpy(out + first, &m_Buffer[0], (count - first) * sizeof(T));
+        Pop(count);
+        return count;
+    }
+
+private:
+    std::vector<T>      m_Buffer;
+    size_t              m_Mask {0};
+    alignas(64) std::atomic<size_t> m_Write {0};
+    alignas(64) std::atomic<size_t> m_Read {0};
+};
+} // namespace BluePrint
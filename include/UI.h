@@ -10,6 +10,7 @@
 #include <Utils.h>
 #include <Debug.h>
 #include <Document.h>
+#include <NodeSearch.h>
 #include <inttypes.h>
 
 #if IMGUI_ICONS
@@ -41,7 +42,6 @@
 #define ICON_NODE_NEXT          u8"\uf0da"
 #define ICON_NODE_ENABLE        u8"\ue8f4"
 #define ICON_NODE_DISABLE       u8"\ue8f5"
-#define ICON_RESET              u8"\ue042"
 #define ICON_THUMBNAIL          u8"\ue8d9"
 #else
 #define ICON_OPEN_BLUEPRINT     "Open"
@@ -68,7 +68,6 @@
 #define ICON_NODE_CLEAR         "x"
 #define ICON_NODE_SEARCH        "f"
 #define ICON_NODE_NEXT          ">"
-#define ICON_RESET              "R"
 #define ICON_THUMBNAIL          "N"
 #endif
 
@@ -242,8 +241,22 @@ struct BluePrintUI
     ImVec4                          m_StyleColors[BluePrintStyleColor_Count];
     ImVec2                          m_PopupMousePos {};
     enum BluePrintStyle             m_Style {BluePrintStyle::BP_Style_BluePrint};
+    bool                            m_NodeCulling {true};   // off-screen nodes are submitted as proxies
+    float                           m_LODZoom {2.5f};       // zoomed out beyond this, nodes are drawn as title boxes
 private:
     DebugOverlay*                   m_DebugOverlay {nullptr};
+    double                          m_PluginCheckTime {0};
+    std::unordered_map<ID_TYPE, ImRect> m_PinRects;         // pin bounds relative to node origin, from the last full draw
+    struct LinkCacheItem
+    {
+        Pin*                        m_Pin;
+    };
+    std::vector<LinkCacheItem>      m_LinkCache;            // resolved links, rebuilt when BP::GetLinkRevision() moves
+    uint32_t                        m_LinkCacheRevision {0};
+    NodeSearchIndex                 m_NodeSearch;
+    std::vector<ImRect>             m_ThumbnailRects;       // node bounds in canvas space for the minimap
+    uint32_t                        m_ThumbnailRevision {0};
+    bool                            m_ThumbnailDirty {true};
 
 private:
     ContextMenu         m_ContextMenu;
@@ -351,6 +364,7 @@ private:
     bool                CheckNodeStyle(const Node* node, NodeStyle style);
     float               DrawNodeToolBar(Node *node, Node **need_clone_node);
     void                DrawNodes();
+    bool                DrawNodeProxy(Node* node, bool show_title);
     void                DrawInfoTooltip();
     void                ShowDialogs();
     void                FileDialogs();
@@ -365,6 +379,8 @@ private:
     void                CreateNewFilterDocument();
     void                CreateNewFusionDocument();
     void                CommitLinksToEditor();
+    void                RebuildLinkCache();
+    void                UpdateThumbnailCache();
     bool                ReadyToQuit {false};
 
 public:
@@ -28,11 +28,7 @@ bool DrawPinValue(const PinValue& value); // Draw widget representing pin value.
 bool EditPinValue(Pin& pin); // Show editor for pin. Returns true if edit is complete.
 void DrawPinValueWithEditor(Pin& pin); // Draw pin value or editor if value is clicked.
 const vector<Node*> GetSelectedNodes(BP* blueprint); // Returns selected nodes as a vector.
-const vector<Node*> GetGroupedNodes(Node& node); // Returns grouped nodes as a vector.
 const vector<Pin*> GetSelectedLinks(BP* blueprint); // Returns selected links as a vector.
-const char * StepResultToString(StepResult stepResult);
-std::string IDToHexString(const ID_TYPE i);
-ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID);
 // Uses ImDrawListSplitter to draw background under pin value
 struct PinValueBackgroundRenderer
 {
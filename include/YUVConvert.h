@@ -0,0 +1,41 @@
+#pragma once
+#include <stdint.h>
+#include <imgui.h>
+
+// CPU YUV to RGBA8 conversion for builds without the Vulkan color converter.
+// Rows are converted in bands on worker threads with AVX2, SSE4.1 or NEON
+// kernels, whichever the target was built for, and a C fallback otherwise.
+namespace BluePrint
+{
+enum class YUVLayout : int32_t
+{
+    I420 = 0,   // planar, chroma halved in both directions
+    I422,       // planar, chroma halved horizontally
+    I444,       // planar, full chroma
+    NV12,       // luma plane plus one interleaved UV plane, chroma halved in both directions
+};
+
+enum class YUVMatrix : int32_t
+{
+    BT601 = 0,
+    BT709,
+    BT2020,
+};
+
+struct YUVFrame
+{
+    const uint8_t*  m_Data[3]   {nullptr, nullptr, nullptr};    // Y, U, V (or UV for NV12)
+    int             m_Stride[3] {0, 0, 0};                      // in bytes
+    int             m_Width     {0};
+    int             m_Height    {0};
+    YUVLayout       m_Layout    {YUVLayout::I420};
+    int             m_Depth     {8};        // significant bits, samples above 8 bits are 16 bit little endian
+    int             m_Shift     {0};        // padding bits below the sample, 6 for P010
+    YUVMatrix       m_Matrix    {YUVMatrix::BT709};
+    bool            m_FullRange {false};
+};
+
+// dst is width x height RGBA8 with dst_stride bytes per row, threads 0 picks a count from the frame size
+IMGUI_API void ConvertYUVToRGBA(const YUVFrame& src, uint8_t* dst, int dst_stride, int threads = 0);
+IMGUI_API const char* YUVConvertBackend();  // "AVX2", "SSE4.1", "NEON" or "C"
+} // namespace BluePrint
@@ -0,0 +1,474 @@
+#include <AudioDSP.h>
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#define AUDIO_DSP_SSE   1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUDIO_DSP_NEON  1
+#endif
+
+#define AUDIO_DSP_LANES     4       // channels per vector
+#define AUDIO_DSP_DENORMAL  1e-15f  // filter state below this is flushed to zero
+#define AUDIO_DSP_PLANES    16      // channel pointers kept on the stack
+
+namespace BluePrint
+{
+// ---[ Vector helpers ]---
+#if AUDIO_DSP_SSE
+typedef __m128 Vec4;
+static inline Vec4 Load4(const float* p) { return _mm_load_ps(p); }
+static inline void Store4(float* p, Vec4 v) { _mm_store_ps(p, v); }
+static inline Vec4 Splat4(float v) { return _mm_set1_ps(v); }
+static inline Vec4 Add4(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+static inline Vec4 Sub4(Vec4 a, Vec4 b) { return _mm_sub_ps(a, b); }
+static inline Vec4 Mul4(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+#elif AUDIO_DSP_NEON
+typedef float32x4_t Vec4;
+static inline Vec4 Load4(const float* p) { return vld1q_f32(p); }
+static inline void Store4(float* p, Vec4 v) { vst1q_f32(p, v); }
+static inline Vec4 Splat4(float v) { return vdupq_n_f32(v); }
+static inline Vec4 Add4(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+static inline Vec4 Sub4(Vec4 a, Vec4 b) { return vsubq_f32(a, b); }
+static inline Vec4 Mul4(Vec4 a, Vec4 b) { return vmulq_f32(a, b); }
+#else
+struct Vec4 { float v[4]; };
+static inline Vec4 Load4(const float* p) { Vec4 r; memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline void Store4(float* p, Vec4 v) { memcpy(p, v.v, sizeof(v.v)); }
+static inline Vec4 Splat4(float s) { Vec4 r; for (int i = 0; i < 4; i++) r.v[i] = s; return r; }
+static inline Vec4 Add4(Vec4 a, Vec4 b) { for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+static inline Vec4 Sub4(Vec4 a, Vec4 b) { for (int i = 0; i < 4; i++) a.v[i] -= b.v[i]; return a; }
+static inline Vec4 Mul4(Vec4 a, Vec4 b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+#endif
+
+// ---[ Sample kernels ]---
+// VecN is the widest float vector of the target, one float for plain C
+#if defined(__AVX2__)
+#define AUDIO_DSP_WIDTH 8
+typedef __m256 VecN;
+static inline VecN LoadN(const float* p) { return _mm256_loadu_ps(p); }
+static inline void StoreN(float* p, VecN v) { _mm256_storeu_ps(p, v); }
+static inline VecN SplatN(float v) { return _mm256_set1_ps(v); }
+static inline VecN AddN(VecN a, VecN b) { return _mm256_add_ps(a, b); }
+static inline VecN MulN(VecN a, VecN b) { return _mm256_mul_ps(a, b); }
+static inline VecN MinN(VecN a, VecN b) { return _mm256_min_ps(a, b); }
+static inline VecN MaxN(VecN a, VecN b) { return _mm256_max_ps(a, b); }
+static inline VecN SqrtN(VecN a) { return _mm256_sqrt_ps(a); }
+static inline VecN RampN() { return _mm256_setr_ps(1, 2, 3, 4, 5, 6, 7, 8); }
+#elif AUDIO_DSP_SSE
+#define AUDIO_DSP_WIDTH 4
+typedef __m128 VecN;
+static inline VecN LoadN(const float* p) { return _mm_loadu_ps(p); }
+static inline void StoreN(float* p, VecN v) { _mm_storeu_ps(p, v); }
+static inline VecN SplatN(float v) { return _mm_set1_ps(v); }
+static inline VecN AddN(VecN a, VecN b) { return _mm_add_ps(a, b); }
+static inline VecN MulN(VecN a, VecN b) { return _mm_mul_ps(a, b); }
+static inline VecN MinN(VecN a, VecN b) { return _mm_min_ps(a, b); }
+static inline VecN MaxN(VecN a, VecN b) { return _mm_max_ps(a, b); }
+static inline VecN SqrtN(VecN a) { return _mm_sqrt_ps(a); }
+static inline VecN RampN() { return _mm_setr_ps(1, 2, 3, 4); }
+#elif AUDIO_DSP_NEON
+#define AUDIO_DSP_WIDTH 4
+typedef float32x4_t VecN;
+static inline VecN LoadN(const float* p) { return vld1q_f32(p); }
+static inline void StoreN(float* p, VecN v) { vst1q_f32(p, v); }
+static inline VecN SplatN(float v) { return vdupq_n_f32(v); }
+static inline VecN AddN(VecN a, VecN b) { return vaddq_f32(a, b); }
+static inline VecN MulN(VecN a, VecN b) { return vmulq_f32(a, b); }
+static inline VecN MinN(VecN a, VecN b) { return vminq_f32(a, b); }
+static inline VecN MaxN(VecN a, VecN b) { return vmaxq_f32(a, b); }
+#if defined(__aarch64__)
+static inline VecN SqrtN(VecN a) { return vsqrtq_f32(a); }
+#else
+// armv7 has no vector sqrt, refine the reciprocal estimate twice
+static inline VecN SqrtN(VecN a)
+{
+    VecN x = vmaxq_f32(a, vdupq_n_f32(1e-30f));
+    VecN r = vrsqrteq_f32(x);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+    return vmulq_f32(a, r);
+}
+#endif
+static inline VecN RampN() { const float r[4] = { 1, 2, 3, 4 }; return vld1q_f32(r); }
+#else
+#define AUDIO_DSP_WIDTH 1
+typedef float VecN;
+static inline VecN LoadN(const float* p) { return *p; }
+static inline void StoreN(float* p, VecN v) { *p = v; }
+static inline VecN SplatN(float v) { return v; }
+static inline VecN AddN(VecN a, VecN b) { return a + b; }
+static inline VecN MulN(VecN a, VecN b) { return a * b; }
+static inline VecN MinN(VecN a, VecN b) { return a < b ? a : b; }
+static inline VecN MaxN(VecN a, VecN b) { return a > b ? a : b; }
+static inline VecN SqrtN(VecN a) { return sqrtf(a); }
+static inline VecN RampN() { return 1.f; }
+#endif
+
+static inline float Clip(float v, float lo, float hi)
+{
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+void AudioGain(float* data, size_t count, float from, float to, bool clip)
+{
+    if (!data || count == 0)
+        return;
+    float step = (to - from) / count;
+    VecN ramp = MulN(RampN(), SplatN(step));
+    VecN lo = SplatN(-1.f), hi = SplatN(1.f);
+    size_t i = 0;
+    for (; i + AUDIO_DSP_WIDTH <= count; i += AUDIO_DSP_WIDTH)
+    {
+        VecN gain = from == to ? SplatN(to) : AddN(SplatN(from + step * i), ramp);
+        VecN x = MulN(LoadN(data + i), gain);
+        if (clip) x = MinN(MaxN(x, lo), hi);
+        StoreN(data + i, x);
+    }
+    for (; i < count; i++)
+    {
+        float x = data[i] * (from + step * (i + 1));
+        data[i] = clip ? Clip(x, -1.f, 1.f) : x;
+    }
+}
+
+void AudioClip(float* data, size_t count, float lo, float hi)
+{
+    if (!data)
+        return;
+    VecN vlo = SplatN(lo), vhi = SplatN(hi);
+    size_t i = 0;
+    for (; i + AUDIO_DSP_WIDTH <= count; i += AUDIO_DSP_WIDTH)
+        StoreN(data + i, MinN(MaxN(LoadN(data + i), vlo), vhi));
+    for (; i < count; i++)
+        data[i] = Clip(data[i], lo, hi);
+}
+
+void AudioCrossfade(float* dst, const float* a, const float* b, size_t count, float from, float to, AudioFadeCurve curve, bool clip)
+{
+    if (!dst || !a || !b || count == 0)
+        return;
+    bool power = curve == AudioFadeCurve::EqualPower;
+    from = Clip(from, 0.f, 1.f);
+    to = Clip(to, 0.f, 1.f);
+    float step = (to - from) / count;
+    VecN ramp = MulN(RampN(), SplatN(step));
+    VecN one = SplatN(1.f), minus_one = SplatN(-1.f), zero = SplatN(0.f);
+    size_t i = 0;
+    for (; i + AUDIO_DSP_WIDTH <= count; i += AUDIO_DSP_WIDTH)
+    {
+        VecN t = MinN(MaxN(AddN(SplatN(from + step * i), ramp), zero), one);
+        VecN ga = AddN(one, MulN(t, minus_one));
+        VecN gb = t;
+        if (power) { ga = SqrtN(ga); gb = SqrtN(gb); }
+        VecN x = AddN(MulN(LoadN(a + i), ga), MulN(LoadN(b + i), gb));
+        if (clip) x = MinN(MaxN(x, minus_one), one);
+        StoreN(dst + i, x);
+    }
+    for (; i < count; i++)
+    {
+        float t = Clip(from + step * (i + 1), 0.f, 1.f);
+        float ga = power ? sqrtf(1.f - t) : 1.f - t;
+        float gb = power ? sqrtf(t) : t;
+        float x = a[i] * ga + b[i] * gb;
+        dst[i] = clip ? Clip(x, -1.f, 1.f) : x;
+    }
+}
+
+void AudioMix(float* dst, const float* src, size_t count, float gain)
+{
+    if (!dst || !src)
+        return;
+    VecN g = SplatN(gain);
+    size_t i = 0;
+    for (; i + AUDIO_DSP_WIDTH <= count; i += AUDIO_DSP_WIDTH)
+        StoreN(dst + i, AddN(LoadN(dst + i), MulN(LoadN(src + i), g)));
+    for (; i < count; i++)
+        dst[i] += src[i] * gain;
+}
+
+void AudioInterleave(float* dst, const float* const* planes, int channels, size_t frames)
+{
+    if (!dst || !planes || channels <= 0)
+        return;
+    size_t i = 0;
+    if (channels == 2)
+    {
+        const float* l = planes[0];
+        const float* r = planes[1];
+#if AUDIO_DSP_SSE
+        for (; i + 4 <= frames; i += 4)
+        {
+            __m128 vl = _mm_loadu_ps(l + i), vr = _mm_loadu_ps(r + i);
+            _mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(vl, vr));
+            _mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(vl, vr));
+        }
+#elif AUDIO_DSP_NEON
+        for (; i + 4 <= frames; i += 4)
+        {
+            float32x4x2_t v = { { vld1q_f32(l + i), vld1q_f32(r + i) } };
+            vst2q_f32(dst + i * 2, v);
+        }
+#endif
+        for (; i < frames; i++)
+        {
+            dst[i * 2] = l[i];
+            dst[i * 2 + 1] = r[i];
+        }
+        return;
+    }
+    for (int c = 0; c < channels; c++)
+    {
+        const float* src = planes[c];
+        float* out = dst + c;
+        for (i = 0; i < frames; i++)
+            out[i * channels] = src[i];
+    }
+}
+
+void AudioDeinterleave(float* const* planes, const float* src, int channels, size_t frames)
+{
+    if (!planes || !src || channels <= 0)
+        return;
+    size_t i = 0;
+    if (channels == 2)
+    {
+        float* l = planes[0];
+        float* r = planes[1];
+#if AUDIO_DSP_SSE
+        for (; i + 4 <= frames; i += 4)
+        {
+            __m128 v0 = _mm_loadu_ps(src + i * 2), v1 = _mm_loadu_ps(src + i * 2 + 4);
+            _mm_storeu_ps(l + i, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(r + i, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+#elif AUDIO_DSP_NEON
+        for (; i + 4 <= frames; i += 4)
+        {
+            float32x4x2_t v = vld2q_f32(src + i * 2);
+            vst1q_f32(l + i, v.val[0]);
+            vst1q_f32(r + i, v.val[1]);
+        }
+#endif
+        for (; i < frames; i++)
+        {
+            l[i] = src[i * 2];
+            r[i] = src[i * 2 + 1];
+        }
+        return;
+    }
+    for (int c = 0; c < channels; c++)
+    {
+        float* out = planes[c];
+        const float* in = src + c;
+        for (i = 0; i < frames; i++)
+            out[i] = in[i * channels];
+    }
+}
+
+// ---[ ImMat helpers ]---
+template<typename T>
+static void ConvertToFloat(ImGui::ImMat& src, ImGui::ImMat& dst, float scale)
+{
+    for (int c = 0; c < src.c; c++)
+    {
+        float* out = (float*)dst.channel(c).data;
+        const T* in = src.elempack == 1 ? (const T*)src.channel(c).data : (const T*)src.data + c;
+        int step = src.elempack == 1 ? 1 : src.c;
+        for (int i = 0; i < src.w; i++)
+            out[i] = in[(size_t)i * step] * scale;
+    }
+}
+
+ImGui::ImMat AudioWritableMat(ImGui::ImMat& src)
+{
+    if (src.type == IM_DT_FLOAT32)
+    {
+        if (src.device == IM_DD_CPU && src.refcount && *src.refcount == 1)
+            return src;
+        return src.clone();
+    }
+    ImGui::ImMat dst;
+    dst.create_type(src.w, 1, src.c, IM_DT_FLOAT32);
+    if (src.type == IM_DT_INT32)
+        ConvertToFloat<int32_t>(src, dst, 1.f / INT32_MAX);
+    else if (src.type == IM_DT_INT16)
+        ConvertToFloat<int16_t>(src, dst, 1.f / INT16_MAX);
+    else
+        ConvertToFloat<int8_t>(src, dst, 1.f / INT8_MAX);
+    return dst;
+}
+
+int AudioChannelPointers(ImGui::ImMat& mat, std::vector<float*>& channels)
+{
+    bool planar = mat.elempack == 1;
+    channels.resize(mat.c);
+    for (int c = 0; c < mat.c; c++)
+        channels[c] = planar ? (float*)mat.channel(c).data : (float*)mat.data + c;
+    return planar ? 1 : mat.c;
+}
+
+void AudioInterleaveMat(ImGui::ImMat& src, std::vector<float>& dst)
+{
+    dst.resize((size_t)src.w * src.c);
+    if (src.type == IM_DT_FLOAT32 && src.elempack == src.c)
+    {
+        memcpy(dst.data(), src.data, dst.size() * sizeof(float));
+        return;
+    }
+    ImGui::ImMat mat = src.type == IM_DT_FLOAT32 ? src : AudioWritableMat(src);
+    const float* stack[AUDIO_DSP_PLANES] = {};
+    std::vector<const float*> heap(mat.c > AUDIO_DSP_PLANES ? mat.c : 0);
+    const float** planes = heap.empty() ? stack : heap.data();
+    for (int c = 0; c < mat.c; c++)
+        planes[c] = (const float*)mat.channel(c).data;
+    AudioInterleave(dst.data(), planes, mat.c, mat.w);
+}
+
+// ---[ Biquad ]---
+BiquadCoeffs MakePeakingEQ(double sample_rate, double freq, double width, double gain_db)
+{
+    BiquadCoeffs coeffs;
+    if (sample_rate <= 0 || freq <= 0 || width <= 0 || freq >= sample_rate * 0.5 || gain_db == 0)
+        return coeffs;
+    // RBJ cookbook peaking EQ, width in Hz like ffmpeg's equalizer filter with t=h
+    double A = pow(10.0, gain_db / 40.0);
+    double w0 = 2.0 * M_PI * freq / sample_rate;
+    double alpha = sin(w0) / (2.0 * freq / width);
+    double cosw = cos(w0);
+    double a0 = 1.0 + alpha / A;
+    coeffs.m_B0 = (float)((1.0 + alpha * A) / a0);
+    coeffs.m_B1 = (float)(-2.0 * cosw / a0);
+    coeffs.m_B2 = (float)((1.0 - alpha * A) / a0);
+    coeffs.m_A1 = (float)(-2.0 * cosw / a0);
+    coeffs.m_A2 = (float)((1.0 - alpha / A) / a0);
+    return coeffs;
+}
+
+void BiquadCascade::Configure(int channels, int bands)
+{
+    m_Channels = std::max(0, channels);
+    m_Bands = std::max(0, bands);
+    BiquadCoeffs identity;
+    m_BandState.assign(m_Bands, Band());
+    m_Scratch.assign((size_t)m_Bands * 5, 0.f);
+    for (int b = 0; b < m_Bands; b++)
+        SetTarget(b, identity, true);
+    ClearState();
+}
+
+void BiquadCascade::SetTarget(int band, const BiquadCoeffs& coeffs, bool immediate)
+{
+    if (band < 0 || band >= m_Bands)
+        return;
+    auto& state = m_BandState[band];
+    const float target[5] = { coeffs.m_B0, coeffs.m_B1, coeffs.m_B2, coeffs.m_A1, coeffs.m_A2 };
+    memcpy(state.m_Target, target, sizeof(target));
+    if (immediate || m_RampSamples <= 1)
+    {
+        memcpy(state.m_Coeffs, target, sizeof(target));
+        state.m_RampLeft = 0;
+        return;
+    }
+    for (int i = 0; i < 5; i++)
+        state.m_Step[i] = (target[i] - state.m_Coeffs[i]) / m_RampSamples;
+    state.m_RampLeft = m_RampSamples;
+}
+
+void BiquadCascade::ClearState()
+{
+    int groups = (m_Channels + AUDIO_DSP_LANES - 1) / AUDIO_DSP_LANES;
+    m_Z.assign((size_t)groups * m_Bands * 2 * AUDIO_DSP_LANES + AUDIO_DSP_LANES, 0.f);
+}
+
+// transposed direct form II, coefficients broadcast, one lane per channel
+static inline Vec4 RunBand(const float* k, float* z, Vec4 x)
+{
+    Vec4 z1 = Load4(z), z2 = Load4(z + AUDIO_DSP_LANES);
+    Vec4 y = Add4(Mul4(Splat4(k[0]), x), z1);
+    z1 = Add4(Sub4(Mul4(Splat4(k[1]), x), Mul4(Splat4(k[3]), y)), z2);
+    z2 = Sub4(Mul4(Splat4(k[2]), x), Mul4(Splat4(k[4]), y));
+    Store4(z, z1);
+    Store4(z + AUDIO_DSP_LANES, z2);
+    return y;
+}
+
+void BiquadCascade::Process(float* const* data, int stride, int frames)
+{
+    if (!data || frames <= 0 || m_Channels <= 0 || m_Bands <= 0)
+        return;
+    // state sits after a lane sized pad so every group starts 16 byte aligned
+    float* zbase = m_Z.data();
+    while (((uintptr_t)zbase & 15) != 0) zbase++;
+    int groups = (m_Channels + AUDIO_DSP_LANES - 1) / AUDIO_DSP_LANES;
+    int ramp = 0;
+    for (auto& band : m_BandState)
+        ramp = std::max(ramp, std::min(band.m_RampLeft, frames));
+
+    float* coeffs = m_Scratch.data();
+    alignas(16) float lanes[AUDIO_DSP_LANES];
+    for (int g = 0; g < groups; g++)
+    {
+        int first = g * AUDIO_DSP_LANES;
+        int count = std::min(AUDIO_DSP_LANES, m_Channels - first);
+        float* z = zbase + (size_t)g * m_Bands * 2 * AUDIO_DSP_LANES;
+        // every group replays the same ramp from the block start
+        for (int b = 0; b < m_Bands; b++)
+            memcpy(&coeffs[b * 5], m_BandState[b].m_Coeffs, 5 * sizeof(float));
+        memset(lanes, 0, sizeof(lanes));
+        for (int n = 0; n < frames; n++)
+        {
+            size_t offset = (size_t)n * stride;
+            for (int c = 0; c < count; c++)
+                lanes[c] = data[first + c][offset];
+            Vec4 x = Load4(lanes);
+            for (int b = 0; b < m_Bands; b++)
+            {
+                float* k = &coeffs[b * 5];
+                if (n < ramp && n < m_BandState[b].m_RampLeft)
+                {
+                    for (int i = 0; i < 5; i++)
+                        k[i] += m_BandState[b].m_Step[i];
+                }
+                x = RunBand(k, z + (size_t)b * 2 * AUDIO_DSP_LANES, x);
+            }
+            Store4(lanes, x);
+            for (int c = 0; c < count; c++)
+                data[first + c][offset] = lanes[c];
+        }
+        for (int i = 0; i < m_Bands * 2 * AUDIO_DSP_LANES; i++)
+        {
+            if (fabsf(z[i]) < AUDIO_DSP_DENORMAL)
+                z[i] = 0.f;
+        }
+    }
+
+    for (auto& band : m_BandState)
+    {
+        int step = std::min(band.m_RampLeft, frames);
+        band.m_RampLeft -= step;
+        if (band.m_RampLeft == 0)
+            memcpy(band.m_Coeffs, band.m_Target, sizeof(band.m_Coeffs));
+        else
+        {
+            for (int i = 0; i < 5; i++)
+                band.m_Coeffs[i] += band.m_Step[i] * step;
+        }
+    }
+}
+
+const char* AudioDSPBackend()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif AUDIO_DSP_SSE
+    return "SSE";
+#elif AUDIO_DSP_NEON
+    return "NEON";
+#else
+    return "C";
+#endif
+}
+} // namespace BluePrint
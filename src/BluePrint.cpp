@@ -1,13 +1,25 @@
 #include <BluePrint.h>
 #include <Node.h>
+#include <BluePrintBinary.h>
 #include <imgui_helper.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <errno.h>
+#if defined(_WIN32)
+#include <direct.h>
+#endif
 #include <BuildInNodes.h> // Which is generated by cmake
-#include <imgui_node_editor.h>
-
-namespace ed = ax::NodeEditor;
 
 namespace BluePrint
 {
+// Pins constructed on a BP::LoadNodes worker are collected per node and
+// registered in document order once every worker is done.
+static thread_local std::vector<Pin*>* g_PendingPins = nullptr;
+static const ID_TYPE k_PendingNodeID = UINT32_MAX;
+static const size_t k_ParallelLoadMin = 32;     // smaller documents load on the calling thread
+static std::mutex g_PendingMutex;
+static std::atomic<uint32_t> g_LinkRevision {0};
+
 // Version
 void GetVersion(int& major, int& minor, int& patch, int& build)
 {
@@ -16,6 +28,187 @@ void GetVersion(int& major, int& minor, int& patch, int& build)
     patch = IMGUI_BP_SDK_VERSION_PATCH;
     build = IMGUI_BP_SDK_VERSION_BUILD;
 }
+
+const char* StepResultToString(StepResult stepResult)
+{
+    switch (stepResult)
+    {
+        case StepResult::Success:   return "Success";
+        case StepResult::Done:      return "Done";
+        case StepResult::Error:     return "Error";
+    }
+
+    return "";
+}
+
+std::string IDToHexString(const ID_TYPE i) 
+{
+    std::stringstream s;
+    s << "0x" << std::uppercase << std::hex << i;
+    return s.str();
+}
+
+ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID)
+{
+    if (MapID.size() > 0)
+    {
+        std::map<ID_TYPE, ID_TYPE>::iterator it;
+        it = MapID.find(ID);
+        if (it == MapID.end())
+            return 0;
+        else
+            return it->second;
+    }
+    return ID;
+}
+
+static bool MakeDir(const std::string& path)
+{
+#if defined(_WIN32)
+    return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+std::string GetUserCacheDir(const std::string& sub)
+{
+    std::string dir;
+#if defined(_WIN32)
+    if (auto env = getenv("LOCALAPPDATA")) dir = std::string(env) + "/BluePrintSDK";
+#else
+    if (auto env = getenv("XDG_CACHE_HOME")) dir = std::string(env) + "/blueprintsdk";
+    else if (auto env = getenv("HOME")) dir = std::string(env) + "/.cache/blueprintsdk";
+#endif
+    if (dir.empty())
+        return "";
+    if (!sub.empty())
+        dir += "/" + sub;
+    // create every missing level
+    for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1))
+    {
+        if (!MakeDir(dir.substr(0, pos)))
+            return "";
+        if (pos == std::string::npos)
+            break;
+    }
+    return dir;
+}
+
+// -----------------------------
+// -------[ EditorHooks ]-------
+// -----------------------------
+static const EditorHooks* g_EditorHooks = nullptr;
+
+void SetEditorHooks(const EditorHooks* hooks)
+{
+    g_EditorHooks = hooks;
+}
+
+const EditorHooks* GetEditorHooks()
+{
+    return g_EditorHooks;
+}
+
+# define EDITOR_HOOK(name) (g_EditorHooks && g_EditorHooks->name)
+
+namespace Editor
+{
+void SetNodeChanged(ID_TYPE node)
+{
+    if (EDITOR_HOOK(NodeChanged)) g_EditorHooks->NodeChanged(node);
+}
+
+void SetPinChanged(ID_TYPE pin)
+{
+    if (EDITOR_HOOK(PinChanged)) g_EditorHooks->PinChanged(pin);
+}
+
+void SetLinkChanged(ID_TYPE link)
+{
+    if (EDITOR_HOOK(LinkChanged)) g_EditorHooks->LinkChanged(link);
+}
+
+ImVec2 GetNodePosition(ID_TYPE node)
+{
+    return EDITOR_HOOK(GetNodePosition) ? g_EditorHooks->GetNodePosition(node) : ImVec2(0, 0);
+}
+
+void SetNodePosition(ID_TYPE node, const ImVec2& pos)
+{
+    if (EDITOR_HOOK(SetNodePosition)) g_EditorHooks->SetNodePosition(node, pos);
+}
+
+ImVec2 GetNodeSize(ID_TYPE node)
+{
+    return EDITOR_HOOK(GetNodeSize) ? g_EditorHooks->GetNodeSize(node) : ImVec2(0, 0);
+}
+
+void SetNodeSize(ID_TYPE node, const ImVec2& size)
+{
+    if (EDITOR_HOOK(SetNodeSize)) g_EditorHooks->SetNodeSize(node, size);
+}
+
+ImVec2 GetGroupSize(ID_TYPE node)
+{
+    return EDITOR_HOOK(GetGroupSize) ? g_EditorHooks->GetGroupSize(node) : ImVec2(0, 0);
+}
+
+void SetGroupSize(ID_TYPE node, const ImVec2& size)
+{
+    if (EDITOR_HOOK(SetGroupSize)) g_EditorHooks->SetGroupSize(node, size);
+}
+
+void SetNodeGroupID(ID_TYPE node, ID_TYPE group)
+{
+    if (EDITOR_HOOK(SetNodeGroupID)) g_EditorHooks->SetNodeGroupID(node, group);
+}
+
+void SetNodeZPosition(ID_TYPE node, float z)
+{
+    if (EDITOR_HOOK(SetNodeZPosition)) g_EditorHooks->SetNodeZPosition(node, z);
+}
+
+void GetGroupedNodes(ID_TYPE group, vector<ID_TYPE>& nodes)
+{
+    nodes.clear();
+    if (EDITOR_HOOK(GetGroupedNodes)) g_EditorHooks->GetGroupedNodes(group, nodes);
+}
+
+bool BeginFlow()
+{
+    if (!EDITOR_HOOK(Flow))
+        return false;
+    if (g_EditorHooks->BeginFlow) g_EditorHooks->BeginFlow();
+    return true;
+}
+
+void Flow(ID_TYPE pin, bool forward)
+{
+    if (EDITOR_HOOK(Flow)) g_EditorHooks->Flow(pin, forward);
+}
+
+void EndFlow()
+{
+    if (EDITOR_HOOK(EndFlow)) g_EditorHooks->EndFlow();
+}
+
+ImVec2 ScreenToCanvas(const ImVec2& pos)
+{
+    return EDITOR_HOOK(ScreenToCanvas) ? g_EditorHooks->ScreenToCanvas(pos) : pos;
+}
+
+void Suspend()
+{
+    if (EDITOR_HOOK(Suspend)) g_EditorHooks->Suspend();
+}
+
+void Resume()
+{
+    if (EDITOR_HOOK(Resume)) g_EditorHooks->Resume();
+}
+} // namespace Editor
+# undef EDITOR_HOOK
 // -----------------------------
 // -------[ IDGenerator ]-------
 // -----------------------------
@@ -43,9 +236,11 @@ BP::BP(shared_ptr<NodeRegistry> nodeRegistry, shared_ptr<PinExRegistry> pinexReg
     , m_PinExRegistry(std::move(pinexRegistry))
 {
     if (!m_NodeRegistry)
-        m_NodeRegistry = make_shared<NodeRegistry>();
+        m_NodeRegistry = NodeRegistry::GetShared();
     if (!m_PinExRegistry)
         m_PinExRegistry = make_shared<PinExRegistry>();
+    m_NodeRegistry->AttachBlueprint(this);
+    TouchLinks();
 }
 
 BP::BP(const BP& other)
@@ -53,6 +248,8 @@ BP::BP(const BP& other)
     , m_PinExRegistry(other.m_PinExRegistry)
     , m_Context(other.m_Context)
 {
+    if (m_NodeRegistry) m_NodeRegistry->AttachBlueprint(this);
+    TouchLinks();
     imgui_json::value value;
     other.Save(value);
     Load(value);
@@ -66,13 +263,20 @@ BP::BP(BP&& other)
     , m_Pins(std::move(other.m_Pins))
     , m_Context(std::move(other.m_Context))
 {
+    if (m_NodeRegistry)
+    {
+        m_NodeRegistry->DetachBlueprint(&other);
+        m_NodeRegistry->AttachBlueprint(this);
+    }
     for (auto& node : m_Nodes)
         node->m_Blueprint = this;
+    TouchLinks();
 }
 
 BP::~BP()
 {
     Clear();
+    if (m_NodeRegistry) m_NodeRegistry->DetachBlueprint(this);
 }
 
 BP& BP::operator=(const BP& other)
@@ -82,7 +286,9 @@ BP& BP::operator=(const BP& other)
 
     Clear();
 
+    if (m_NodeRegistry) m_NodeRegistry->DetachBlueprint(this);
     m_NodeRegistry = other.m_NodeRegistry;
+    if (m_NodeRegistry) m_NodeRegistry->AttachBlueprint(this);
     m_PinExRegistry = other.m_PinExRegistry;
     m_Context = other.m_Context;
 
@@ -98,7 +304,13 @@ BP& BP::operator=(BP&& other)
     if (this == &other)
         return *this;
 
+    if (m_NodeRegistry) m_NodeRegistry->DetachBlueprint(this);
     m_NodeRegistry  = std::move(other.m_NodeRegistry);
+    if (m_NodeRegistry)
+    {
+        m_NodeRegistry->DetachBlueprint(&other);
+        m_NodeRegistry->AttachBlueprint(this);
+    }
     m_PinExRegistry = std::move(other.m_PinExRegistry);
     m_Generator     = std::move(other.m_Generator);
     m_Nodes         = std::move(other.m_Nodes);
@@ -107,6 +319,7 @@ BP& BP::operator=(BP&& other)
 
     for (auto& node : m_Nodes)
         node->m_Blueprint = this;
+    TouchLinks();
 
     return *this;
 }
@@ -171,13 +384,13 @@ Node* BP::CloneNode(Node* node)
     auto clone_node = CreateNode(node->GetTypeID());
     if (node->GetStyle() == NodeStyle::Comment)
     {
-        auto groupSize  = ed::GetGroupSize(node->m_ID);
-        ed::SetGroupSize(clone_node->m_ID, groupSize);
+        auto groupSize  = Editor::GetGroupSize(node->m_ID);
+        Editor::SetGroupSize(clone_node->m_ID, groupSize);
     }
     else
     {
-        auto nodeSize  = ed::GetNodeSize(node->m_ID);
-        ed::SetNodeSize(clone_node->m_ID, nodeSize);
+        auto nodeSize  = Editor::GetNodeSize(node->m_ID);
+        Editor::SetNodeSize(clone_node->m_ID, nodeSize);
     }
     return clone_node;
 }
@@ -190,11 +403,86 @@ void BP::InsertNode(Node* node)
 
 void BP::ForgetPin(Pin* pin)
 {
+    if (m_DeferPinRegistration)
+    {
+        std::lock_guard<std::mutex> lock(g_PendingMutex);
+        auto& pins = g_PendingPins ? *g_PendingPins : m_Pins;
+        auto it = std::find(pins.begin(), pins.end(), pin);
+        if (it != pins.end())
+            pins.erase(it);
+        TouchLinks();
+        return;
+    }
+
     auto pinIt = std::find(m_Pins.begin(), m_Pins.end(), pin);
     if (pinIt == m_Pins.end())
         return;
 
     m_Pins.erase(pinIt);
+    TouchLinks();
+}
+
+void BP::TouchLinks()
+{
+    m_LinkRevision = ++g_LinkRevision;
+}
+
+int BP::ReloadNodes(ID_TYPE fromTypeId, ID_TYPE toTypeId)
+{
+    if (!m_NodeRegistry)
+        return 0;
+
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < m_Nodes.size(); i++)
+        if (m_Nodes[i]->GetTypeID() == fromTypeId)
+            indices.push_back(i);
+    if (indices.empty())
+        return 0;
+
+    bool wasExecuting = IsExecuting();
+    bool wasPaused = IsPaused();
+    if (wasExecuting || wasPaused)
+    {
+        LOGW("[ReloadNodes] Stop running blueprint to reload nodes");
+        m_Context.Stop();
+    }
+
+    for (auto i : indices)
+    {
+        auto node = m_Nodes[i];
+        imgui_json::value nodeValue;
+        nodeValue["type_id"] = imgui_json::number(toTypeId);
+        nodeValue["type_name"] = node->GetTypeInfo().m_Name;
+        node->Save(nodeValue);
+
+        node->OnClose(m_Context);
+        auto newNode = LoadNode(m_NodeRegistry->Create(toTypeId, this), nodeValue);
+        // groups keep members and their exported pins as pointers, move them over while both exist
+        for (auto other : m_Nodes)
+            if (other != node) other->OnNodeReplaced(node, newNode);
+
+        // pins forget themselves, links pointing to them are kept as ids
+        delete node;
+        m_Nodes[i] = newNode;
+        m_SaveCache.erase(newNode->m_ID);
+    }
+
+    // drop cached link pointers into the deleted pins
+    for (auto pin : m_Pins)
+        pin->m_LinkPin = pin->m_Link ? GetPinFromID(pin->m_Link) : nullptr;
+    TouchLinks();
+
+    if (wasExecuting || wasPaused)
+    {
+        // run again from the entry point, which may be one of the reloaded nodes
+        auto entryIt = std::find_if(m_Nodes.begin(), m_Nodes.end(), [](Node* node) { return node->GetTypeInfo().m_Type == NodeType::EntryPoint; });
+        if (entryIt == m_Nodes.end() || Execute(**entryIt) == StepResult::Error)
+            LOGE("[ReloadNodes] Can't restart blueprint after reload");
+        else if (wasPaused)
+            Pause();
+    }
+
+    return (int)indices.size();
 }
 
 void BP::Clear()
@@ -215,6 +503,8 @@ void BP::Clear()
         pin->m_Node = nullptr;
     }
     m_Pins.resize(0);
+    m_SaveCache.clear();
+    TouchLinks();
     m_Generator = IDGenerator();
     m_Context = Context();
 }
@@ -431,15 +721,15 @@ void BP::ShowFlow()
 {
     if (!IsExecuting() && CurrentNode() == nullptr)
     {
-        ed::PushStyleVar(ed::StyleVar_FlowMarkerDistance, 30.0f);
-        ed::PushStyleVar(ed::StyleVar_FlowDuration, 1.0f);
+        if (!Editor::BeginFlow())
+            return;
         for (auto& pin : GetPins())
         {
             if (!pin->m_Link)
                 continue;
-            ed::Flow(pin->m_ID, pin->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
+            Editor::Flow(pin->m_ID, pin->GetType() == PinType::Flow);
         }
-        ed::PopStyleVar(2);
+        Editor::EndFlow();
     }
     else
     {
@@ -513,44 +803,217 @@ int BP::Load(const imgui_json::value& value)
     if (!imgui_json::GetPtrTo(value, "nodes", nodeArray)) // required
         return BP_ERR_NODE_LOAD;
 
-    //IDGenerator generator;
-    for (auto& nodeValue : *nodeArray)
+    const imgui_json::object* stateObject = nullptr;
+    if (!imgui_json::GetPtrTo(value, "state", stateObject)) // required
+        return BP_ERR_NODE_LOAD;
+
+    uint32_t generatorState = 0;
+    if (!imgui_json::GetTo<imgui_json::number>(*stateObject, "generator_state", generatorState)) // required
+        return BP_ERR_NODE_LOAD;
+
+    int ret = LoadNodes(nodeArray->size(), [nodeArray](size_t index, ID_TYPE& typeId)
     {
-        int ret = 0;
-        ID_TYPE typeId;
-        if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId)) // required
-            return BP_ERR_NODE_LOAD;
+        return imgui_json::GetTo<imgui_json::number>((*nodeArray)[index], "type_id", typeId);
+    },
+    [nodeArray](size_t index, imgui_json::value&)
+    {
+        return &(*nodeArray)[index];
+    });
+    if (ret != BP_ERR_NONE)
+        return ret;
 
-        auto node = m_NodeRegistry->Create(typeId, this);
-        if (!node)
-        {
-            // Create a Dummy node to replace real node
-            node = CreateDummyNode(nodeValue, this);
-            node->Load(nodeValue);
-        }
-        else if ((ret = node->Load(nodeValue)) != BP_ERR_NONE)
-        {
-            // Create a Dummy node to replace real node
-            node = CreateDummyNode(nodeValue, this);
-            node->Load(nodeValue);
-        }
+    m_Generator.SetState(generatorState);
+    m_IsOpen = true;
+    return BP_ERR_NONE;
+}
 
-        m_Nodes.emplace_back(node);
-    }
+int BP::Load(const BinaryBlueprint& file)
+{
+    if (!file.IsOpened())
+        return BP_ERR_NODE_LOAD;
+
+    Clear();
+
+    // Same required fields as the json root, checked before any node is built
+    imgui_json::value rootValue;
+    if (file.GetBlueprintValue(rootValue) != BP_ERR_NONE)
+        return BP_ERR_NODE_LOAD;
 
     const imgui_json::object* stateObject = nullptr;
-    if (!imgui_json::GetPtrTo(value, "state", stateObject)) // required
+    if (!imgui_json::GetPtrTo(rootValue, "state", stateObject)) // required
         return BP_ERR_NODE_LOAD;
 
     uint32_t generatorState = 0;
     if (!imgui_json::GetTo<imgui_json::number>(*stateObject, "generator_state", generatorState)) // required
         return BP_ERR_NODE_LOAD;
 
+    // Nodes are decoded one at a time straight from the mapped records,
+    // the whole document is never turned into a json tree.
+    int ret = LoadNodes(file.GetNodeCount(), [&file](size_t index, ID_TYPE& typeId)
+    {
+        auto node = file.GetNode((uint32_t)index);
+        if (!node || !(node->m_Fields & BP_BINARY_NODE_TYPE_ID))
+            return false;
+        typeId = node->m_TypeID;
+        return true;
+    },
+    [&file](size_t index, imgui_json::value& storage) -> const imgui_json::value*
+    {
+        return file.GetNodeValue((uint32_t)index, storage) == BP_ERR_NONE ? &storage : nullptr;
+    });
+    if (ret != BP_ERR_NONE)
+        return ret;
+
     m_Generator.SetState(generatorState);
     m_IsOpen = true;
     return BP_ERR_NONE;
 }
 
+Node* BP::LoadNode(Node* node, const imgui_json::value& nodeValue)
+{
+    if (node && node->Load(nodeValue) == BP_ERR_NONE)
+        return node;
+
+    // Create a Dummy node to replace real node
+    delete node;
+    node = CreateDummyNode(nodeValue, this);
+    node->Load(nodeValue);
+    return node;
+}
+
+// Two phases load:
+//  1. nodes of types opting in with Node::ParallelLoad are created and loaded
+//     on worker threads, pins constructed by a node are kept in its own list
+//     instead of BP::m_Pins
+//  2. other nodes are created on the calling thread, pins are registered and
+//     missing IDs generated serially in document order, so m_Pins and the
+//     IDGenerator don't depend on thread scheduling
+int BP::LoadNodes(size_t count, const NodeTypeGetter& getType, const NodeValueGetter& getValue)
+{
+    struct PendingNode
+    {
+        Node*                       m_Node      {nullptr};
+        const imgui_json::value*    m_Value     {nullptr};
+        imgui_json::value           m_Storage;
+        std::vector<Pin*>           m_Pins;
+        bool                        m_Parallel  {false};
+        bool                        m_Loaded    {false};
+        bool                        m_Failed    {false};
+    };
+    std::vector<PendingNode> pending(count);
+    std::atomic<size_t> next {0};
+
+    // Resolve once per type on this thread, prototypes are built here too
+    size_t parallelCount = 0;
+#if !defined(__EMSCRIPTEN__)
+    if (count >= k_ParallelLoadMin)
+    {
+        std::unordered_map<ID_TYPE, bool> parallelTypes;
+        for (size_t i = 0; i < count; i++)
+        {
+            ID_TYPE typeId;
+            if (!getType(i, typeId))
+                continue;
+            auto it = parallelTypes.find(typeId);
+            if (it == parallelTypes.end())
+            {
+                auto prototype = m_NodeRegistry->GetNode(typeId);
+                it = parallelTypes.emplace(typeId, prototype && prototype->ParallelLoad()).first;
+            }
+            if (it->second)
+            {
+                pending[i].m_Parallel = true;
+                parallelCount++;
+            }
+        }
+    }
+#endif
+
+    auto worker = [&]()
+    {
+        size_t index;
+        while ((index = next.fetch_add(1)) < count)
+        {
+            auto& item = pending[index];
+            if (!item.m_Parallel)
+                continue;
+            g_PendingPins = &item.m_Pins;
+            ID_TYPE typeId;
+            item.m_Value = getValue(index, item.m_Storage);
+            if (!item.m_Value || !imgui_json::GetTo<imgui_json::number>(*item.m_Value, "type_id", typeId)) // required
+            {
+                item.m_Failed = true;
+                continue;
+            }
+            item.m_Node = LoadNode(m_NodeRegistry->Create(typeId, this), *item.m_Value);
+            item.m_Loaded = true;
+        }
+        g_PendingPins = nullptr;
+    };
+
+    size_t workers = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), parallelCount / (k_ParallelLoadMin / 2));
+    if (workers > 1)
+    {
+        m_DeferPinRegistration = true;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < workers; i++)
+            threads.emplace_back(worker);
+        for (auto& thread : threads)
+            thread.join();
+        m_DeferPinRegistration = false;
+    }
+    else
+    {
+        for (auto& item : pending)
+            item.m_Parallel = false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto& item = pending[i];
+        if (!item.m_Parallel)
+        {
+            m_DeferPinRegistration = true;
+            g_PendingPins = &item.m_Pins;
+            ID_TYPE typeId;
+            item.m_Value = getValue(i, item.m_Storage);
+            if (!item.m_Value || !imgui_json::GetTo<imgui_json::number>(*item.m_Value, "type_id", typeId)) // required
+                item.m_Failed = true;
+            else
+                item.m_Node = m_NodeRegistry->Create(typeId, this);
+            g_PendingPins = nullptr;
+            m_DeferPinRegistration = false;
+        }
+
+        if (item.m_Failed)
+        {
+            // Drop what the workers built past the failing node, like a serial load stopping here
+            m_DeferPinRegistration = true;
+            for (size_t j = i; j < count; j++)
+            {
+                g_PendingPins = &pending[j].m_Pins;
+                delete pending[j].m_Node;
+            }
+            g_PendingPins = nullptr;
+            m_DeferPinRegistration = false;
+            return BP_ERR_NODE_LOAD;
+        }
+
+        for (auto pin : item.m_Pins)
+        {
+            if (!pin->m_ID) pin->m_ID = m_Generator.GenerateID();
+            m_Pins.push_back(pin);
+        }
+        if (item.m_Node && item.m_Node->m_ID == k_PendingNodeID)
+            item.m_Node->m_ID = m_Generator.GenerateID();
+        if (!item.m_Loaded)
+            item.m_Node = LoadNode(item.m_Node, *item.m_Value);
+
+        m_Nodes.emplace_back(item.m_Node);
+    }
+    return BP_ERR_NONE;
+}
+
 int BP::Import(const imgui_json::value& value, ImVec2 pos)
 {
     if (!value.is_object())
@@ -594,8 +1057,55 @@ void BP::Save(imgui_json::value& value) const
     stateValue["generator_state"] = imgui_json::number(m_Generator.State()); // required
 }
 
+void BP::SaveIncremental(imgui_json::value& value, std::vector<ID_TYPE>* changed, std::vector<ID_TYPE>* removed) const
+{
+    std::map<ID_TYPE, imgui_json::value> cache;
+    auto& nodesValue = value["nodes"]; // required
+    nodesValue = imgui_json::array();
+    for (auto& node : m_Nodes)
+    {
+        auto it = m_SaveCache.find(node->m_ID);
+        if (node->m_Dirty || it == m_SaveCache.end())
+        {
+            // clear first, a change made while saving marks the node again
+            node->m_Dirty = false;
+            imgui_json::value nodeValue;
+            nodeValue["type_id"] = imgui_json::number(node->GetTypeInfo().m_ID); // required
+            nodeValue["type_name"] = node->GetTypeInfo().m_Name; // optional, to make data readable for humans
+            node->Save(nodeValue);
+            if (changed) changed->push_back(node->m_ID);
+            nodesValue.push_back(nodeValue);
+            cache[node->m_ID] = std::move(nodeValue);
+        }
+        else
+        {
+            nodesValue.push_back(it->second);
+            cache[node->m_ID] = std::move(it->second);
+        }
+    }
+    if (removed)
+    {
+        for (auto& item : m_SaveCache)
+            if (cache.find(item.first) == cache.end())
+                removed->push_back(item.first);
+    }
+    m_SaveCache.swap(cache);
+
+    auto& stateValue = value["state"]; // required
+    stateValue["generator_state"] = imgui_json::number(m_Generator.State()); // required
+}
+
 int BP::Load(std::string path)
 {
+    if (IsBinaryBlueprint(path))
+    {
+        BinaryBlueprint file;
+        int ret = file.Open(path);
+        if (ret != BP_ERR_NONE)
+            return ret;
+        return Load(file);
+    }
+
     auto value = imgui_json::value::load(path);
     if (!value.second)
         return -1;
@@ -607,17 +1117,34 @@ bool BP::Save(std::string path) const
 {
     imgui_json::value value;
     Save(value);
+    if (IsBinaryBlueprintPath(path))
+        return SaveBinaryBlueprint(value, path);
     return value.save(path, 4);
 }
 
 ID_TYPE BP::MakeNodeID(Node* node)
 {
     (void)node;
+    if (m_DeferPinRegistration)
+        return k_PendingNodeID; // real ID is loaded or generated by LoadNodes
     return m_Generator.GenerateID();
 }
 
 ID_TYPE BP::MakePinID(Pin* pin)
 {
+    TouchLinks();
+    if (m_DeferPinRegistration)
+    {
+        if (pin && g_PendingPins)
+            g_PendingPins->push_back(pin);
+        else if (pin)
+        {
+            std::lock_guard<std::mutex> lock(g_PendingMutex);
+            m_Pins.push_back(pin);
+        }
+        return 0; // real ID is loaded or generated by LoadNodes
+    }
+
     if (pin) m_Pins.push_back(pin);
 
     return m_Generator.GenerateID();
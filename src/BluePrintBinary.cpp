@@ -0,0 +1,671 @@
+#include <BluePrintBinary.h>
+#include <BluePrint.h>
+#include <Log.h>
+#include <math.h>
+#include <ctype.h>
+#include <string.h>
+#include <stdio.h>
+#include <unordered_map>
+#include <algorithm>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace BluePrint
+{
+static inline uint64_t AlignSize(uint64_t size)
+{
+    return (size + 7) & ~uint64_t(7);
+}
+
+static inline bool RangeInside(uint64_t offset, uint64_t size, uint64_t limit)
+{
+    return offset <= limit && size <= limit - offset;
+}
+
+static bool GetU32(const imgui_json::value& value, const char* key, uint32_t& result)
+{
+    if (!value.contains(key))
+        return false;
+    auto& val = value[key];
+    if (!val.is_number())
+        return false;
+    auto number = val.get<imgui_json::number>();
+    if (number < 0 || number > (double)UINT32_MAX || number != floor(number))
+        return false;
+    result = (uint32_t)number;
+    return true;
+}
+
+// ---------------------------------
+// -------[ BinaryWriter ]----------
+// ---------------------------------
+struct BinaryWriter
+{
+    uint32_t Intern(const std::string& str)
+    {
+        auto it = m_StringIndex.find(str);
+        if (it != m_StringIndex.end())
+            return it->second;
+        uint32_t index = (uint32_t)m_Strings.size();
+        m_StringIndex.emplace(str, index);
+        m_Strings.push_back(str);
+        return index;
+    }
+
+    bool GetString(const imgui_json::value& value, const char* key, uint32_t& index)
+    {
+        if (!value.contains(key) || !value[key].is_string())
+            return false;
+        index = Intern(value[key].get<imgui_json::string>());
+        return true;
+    }
+
+    BinaryBlob AddBlob(const imgui_json::value& value)
+    {
+        auto text = value.dump();
+        BinaryBlob blob = { m_Blobs.size(), text.size() };
+        m_Blobs.insert(m_Blobs.end(), text.begin(), text.end());
+        return blob;
+    }
+
+    // Move the keys folded into a record out of `extra`, store the rest as a blob
+    BinaryBlob AddExtra(imgui_json::value& extra, const std::vector<const char*>& folded)
+    {
+        for (auto key : folded)
+            extra.erase(key);
+        if (extra.get<imgui_json::object>().empty())
+            return { 0, 0 };
+        return AddBlob(extra);
+    }
+
+    bool IsLinkFromArray(const imgui_json::value& value)
+    {
+        if (!value.is_array())
+            return false;
+        for (auto& item : value.get<imgui_json::array>())
+        {
+            uint32_t id;
+            if (!item.is_object() || item.get<imgui_json::object>().size() != 1 || !GetU32(item, "link_id", id))
+                return false;
+        }
+        return true;
+    }
+
+    bool IsObjectArray(const imgui_json::value& value)
+    {
+        if (!value.is_array())
+            return false;
+        for (auto& item : value.get<imgui_json::array>())
+            if (!item.is_object())
+                return false;
+        return true;
+    }
+
+    void AddPin(const imgui_json::value& value)
+    {
+        BinaryPin pin;
+        memset(&pin, 0, sizeof(pin));
+        if (!value.is_object())
+        {
+            pin.m_Fields = BP_BINARY_PIN_RAW;
+            pin.m_Extra = AddBlob(value);
+            m_Pins.push_back(pin);
+            return;
+        }
+
+        std::vector<const char*> folded;
+        if (GetU32(value, "id", pin.m_ID))          { pin.m_Fields |= BP_BINARY_PIN_ID; folded.push_back("id"); }
+        if (GetU32(value, "link", pin.m_Link))      { pin.m_Fields |= BP_BINARY_PIN_LINK; folded.push_back("link"); }
+        if (GetU32(value, "map", pin.m_Map))        { pin.m_Fields |= BP_BINARY_PIN_MAP; folded.push_back("map"); }
+        if (GetU32(value, "flags", pin.m_Flags))    { pin.m_Fields |= BP_BINARY_PIN_FLAGS; folded.push_back("flags"); }
+        if (GetString(value, "type", pin.m_Type))   { pin.m_Fields |= BP_BINARY_PIN_TYPE; folded.push_back("type"); }
+        if (GetString(value, "name", pin.m_Name))   { pin.m_Fields |= BP_BINARY_PIN_NAME; folded.push_back("name"); }
+        if (value.contains("link_from") && IsLinkFromArray(value["link_from"]))
+        {
+            pin.m_Fields |= BP_BINARY_PIN_LINK_FROM;
+            pin.m_LinkFromStart = (uint32_t)m_Links.size();
+            for (auto& item : value["link_from"].get<imgui_json::array>())
+            {
+                uint32_t id = 0;
+                GetU32(item, "link_id", id);
+                m_Links.push_back(id);
+            }
+            pin.m_LinkFromCount = (uint32_t)m_Links.size() - pin.m_LinkFromStart;
+            folded.push_back("link_from");
+        }
+
+        imgui_json::value extra = value;
+        pin.m_Extra = AddExtra(extra, folded);
+        m_Pins.push_back(pin);
+    }
+
+    void AddPins(const imgui_json::value& value, uint32_t& start, uint32_t& count)
+    {
+        start = (uint32_t)m_Pins.size();
+        for (auto& pinValue : value.get<imgui_json::array>())
+            AddPin(pinValue);
+        count = (uint32_t)m_Pins.size() - start;
+    }
+
+    void AddNode(const imgui_json::value& value)
+    {
+        BinaryNode node;
+        memset(&node, 0, sizeof(node));
+        if (!value.is_object())
+        {
+            node.m_Fields = BP_BINARY_NODE_RAW;
+            node.m_Extra = AddBlob(value);
+            m_Nodes.push_back(node);
+            return;
+        }
+
+        std::vector<const char*> folded;
+        if (GetU32(value, "type_id", node.m_TypeID))        { node.m_Fields |= BP_BINARY_NODE_TYPE_ID; folded.push_back("type_id"); }
+        if (GetU32(value, "id", node.m_ID))                 { node.m_Fields |= BP_BINARY_NODE_ID; folded.push_back("id"); }
+        if (GetU32(value, "group_id", node.m_GroupID))      { node.m_Fields |= BP_BINARY_NODE_GROUP_ID; folded.push_back("group_id"); }
+        if (GetString(value, "name", node.m_Name))          { node.m_Fields |= BP_BINARY_NODE_NAME; folded.push_back("name"); }
+        if (GetString(value, "type_name", node.m_TypeName)) { node.m_Fields |= BP_BINARY_NODE_TYPE_NAME; folded.push_back("type_name"); }
+        if (GetString(value, "type", node.m_Type))          { node.m_Fields |= BP_BINARY_NODE_TYPE; folded.push_back("type"); }
+        if (GetString(value, "style", node.m_Style))        { node.m_Fields |= BP_BINARY_NODE_STYLE; folded.push_back("style"); }
+        if (GetString(value, "catalog", node.m_Catalog))    { node.m_Fields |= BP_BINARY_NODE_CATALOG; folded.push_back("catalog"); }
+        if (GetString(value, "version", node.m_Version))    { node.m_Fields |= BP_BINARY_NODE_VERSION; folded.push_back("version"); }
+        if (value.contains("enabled") && value["enabled"].is_boolean())
+        {
+            node.m_Fields |= BP_BINARY_NODE_ENABLED;
+            if (value["enabled"].get<imgui_json::boolean>()) node.m_Fields |= BP_BINARY_NODE_ENABLED_ON;
+            folded.push_back("enabled");
+        }
+        if (value.contains("break_point") && value["break_point"].is_boolean())
+        {
+            node.m_Fields |= BP_BINARY_NODE_BREAK_POINT;
+            if (value["break_point"].get<imgui_json::boolean>()) node.m_Fields |= BP_BINARY_NODE_BREAK_ON;
+            folded.push_back("break_point");
+        }
+        if (value.contains("input_pins") && IsObjectArray(value["input_pins"]))
+        {
+            node.m_Fields |= BP_BINARY_NODE_INPUT_PINS;
+            AddPins(value["input_pins"], node.m_InputPinStart, node.m_InputPinCount);
+            folded.push_back("input_pins");
+        }
+        if (value.contains("output_pins") && IsObjectArray(value["output_pins"]))
+        {
+            node.m_Fields |= BP_BINARY_NODE_OUTPUT_PINS;
+            AddPins(value["output_pins"], node.m_OutputPinStart, node.m_OutputPinCount);
+            folded.push_back("output_pins");
+        }
+
+        imgui_json::value extra = value;
+        node.m_Extra = AddExtra(extra, folded);
+        m_Nodes.push_back(node);
+    }
+
+    void Write(BinaryHeader& header, std::vector<uint8_t>& data)
+    {
+        uint64_t string_bytes = 0;
+        for (auto& str : m_Strings)
+            string_bytes += str.size() + 1;
+
+        header.m_StringCount = (uint32_t)m_Strings.size();
+        header.m_NodeCount = (uint32_t)m_Nodes.size();
+        header.m_PinCount = (uint32_t)m_Pins.size();
+        header.m_LinkCount = (uint32_t)m_Links.size();
+        header.m_StringOffset = AlignSize(sizeof(BinaryHeader));
+        header.m_NodeOffset = AlignSize(header.m_StringOffset + sizeof(BinaryString) * m_Strings.size() + string_bytes);
+        header.m_PinOffset = AlignSize(header.m_NodeOffset + sizeof(BinaryNode) * m_Nodes.size());
+        header.m_LinkOffset = AlignSize(header.m_PinOffset + sizeof(BinaryPin) * m_Pins.size());
+        header.m_BlobOffset = AlignSize(header.m_LinkOffset + sizeof(uint32_t) * m_Links.size());
+        header.m_BlobSize = m_Blobs.size();
+        header.m_FileSize = header.m_BlobOffset + header.m_BlobSize;
+
+        data.assign(header.m_FileSize, 0);
+        memcpy(data.data(), &header, sizeof(header));
+
+        auto string_records = (BinaryString *)(data.data() + header.m_StringOffset);
+        auto string_data = (char *)(string_records + m_Strings.size());
+        uint32_t offset = 0;
+        for (size_t i = 0; i < m_Strings.size(); i++)
+        {
+            string_records[i].m_Offset = offset;
+            string_records[i].m_Size = (uint32_t)m_Strings[i].size();
+            memcpy(string_data + offset, m_Strings[i].c_str(), m_Strings[i].size() + 1);
+            offset += (uint32_t)m_Strings[i].size() + 1;
+        }
+        if (!m_Nodes.empty()) memcpy(data.data() + header.m_NodeOffset, m_Nodes.data(), sizeof(BinaryNode) * m_Nodes.size());
+        if (!m_Pins.empty()) memcpy(data.data() + header.m_PinOffset, m_Pins.data(), sizeof(BinaryPin) * m_Pins.size());
+        if (!m_Links.empty()) memcpy(data.data() + header.m_LinkOffset, m_Links.data(), sizeof(uint32_t) * m_Links.size());
+        if (!m_Blobs.empty()) memcpy(data.data() + header.m_BlobOffset, m_Blobs.data(), m_Blobs.size());
+    }
+
+    std::unordered_map<std::string, uint32_t>   m_StringIndex;
+    std::vector<std::string>                    m_Strings;
+    std::vector<BinaryNode>                     m_Nodes;
+    std::vector<BinaryPin>                      m_Pins;
+    std::vector<uint32_t>                       m_Links;
+    std::vector<char>                           m_Blobs;
+};
+
+// Returns the json object holding the "nodes" array, either a blueprint or a document
+static const imgui_json::value* FindBlueprintValue(const imgui_json::value& value, bool& is_document)
+{
+    is_document = false;
+    if (!value.is_object())
+        return nullptr;
+    if (value.contains("nodes") && value["nodes"].is_array())
+        return &value;
+    if (value.contains("document") && value["document"].is_object())
+    {
+        auto& document = value["document"];
+        if (document.contains("blueprint") && document["blueprint"].is_object())
+        {
+            auto& blueprint = document["blueprint"];
+            if (blueprint.contains("nodes") && blueprint["nodes"].is_array())
+            {
+                is_document = true;
+                return &blueprint;
+            }
+        }
+    }
+    return nullptr;
+}
+
+int BinaryBlueprintFromJson(const imgui_json::value& value, std::vector<uint8_t>& data)
+{
+    bool is_document = false;
+    auto blueprint = FindBlueprintValue(value, is_document);
+    if (!blueprint)
+        return BP_ERR_DOC_LOAD;
+
+    BinaryWriter writer;
+    BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    header.m_Magic = BP_BINARY_MAGIC;
+    header.m_Version = BP_BINARY_VERSION;
+    header.m_SDK_Version = VERSION_BLUEPRINT;
+    if (is_document)
+        header.m_Flags |= BP_BINARY_FILE_DOCUMENT;
+    if (blueprint->contains("state") && GetU32((*blueprint)["state"], "generator_state", header.m_GeneratorState))
+        header.m_Flags |= BP_BINARY_FILE_STATE;
+
+    for (auto& nodeValue : (*blueprint)["nodes"].get<imgui_json::array>())
+        writer.AddNode(nodeValue);
+
+    imgui_json::value root = value;
+    if (is_document)
+        root["document"]["blueprint"].erase("nodes");
+    else
+        root.erase("nodes");
+    header.m_Root = writer.AddBlob(root);
+
+    writer.Write(header, data);
+    return BP_ERR_NONE;
+}
+
+// ---------------------------------
+// -------[ BinaryBlueprint ]-------
+// ---------------------------------
+BinaryBlueprint::~BinaryBlueprint()
+{
+    Close();
+}
+
+int BinaryBlueprint::Open(const std::string& path)
+{
+    Close();
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return BP_ERR_DOC_LOAD;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(BinaryHeader))
+    {
+        CloseHandle(file);
+        return BP_ERR_DOC_LOAD;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return BP_ERR_DOC_LOAD;
+    }
+    m_File = file;
+    m_MapHandle = mapping;
+    m_Mapping = view;
+    m_MappingSize = (size_t)file_size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return BP_ERR_DOC_LOAD;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(BinaryHeader))
+    {
+        close(fd);
+        return BP_ERR_DOC_LOAD;
+    }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // mapping stays valid after close
+    if (view == MAP_FAILED)
+        return BP_ERR_DOC_LOAD;
+    m_Mapping = view;
+    m_MappingSize = (size_t)st.st_size;
+#endif
+    int ret = Open(m_Mapping, m_MappingSize);
+    if (ret != BP_ERR_NONE)
+        Close();
+    return ret;
+}
+
+int BinaryBlueprint::Open(const void* data, size_t size)
+{
+    m_Header = nullptr;
+    if (!data || size < sizeof(BinaryHeader) || ((uintptr_t)data & 7))
+        return BP_ERR_DOC_LOAD;
+
+    auto header = (const BinaryHeader *)data;
+    if (header->m_Magic != BP_BINARY_MAGIC || header->m_Version != BP_BINARY_VERSION)
+    {
+        LOGE("[BinaryBlueprint] Bad magic or unsupported version");
+        return BP_ERR_DOC_LOAD;
+    }
+    if (header->m_FileSize > size ||
+        !RangeInside(header->m_StringOffset, (uint64_t)header->m_StringCount * sizeof(BinaryString), size) ||
+        !RangeInside(header->m_NodeOffset, (uint64_t)header->m_NodeCount * sizeof(BinaryNode), size) ||
+        !RangeInside(header->m_PinOffset, (uint64_t)header->m_PinCount * sizeof(BinaryPin), size) ||
+        !RangeInside(header->m_LinkOffset, (uint64_t)header->m_LinkCount * sizeof(uint32_t), size) ||
+        !RangeInside(header->m_BlobOffset, header->m_BlobSize, size) ||
+        ((header->m_StringOffset | header->m_NodeOffset | header->m_PinOffset | header->m_LinkOffset) & 7))
+    {
+        LOGE("[BinaryBlueprint] Truncated or corrupted file");
+        return BP_ERR_DOC_LOAD;
+    }
+
+    m_Data = (const uint8_t *)data;
+    m_Size = size;
+    m_Header = header;
+    return BP_ERR_NONE;
+}
+
+void BinaryBlueprint::Close()
+{
+#if defined(_WIN32)
+    if (m_Mapping) UnmapViewOfFile(m_Mapping);
+    if (m_MapHandle) CloseHandle((HANDLE)m_MapHandle);
+    if (m_File) CloseHandle((HANDLE)m_File);
+    m_MapHandle = nullptr;
+    m_File = nullptr;
+#else
+    if (m_Mapping) munmap(m_Mapping, m_MappingSize);
+#endif
+    m_Mapping = nullptr;
+    m_MappingSize = 0;
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Header = nullptr;
+}
+
+const BinaryNode* BinaryBlueprint::GetNode(uint32_t index) const
+{
+    if (!m_Header || index >= m_Header->m_NodeCount)
+        return nullptr;
+    return (const BinaryNode *)(m_Data + m_Header->m_NodeOffset) + index;
+}
+
+const BinaryPin* BinaryBlueprint::GetPin(uint32_t index) const
+{
+    if (!m_Header || index >= m_Header->m_PinCount)
+        return nullptr;
+    return (const BinaryPin *)(m_Data + m_Header->m_PinOffset) + index;
+}
+
+const char* BinaryBlueprint::GetString(uint32_t index, uint32_t* size) const
+{
+    if (!m_Header || index >= m_Header->m_StringCount)
+        return nullptr;
+    auto records = (const BinaryString *)(m_Data + m_Header->m_StringOffset);
+    uint64_t base = m_Header->m_StringOffset + (uint64_t)m_Header->m_StringCount * sizeof(BinaryString);
+    auto& record = records[index];
+    if (!RangeInside(base + record.m_Offset, (uint64_t)record.m_Size + 1, m_Size))
+        return nullptr;
+    auto str = (const char *)(m_Data + base + record.m_Offset);
+    if (str[record.m_Size] != '\0')
+        return nullptr;
+    if (size) *size = record.m_Size;
+    return str;
+}
+
+const char* BinaryBlueprint::GetBlob(const BinaryBlob& blob) const
+{
+    if (!m_Header || !RangeInside(blob.m_Offset, blob.m_Size, m_Header->m_BlobSize))
+        return nullptr;
+    return (const char *)(m_Data + m_Header->m_BlobOffset + blob.m_Offset);
+}
+
+bool BinaryBlueprint::ParseBlob(const BinaryBlob& blob, imgui_json::value& value) const
+{
+    auto text = GetBlob(blob);
+    if (!text)
+        return false;
+    value = imgui_json::value::parse(std::string(text, (size_t)blob.m_Size));
+    return !value.is_discarded();
+}
+
+int BinaryBlueprint::GetPinValue(uint32_t index, imgui_json::value& value) const
+{
+    auto pin = GetPin(index);
+    if (!pin)
+        return BP_ERR_PIN_NUMPER;
+
+    if (pin->m_Fields & BP_BINARY_PIN_RAW)
+        return ParseBlob(pin->m_Extra, value) ? BP_ERR_NONE : BP_ERR_PIN_NUMPER;
+
+    value = imgui_json::object();
+    if (pin->m_Extra.m_Size && !ParseBlob(pin->m_Extra, value))
+        return BP_ERR_PIN_NUMPER;
+
+    const char* str = nullptr;
+    if (pin->m_Fields & BP_BINARY_PIN_ID)       value["id"] = imgui_json::number(pin->m_ID);
+    if (pin->m_Fields & BP_BINARY_PIN_LINK)     value["link"] = imgui_json::number(pin->m_Link);
+    if (pin->m_Fields & BP_BINARY_PIN_MAP)      value["map"] = imgui_json::number(pin->m_Map);
+    if (pin->m_Fields & BP_BINARY_PIN_FLAGS)    value["flags"] = imgui_json::number(pin->m_Flags);
+    if (pin->m_Fields & BP_BINARY_PIN_TYPE)
+    {
+        if (!(str = GetString(pin->m_Type))) return BP_ERR_PIN_NUMPER;
+        value["type"] = imgui_json::string(str);
+    }
+    if (pin->m_Fields & BP_BINARY_PIN_NAME)
+    {
+        if (!(str = GetString(pin->m_Name))) return BP_ERR_PIN_NUMPER;
+        value["name"] = imgui_json::string(str);
+    }
+    if (pin->m_Fields & BP_BINARY_PIN_LINK_FROM)
+    {
+        if (!RangeInside(pin->m_LinkFromStart, pin->m_LinkFromCount, m_Header->m_LinkCount))
+            return BP_ERR_PIN_LINK;
+        auto links = (const uint32_t *)(m_Data + m_Header->m_LinkOffset) + pin->m_LinkFromStart;
+        auto& linkFromValue = value["link_from"];
+        linkFromValue = imgui_json::array();
+        for (uint32_t i = 0; i < pin->m_LinkFromCount; i++)
+        {
+            imgui_json::value linkValue;
+            linkValue["link_id"] = imgui_json::number(links[i]);
+            linkFromValue.push_back(linkValue);
+        }
+    }
+    return BP_ERR_NONE;
+}
+
+int BinaryBlueprint::GetPinsValue(uint32_t start, uint32_t count, imgui_json::value& value) const
+{
+    if (!RangeInside(start, count, m_Header->m_PinCount))
+        return BP_ERR_PIN_NUMPER;
+    value = imgui_json::array();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        imgui_json::value pinValue;
+        int ret = GetPinValue(start + i, pinValue);
+        if (ret != BP_ERR_NONE)
+            return ret;
+        value.push_back(pinValue);
+    }
+    return BP_ERR_NONE;
+}
+
+int BinaryBlueprint::GetNodeValue(uint32_t index, imgui_json::value& value) const
+{
+    auto node = GetNode(index);
+    if (!node)
+        return BP_ERR_NODE_LOAD;
+
+    if (node->m_Fields & BP_BINARY_NODE_RAW)
+        return ParseBlob(node->m_Extra, value) ? BP_ERR_NONE : BP_ERR_NODE_LOAD;
+
+    value = imgui_json::object();
+    if (node->m_Extra.m_Size && !ParseBlob(node->m_Extra, value))
+        return BP_ERR_NODE_LOAD;
+
+    struct { uint32_t field; uint32_t index; const char* key; } strings[] =
+    {
+        { BP_BINARY_NODE_NAME,      node->m_Name,       "name" },
+        { BP_BINARY_NODE_TYPE_NAME, node->m_TypeName,   "type_name" },
+        { BP_BINARY_NODE_TYPE,      node->m_Type,       "type" },
+        { BP_BINARY_NODE_STYLE,     node->m_Style,      "style" },
+        { BP_BINARY_NODE_CATALOG,   node->m_Catalog,    "catalog" },
+        { BP_BINARY_NODE_VERSION,   node->m_Version,    "version" },
+    };
+    for (auto& item : strings)
+    {
+        if (!(node->m_Fields & item.field))
+            continue;
+        auto str = GetString(item.index);
+        if (!str)
+            return BP_ERR_NODE_LOAD;
+        value[item.key] = imgui_json::string(str);
+    }
+    if (node->m_Fields & BP_BINARY_NODE_TYPE_ID)     value["type_id"] = imgui_json::number(node->m_TypeID);
+    if (node->m_Fields & BP_BINARY_NODE_ID)          value["id"] = imgui_json::number(node->m_ID);
+    if (node->m_Fields & BP_BINARY_NODE_GROUP_ID)    value["group_id"] = imgui_json::number(node->m_GroupID);
+    if (node->m_Fields & BP_BINARY_NODE_ENABLED)     value["enabled"] = imgui_json::boolean((node->m_Fields & BP_BINARY_NODE_ENABLED_ON) != 0);
+    if (node->m_Fields & BP_BINARY_NODE_BREAK_POINT) value["break_point"] = imgui_json::boolean((node->m_Fields & BP_BINARY_NODE_BREAK_ON) != 0);
+
+    if ((node->m_Fields & BP_BINARY_NODE_INPUT_PINS) &&
+        GetPinsValue(node->m_InputPinStart, node->m_InputPinCount, value["input_pins"]) != BP_ERR_NONE)
+        return BP_ERR_INPIN_LOAD;
+    if ((node->m_Fields & BP_BINARY_NODE_OUTPUT_PINS) &&
+        GetPinsValue(node->m_OutputPinStart, node->m_OutputPinCount, value["output_pins"]) != BP_ERR_NONE)
+        return BP_ERR_OUTPIN_LOAD;
+    return BP_ERR_NONE;
+}
+
+int BinaryBlueprint::GetValue(imgui_json::value& value) const
+{
+    if (!m_Header)
+        return BP_ERR_DOC_LOAD;
+    if (!ParseBlob(m_Header->m_Root, value) || !value.is_object())
+        return BP_ERR_DOC_LOAD;
+
+    imgui_json::value nodesValue = imgui_json::array();
+    for (uint32_t i = 0; i < m_Header->m_NodeCount; i++)
+    {
+        imgui_json::value nodeValue;
+        int ret = GetNodeValue(i, nodeValue);
+        if (ret != BP_ERR_NONE)
+            return ret;
+        nodesValue.push_back(nodeValue);
+    }
+
+    if (m_Header->m_Flags & BP_BINARY_FILE_DOCUMENT)
+        value["document"]["blueprint"]["nodes"] = nodesValue;
+    else
+        value["nodes"] = nodesValue;
+    return BP_ERR_NONE;
+}
+
+int BinaryBlueprint::GetBlueprintValue(imgui_json::value& value) const
+{
+    if (!m_Header)
+        return BP_ERR_DOC_LOAD;
+    imgui_json::value root;
+    if (!ParseBlob(m_Header->m_Root, root) || !root.is_object())
+        return BP_ERR_DOC_LOAD;
+
+    if (m_Header->m_Flags & BP_BINARY_FILE_DOCUMENT)
+    {
+        if (!root.contains("document") || !root["document"].contains("blueprint"))
+            return BP_ERR_DOC_LOAD;
+        value = root["document"]["blueprint"];
+    }
+    else
+        value = std::move(root);
+    return value.is_object() ? BP_ERR_NONE : BP_ERR_DOC_LOAD;
+}
+
+// ---------------------------------
+// -------[ Binary Helpers ]--------
+// ---------------------------------
+bool IsBinaryBlueprint(const std::string& path)
+{
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp)
+        return false;
+    uint32_t magic = 0;
+    bool is_binary = fread(&magic, 1, sizeof(magic), fp) == sizeof(magic) && magic == BP_BINARY_MAGIC;
+    fclose(fp);
+    return is_binary;
+}
+
+bool IsBinaryBlueprintPath(const std::string& path)
+{
+    std::string ext = BP_BINARY_EXTENSION;
+    if (path.size() < ext.size())
+        return false;
+    auto suffix = path.substr(path.size() - ext.size());
+    std::transform(suffix.begin(), suffix.end(), suffix.begin(), ::tolower);
+    return suffix == ext;
+}
+
+int LoadBinaryBlueprint(const std::string& path, imgui_json::value& value)
+{
+    BinaryBlueprint file;
+    int ret = file.Open(path);
+    if (ret != BP_ERR_NONE)
+        return ret;
+    return file.GetValue(value);
+}
+
+bool SaveBinaryBlueprint(const imgui_json::value& value, const std::string& path)
+{
+    std::vector<uint8_t> data;
+    if (BinaryBlueprintFromJson(value, data) != BP_ERR_NONE)
+        return false;
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp)
+        return false;
+    bool done = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    fclose(fp);
+    return done;
+}
+
+int ConvertJsonToBinary(const std::string& json_path, const std::string& binary_path)
+{
+    auto value = imgui_json::value::load(json_path);
+    if (!value.second)
+        return BP_ERR_DOC_LOAD;
+    return SaveBinaryBlueprint(value.first, binary_path) ? BP_ERR_NONE : BP_ERR_GENERAL;
+}
+
+int ConvertBinaryToJson(const std::string& binary_path, const std::string& json_path)
+{
+    imgui_json::value value;
+    int ret = LoadBinaryBlueprint(binary_path, value);
+    if (ret != BP_ERR_NONE)
+        return ret;
+    return value.save(json_path, 4) ? BP_ERR_NONE : BP_ERR_GENERAL;
+}
+} // namespace BluePrint
@@ -1,8 +1,8 @@
 #pragma once
 #include <imgui.h>
-#include <Utils.h>
-#include <imgui_node_editor_internal.h>
-namespace edd = ax::NodeEditor::Detail;
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 
 #define EXPORT_PIN_NAME(pin_name, node_name, node_type) \
         pin_name + "$" + node_name + "$" + node_type
@@ -17,7 +17,7 @@ struct GroupNode final : Node
         /*
         // we don't clean GroupNode here, if we remove Group node, clear will be done at OnNodeDeleted
         m_mutex.lock();
-        for (auto node : m_GroupNodes) { node->m_GroupID = 0; ed::SetNodeGroupID(m_ID, ed::NodeId::Invalid); }
+        for (auto node : m_GroupNodes) { node->m_GroupID = 0; Editor::SetNodeGroupID(m_ID, 0); }
         for (auto pin : m_InputBridgePins)  { delete pin; }
         for (auto pin : m_InputShadowPins)  { delete pin; }
         for (auto pin : m_OutputBridgePins) { delete pin; }
@@ -152,6 +152,7 @@ struct GroupNode final : Node
             (*shadow_pin)->m_MappedPin = pin->m_ID;
             (*shadow_pin)->m_Flags = PIN_FLAG_SHADOW | PIN_FLAG_IN;
             m_InputShadowPins.push_back(*shadow_pin);
+            m_Dirty = true;
         }
         else
         {
@@ -189,6 +190,7 @@ struct GroupNode final : Node
         {
             shadow_pin = *it;
             m_InputShadowPins.erase(it);
+            m_Dirty = true;
         }
         if (!bridge_pin || !shadow_pin)
             return;
@@ -292,6 +294,7 @@ struct GroupNode final : Node
             (*shadow_pin)->m_MappedPin = pin->m_ID;
             (*shadow_pin)->m_Flags = PIN_FLAG_SHADOW | PIN_FLAG_OUT;
             m_OutputShadowPins.push_back(*shadow_pin);
+            m_Dirty = true;
         }
         else
         {
@@ -327,6 +330,7 @@ struct GroupNode final : Node
         {
             shadow_pin = *it;
             m_OutputShadowPins.erase(it);
+            m_Dirty = true;
         }
         if (!bridge_pin || !shadow_pin)
             return;
@@ -374,8 +378,8 @@ struct GroupNode final : Node
             {
                 if (std::find(m_GroupNodes.begin(), m_GroupNodes.end(), node) == m_GroupNodes.end())
                 {
-                    node->m_GroupID = m_ID;
-                    ed::SetNodeGroupID(node->m_ID, m_ID);
+                    node->SetGroupID(m_ID);
+                    Editor::SetNodeGroupID(node->m_ID, m_ID);
                     m_GroupNodes.push_back(node);
                 }
             }
@@ -425,6 +429,7 @@ struct GroupNode final : Node
                                 if (it_s != m_OutputShadowPins.end())
                                 {
                                     m_OutputShadowPins.erase(it_s);
+                                    m_Dirty = true;
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
@@ -529,8 +534,7 @@ struct GroupNode final : Node
                             shadow_pin->LinkTo(*pin);
                         }
                     }
-                    if (export_pin) pin->m_Flags |= PIN_FLAG_EXPORTED;
-                    else pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                    pin->SetFlag(PIN_FLAG_EXPORTED, export_pin);
                 }
                 else
                 {
@@ -542,7 +546,7 @@ struct GroupNode final : Node
                         if (PinIsBridgeOut(*link) && linked_node == this)
                         {
                             // data input pin link with inside
-                            pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, false);
                             // 1. get shadow pin(single link)
                             auto shadow_pin = link->GetLink(m_Blueprint);
                             if (!shadow_pin)
@@ -569,6 +573,7 @@ struct GroupNode final : Node
                                 if (it_s != m_OutputShadowPins.end())
                                 {
                                     m_OutputShadowPins.erase(it_s);
+                                    m_Dirty = true;
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
@@ -577,14 +582,14 @@ struct GroupNode final : Node
                         else if (std::find(nodes.begin(), nodes.end(), linked_node) != nodes.end())
                         {
                             // data input pin link with inside pin
-                            pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, false);
                             if (pin->m_Link != link->m_ID)
                                 pin->LinkTo(*link);
                         }
                         else if (PinIsBridgeOut(*link))
                         {
                             // data input pin link with other group
-                            pin->m_Flags |= PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, true);
                             AddInputMapPin(pin);
                             // 1. create input pin for current group if not exist
                             Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
@@ -618,20 +623,20 @@ struct GroupNode final : Node
                             if (!(pin->m_Flags & PIN_FLAG_PUBLICIZED) && !bridge_pin->m_Link)
                             {
                                 // 2. if pin isn't public and bridge link from is 0, delete input pin
-                                pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                                pin->SetFlag(PIN_FLAG_EXPORTED, false);
                                 RemoveInputPin(pin);
                             }
                             else
                             {
                                 // 3. if pin is public or bridge has link from, insert input pin
-                                pin->m_Flags |= PIN_FLAG_EXPORTED;
+                                pin->SetFlag(PIN_FLAG_EXPORTED, true);
                                 AddInputMapPin(pin);
                             }
                         }
                         else
                         {
                             // data input pin link with outside
-                            pin->m_Flags |= PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, true);
                             AddInputMapPin(pin);
                             // 1. create input pin for current group if not exist
                             Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
@@ -658,7 +663,7 @@ struct GroupNode final : Node
                     if ((pin->m_Flags & PIN_FLAG_PUBLICIZED) && !(pin->m_Flags & PIN_FLAG_EXPORTED) && !pin->m_Link)
                     {
                         // data input pin is public without link
-                        pin->m_Flags |= PIN_FLAG_EXPORTED;
+                        pin->SetFlag(PIN_FLAG_EXPORTED, true);
                         AddInputMapPin(pin);
                         // 1. create input pin for current group if not exist
                         Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
@@ -689,7 +694,7 @@ struct GroupNode final : Node
                         if (PinIsBridgeIn(*link) && linked_node == this)
                         {
                             // flow output pin link with inside pin
-                            pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, false);
                             // 1. unlink current pin with bridge in pin
                             pin->Unlink();
                             // 2. get shadow pin with bridge in pin
@@ -716,6 +721,7 @@ struct GroupNode final : Node
                                 if (it_s != m_InputShadowPins.end())
                                 {
                                     m_InputShadowPins.erase(it_s);
+                                    m_Dirty = true;
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
@@ -724,14 +730,14 @@ struct GroupNode final : Node
                         else if (std::find(nodes.begin(), nodes.end(), linked_node) != nodes.end())
                         {
                             // flow output pin link with inside pin
-                            pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, false);
                             if (pin->m_Link != link->m_ID)
                                 pin->LinkTo(*link);
                         }
                         else if (PinIsBridgeIn(*link))
                         {
                             // flow output pin link with other group
-                            pin->m_Flags |= PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, true);
                             AddOutputMapPin(pin);
                             // 1. unlink current pin with other group Bridge in pin
                             pin->Unlink();
@@ -765,20 +771,20 @@ struct GroupNode final : Node
                             if (!(pin->m_Flags & PIN_FLAG_PUBLICIZED) && !bridge_pin->m_Link)
                             {
                                 // 2. if pin isn't public and bridge link from is 0, delete input pin
-                                pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                                pin->SetFlag(PIN_FLAG_EXPORTED, false);
                                 RemoveOutputPin(pin);
                             }
                             else
                             {
                                 // 3. if pin is public or bridge has link from, insert input pin
-                                pin->m_Flags |= PIN_FLAG_EXPORTED;
+                                pin->SetFlag(PIN_FLAG_EXPORTED, true);
                                 AddOutputMapPin(pin);
                             }
                         }
                         else
                         {
                             // flow output pin link with outside pin
-                            pin->m_Flags |= PIN_FLAG_EXPORTED;
+                            pin->SetFlag(PIN_FLAG_EXPORTED, true);
                             AddOutputMapPin(pin);
                             // 1. create current group output pin if not exist
                             Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
@@ -806,7 +812,7 @@ struct GroupNode final : Node
                     if ((pin->m_Flags & PIN_FLAG_PUBLICIZED) && !(pin->m_Flags & PIN_FLAG_EXPORTED) && !pin->m_Link)
                     {
                         // flow pin is public without link
-                        pin->m_Flags |= PIN_FLAG_EXPORTED;
+                        pin->SetFlag(PIN_FLAG_EXPORTED, true);
                         AddOutputMapPin(pin);
                         // 1. create current group output pin if not exist
                         Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
@@ -864,6 +870,7 @@ struct GroupNode final : Node
                                 if (it_s != m_InputShadowPins.end())
                                 {
                                     m_InputShadowPins.erase(it_s);
+                                    m_Dirty = true;
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
@@ -967,8 +974,7 @@ struct GroupNode final : Node
                             shadow_pin->LinkTo(*pin);
                         }
                     }
-                    if (export_pin) pin->m_Flags |= PIN_FLAG_EXPORTED;
-                    else pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                    pin->SetFlag(PIN_FLAG_EXPORTED, export_pin);
                 }
             }
         }
@@ -980,9 +986,9 @@ struct GroupNode final : Node
                 auto node = *iter;
                 if (node->m_GroupID == m_ID)
                 {
-                    node->m_GroupID = 0;
-                    ed::SetNodeGroupID(node->m_ID, ed::NodeId::Invalid);
-                    ed::SetNodeZPosition(node->m_ID, 0);
+                    node->SetGroupID(0);
+                    Editor::SetNodeGroupID(node->m_ID, 0);
+                    Editor::SetNodeZPosition(node->m_ID, 0);
                 }
                 iter = m_GroupNodes.erase(iter);
                 for (auto pin : node->GetInputPins())
@@ -990,7 +996,7 @@ struct GroupNode final : Node
                     auto it = std::find(m_InputMapPins.begin(), m_InputMapPins.end(), pin);
                     if (it != m_InputMapPins.end())
                     {
-                        pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                        pin->SetFlag(PIN_FLAG_EXPORTED, false);
                         m_InputMapPins.erase(it);
                         RemoveInputPin(pin);
                     }
@@ -1000,7 +1006,7 @@ struct GroupNode final : Node
                     auto it = std::find(m_OutputMapPins.begin(), m_OutputMapPins.end(), pin);
                     if (it != m_OutputMapPins.end())
                     {
-                        pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                        pin->SetFlag(PIN_FLAG_EXPORTED, false);
                         m_OutputMapPins.erase(it);
                         RemoveOutputPin(pin);
                     }
@@ -1012,16 +1018,49 @@ struct GroupNode final : Node
             }
         }
 
-        ed::SetNodeZPosition(m_ID, m_ZPos); 
+        Editor::SetNodeZPosition(m_ID, m_ZPos);
         // re-order Z position
         for (auto iter = m_GroupNodes.begin(); iter != m_GroupNodes.end();iter ++)
         {
             auto node = *iter;
-            ed::SetNodeZPosition(node->m_ID, m_ZPos + 1);
+            Editor::SetNodeZPosition(node->m_ID, m_ZPos + 1);
         }
         m_mutex.unlock();
     }
 
+    void OnNodeReplaced(Node * from, Node * to) override
+    {
+        m_mutex.lock();
+        std::replace(m_GroupNodes.begin(), m_GroupNodes.end(), from, to);
+        // the reloaded node kept its pin ids, a pin it no longer has is unexported
+        auto remap = [&](std::vector<Pin *>& map_pins, span<Pin*> to_pins, bool input)
+        {
+            auto old_pins = input ? from->GetInputPins() : from->GetOutputPins();
+            for (auto iter = map_pins.begin(); iter != map_pins.end();)
+            {
+                if (std::find(old_pins.begin(), old_pins.end(), *iter) == old_pins.end())
+                {
+                    iter ++;
+                    continue;
+                }
+                ID_TYPE pid = (*iter)->m_ID;
+                auto found = std::find_if(to_pins.begin(), to_pins.end(), [pid](Pin * const pin) { return pin->m_ID == pid; });
+                if (found != to_pins.end())
+                {
+                    *iter = *found;
+                    iter ++;
+                    continue;
+                }
+                if (input) RemoveInputPin(*iter, false);
+                else RemoveOutputPin(*iter, false);
+                iter = map_pins.erase(iter);
+            }
+        };
+        remap(m_InputMapPins, to->GetInputPins(), true);
+        remap(m_OutputMapPins, to->GetOutputPins(), false);
+        m_mutex.unlock();
+    }
+
     void OnNodeDelete(Node * node) override
     {
         m_mutex.lock();
@@ -1061,20 +1100,20 @@ struct GroupNode final : Node
             // delete self
             for (auto pin : m_InputMapPins)
             {
-                pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                pin->SetFlag(PIN_FLAG_EXPORTED, false);
                 RemoveInputPin(pin);
             }
             for (auto pin : m_OutputMapPins)
             {
-                pin->m_Flags &= ~PIN_FLAG_EXPORTED;
+                pin->SetFlag(PIN_FLAG_EXPORTED, false);
                 RemoveOutputPin(pin);
             }
             // mark all inside node as no group
             for (auto node : m_GroupNodes)
             {
-                node->m_GroupID = 0;
-                ed::SetNodeGroupID(node->m_ID, ed::NodeId::Invalid);
-                ed::SetNodeZPosition(node->m_ID, 0);
+                node->SetGroupID(0);
+                Editor::SetNodeGroupID(node->m_ID, 0);
+                Editor::SetNodeZPosition(node->m_ID, 0);
             }
         }
         m_mutex.unlock();
@@ -1294,25 +1333,34 @@ struct GroupNode final : Node
 
         // save group node status and set location to 0,0
         auto& nodesStatus = result["status"];
-        auto GroupStatus = ed::GetState(ed::StateType::Node, m_ID);
-        ImVec2 group_location;
-        edd::Serialization::Parse(GroupStatus["location"], group_location);
-        GroupStatus["location"] = edd::Serialization::ToJson(ImVec2(0, 0));
-        nodesStatus[edd::Serialization::ToString((const ed::NodeId)(IDMaps.at(m_ID)))] = GroupStatus;
+        auto group_location = Editor::GetNodePosition(m_ID);
+        imgui_json::value GroupStatus;
+        GroupStatus["location"] = Vec2ToJson(ImVec2(0, 0));
+        GroupStatus["size"] = Vec2ToJson(Editor::GetNodeSize(m_ID));
+        GroupStatus["group_size"] = Vec2ToJson(Editor::GetGroupSize(m_ID));
+        nodesStatus[NodeStatusKey(IDMaps.at(m_ID))] = GroupStatus;
 
         // save all nodes status and modify location
         for (auto node : m_GroupNodes)
         {
-            auto nodeStatus = ed::GetState(ed::StateType::Node, node->m_ID);
-            ImVec2 node_location;
-            edd::Serialization::Parse(nodeStatus["location"], node_location);
-            node_location -= group_location;
-            nodeStatus["location"] = edd::Serialization::ToJson(node_location);
-            nodesStatus[edd::Serialization::ToString((const ed::NodeId)(IDMaps.at(node->m_ID)))] = nodeStatus;
+            imgui_json::value nodeStatus;
+            nodeStatus["location"] = Vec2ToJson(Editor::GetNodePosition(node->m_ID) - group_location);
+            nodeStatus["size"] = Vec2ToJson(Editor::GetNodeSize(node->m_ID));
+            nodesStatus[NodeStatusKey(IDMaps.at(node->m_ID))] = nodeStatus;
         }
         result.save(path_name);
     }
 
+    // status keys and values follow the node editor's own state layout
+    static std::string NodeStatusKey(ID_TYPE id) { return "node:" + std::to_string(id); }
+    static imgui_json::value Vec2ToJson(const ImVec2& v)
+    {
+        imgui_json::value result;
+        result["x"] = imgui_json::number(v.x);
+        result["y"] = imgui_json::number(v.y);
+        return result;
+    }
+
     inline void GetPinIDMap(const imgui_json::value& pinValue, std::map<ID_TYPE, ID_TYPE>& IDMaps)
     {
         ID_TYPE object_id;
@@ -1414,7 +1462,7 @@ struct GroupNode final : Node
         }
         // Load Group Value
         Load(groupValue);
-        auto GroupStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(m_ID))];
+        auto GroupStatus = statusValue[NodeStatusKey(m_ID)];
         m_ID = GetIDFromMap(m_ID, IDMaps);
         for (auto pin : m_InputBridgePins)
         {
@@ -1433,16 +1481,16 @@ struct GroupNode final : Node
             AdjestPinID(pin, IDMaps);
         }
         // Set group node status
-        auto base_pos = ed::ScreenToCanvas(pos);
-        ed::SetNodePosition(m_ID, base_pos);
+        auto base_pos = Editor::ScreenToCanvas(pos);
+        Editor::SetNodePosition(m_ID, base_pos);
         ImVec2 group_node_size;
         imgui_json::GetTo<imgui_json::number>(GroupStatus["size"], "x", group_node_size.x);
         imgui_json::GetTo<imgui_json::number>(GroupStatus["size"], "y", group_node_size.y);
-        ed::SetNodeSize(m_ID, group_node_size);
+        Editor::SetNodeSize(m_ID, group_node_size);
         ImVec2 group_size;
         imgui_json::GetTo<imgui_json::number>(GroupStatus["group_size"], "x", group_size.x);
         imgui_json::GetTo<imgui_json::number>(GroupStatus["group_size"], "y", group_size.y);
-        ed::SetGroupSize(m_ID, group_size);
+        Editor::SetGroupSize(m_ID, group_size);
 
         // Create Group In-Nodes
         const imgui_json::array* groupNodeArray = nullptr;
@@ -1457,10 +1505,10 @@ struct GroupNode final : Node
                 if (!node)
                     continue;
                 node->Load(nodeValue);
-                auto nodeStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(node->m_ID))];
+                auto nodeStatus = statusValue[NodeStatusKey(node->m_ID)];
                 node->m_ID = GetIDFromMap(node->m_ID, IDMaps);
-                node->m_GroupID = GetIDFromMap(node->m_GroupID, IDMaps);
-                ed::SetNodeGroupID(node->m_ID, node->m_GroupID);
+                node->SetGroupID(GetIDFromMap(node->m_GroupID, IDMaps));
+                Editor::SetNodeGroupID(node->m_ID, node->m_GroupID);
                 for (auto pin : node->GetInputPins())
                 {
                     AdjestPinID(pin, IDMaps);
@@ -1473,11 +1521,11 @@ struct GroupNode final : Node
                 imgui_json::GetTo<imgui_json::number>(nodeStatus["location"], "x", node_location.x);
                 imgui_json::GetTo<imgui_json::number>(nodeStatus["location"], "y", node_location.y);
                 node_location += base_pos;
-                ed::SetNodePosition(node->m_ID, node_location);
+                Editor::SetNodePosition(node->m_ID, node_location);
                 ImVec2 node_size;
                 imgui_json::GetTo<imgui_json::number>(nodeStatus["size"], "x", node_size.x);
                 imgui_json::GetTo<imgui_json::number>(nodeStatus["size"], "y", node_size.y);
-                ed::SetNodeSize(node->m_ID, node_size);
+                Editor::SetNodeSize(node->m_ID, node_size);
                 m_GroupNodes.push_back(node);
             }
         }
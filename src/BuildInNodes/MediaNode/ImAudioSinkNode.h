@@ -0,0 +1,394 @@
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
+#include <imgui_json.h>
+#include <imgui_extra_widget.h>
+#define USE_BOOKMARK
+#include <ImGuiFileDialog.h>
+#include <SPSCRing.h>
+#include <AudioDSP.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <stdio.h>
+
+#define AUDIO_SINK_MAX_BLOCKS   128     // same depth as the SDL render node
+#define AUDIO_SINK_PERIOD_MS    10      // simulated device callback period
+
+namespace BluePrint
+{
+// ======================================================= //
+// ================== Headless audio sink ================ //
+// ======================================================= //
+// Drop in replacement for the SDL audio render node that needs no device. In
+// realtime mode a clock thread consumes the stream at its sample rate, like a
+// device callback would, so Buffer and Tick behave the same; in fast mode
+// every block is consumed as soon as it arrives. Either way the stream can be
+// written to a float WAV or raw f32le file.
+struct AudioSinkNode final : Node
+{
+    BP_NODE_WITH_NAME(AudioSinkNode, "Audio Sink", VERSION_BLUEPRINT, NodeType::Internal, NodeStyle::Default, "Media")
+    AudioSinkNode(BP* blueprint): Node(blueprint) { m_Name = "Audio Sink"; }
+
+    ~AudioSinkNode()
+    {
+        StopClock();
+        CloseOutput();
+    }
+
+    void Reset(Context& context) override
+    {
+        Node::Reset(context);
+        StopClock();
+        CloseOutput();
+        m_samples.Reset(0);
+        m_marks.Reset(0);
+        m_audio_channels = 0;
+        m_audio_sample_rate = 0;
+        m_audio_samples = 0;
+        m_frames_consumed = 0;
+        m_current_pts = NAN;
+        m_buffer_available = true;
+        m_BufferAvailable.SetValue(true);
+        m_Tick.SetValue(m_current_pts.load());
+    }
+
+    void OnPause(Context& context) override { SetPaused(true); }
+    void OnResume(Context& context) override { SetPaused(false); }
+    void OnStop(Context& context) override { SetPaused(true); }
+    void OnStepNext(Context& context) override { SetPaused(false); }
+    void OnStepCurrent(Context& context) override { SetPaused(false); }
+
+    FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
+    {
+        if (entryPoint.m_ID == m_Reset.m_ID)
+        {
+            Reset(context);
+            return m_Exit;
+        }
+        else if (entryPoint.m_ID == m_Enter.m_ID)
+        {
+            auto mat = context.GetPinValue<ImGui::ImMat>(m_Mat);
+            if (!mat.empty())
+            {
+                if (!m_audio_channels)
+                    Open(mat);
+                if (mat.c == m_audio_channels && mat.w > 0)
+                {
+                    AudioInterleaveMat(mat, m_block);
+                    if (m_running_clock == 0)
+                    {
+                        size_t count = (size_t)mat.w * mat.c;
+                        if (m_marks.Writable() > 0 && m_samples.Writable() >= count)
+                        {
+                            AudioMark mark;
+                            mark.m_Pos = m_samples.WritePos();
+                            mark.m_Pts = mat.time_stamp;
+                            m_samples.Write(m_block.data(), count);
+                            m_marks.Push(mark);
+                        }
+                        m_buffer_available = HasRoom();
+                    }
+                    else
+                    {
+                        WriteOutput(m_block.data(), mat.w);
+                        m_frames_consumed += mat.w;
+                        m_current_pts = mat.time_stamp;
+                        m_buffer_available = true;
+                    }
+                    m_BufferAvailable.SetValue(m_buffer_available.load());
+                    m_Tick.SetValue(m_current_pts.load());
+                }
+                mat.release();
+            }
+        }
+        return {};
+    }
+
+    // the clock thread only moves the atomics, readers of the outputs see them here
+    PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
+    {
+        if (pin.m_ID == m_BufferAvailable.m_ID)
+            return m_buffer_available.load();
+        else if (pin.m_ID == m_Tick.m_ID)
+            return m_current_pts.load();
+        else
+            return Node::EvaluatePin(context, pin, threading);
+    }
+
+    void DrawSettingLayout(ImGuiContext * ctx) override
+    {
+        // Draw Setting
+        Node::DrawSettingLayout(ctx);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Clock:"); ImGui::SameLine();
+        ImGui::RadioButton("Realtime", &m_clock, 0); ImGui::SameLine();
+        ImGui::RadioButton("As Fast As Possible", &m_clock, 1);
+        ImGui::TextUnformatted("Output:"); ImGui::SameLine();
+        ImGui::RadioButton("None", &m_output, 0); ImGui::SameLine();
+        ImGui::RadioButton("WAV", &m_output, 1); ImGui::SameLine();
+        ImGui::RadioButton("Raw PCM(f32le)", &m_output, 2);
+        ImGui::BeginDisabled(m_output == 0);
+        ImVec2 minSize = ImVec2(400, 300);
+        ImVec2 maxSize = ImVec2(FLT_MAX, FLT_MAX);
+        ImGuiFileDialogFlags vflags = ImGuiFileDialogFlags_ConfirmOverwrite | ImGuiFileDialogFlags_CaseInsensitiveExtention | ImGuiFileDialogFlags_Modal;
+        if (ImGui::Button(ICON_IGFD_FOLDER_OPEN " Output File"))
+            ImGuiFileDialog::Instance()->OpenDialog("##NodeAudioSinkDlgKey", "Output File",
+                                                    m_output == 1 ? ".wav" : ".pcm,.raw",
+                                                    m_output_path.empty() ? "." : m_output_path,
+                                                    1, this, vflags);
+        ImGui::SameLine(0);
+        ImGui::TextUnformatted(m_output_path.c_str());
+        ImGui::EndDisabled();
+        ImGui::TextUnformatted("Clock and output apply from the next reset");
+        if (ImGuiFileDialog::Instance()->Display("##NodeAudioSinkDlgKey", ImGuiWindowFlags_NoCollapse, minSize, maxSize))
+        {
+            if (ImGuiFileDialog::Instance()->IsOk() == true)
+                m_output_path = ImGuiFileDialog::Instance()->GetFilePathName();
+            ImGuiFileDialog::Instance()->Close();
+        }
+    }
+
+    bool CustomLayout() const override { return true; }
+
+    bool DrawCustomLayout(ImGuiContext * ctx, float zoom, ImVec2 origin, ImGui::ImCurveEdit::keys * key) override
+    {
+        ImGui::SetCurrentContext(ctx);
+        double seconds = m_audio_sample_rate > 0 ? (double)m_frames_consumed.load() / m_audio_sample_rate : 0;
+        ImGui::Text("%s %dch %dHz", m_clock == 0 ? "Realtime" : "Fast", m_audio_channels, m_audio_sample_rate);
+        ImGui::Text("Consumed %.2fs", seconds);
+        return false;
+    }
+
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
+    int Load(const imgui_json::value& value) override
+    {
+        int ret = BP_ERR_NONE;
+        if ((ret = Node::Load(value)) != BP_ERR_NONE)
+            return ret;
+        if (value.contains("clock"))
+        {
+            auto& val = value["clock"];
+            if (val.is_number())
+                m_clock = val.get<imgui_json::number>();
+        }
+        if (value.contains("output"))
+        {
+            auto& val = value["output"];
+            if (val.is_number())
+                m_output = val.get<imgui_json::number>();
+        }
+        if (value.contains("output_path"))
+        {
+            auto& val = value["output_path"];
+            if (val.is_string())
+                m_output_path = val.get<imgui_json::string>();
+        }
+        return ret;
+    }
+
+    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) override
+    {
+        Node::Save(value, MapID);
+        value["clock"] = imgui_json::number(m_clock);
+        value["output"] = imgui_json::number(m_output);
+        value["output_path"] = m_output_path;
+    }
+
+    span<Pin*> GetInputPins() override { return m_InputPins; }
+    span<Pin*> GetOutputPins() override { return m_OutputPins; }
+
+    FlowPin   m_Enter   = { this, "Enter" };
+    FlowPin   m_Reset   = { this, "Reset" };
+    MatPin    m_Mat     = { this, "Mat" };
+    FlowPin   m_Exit    = { this, "Exit" };
+    BoolPin   m_BufferAvailable = { this, "Buffer", true };
+    DoublePin m_Tick    = { this, "Tick" };
+
+    Pin* m_InputPins[3] = { &m_Enter, &m_Reset, &m_Mat };
+    Pin* m_OutputPins[3] = { &m_Exit, &m_BufferAvailable, &m_Tick };
+
+private:
+    struct AudioMark
+    {
+        size_t m_Pos {0};
+        double m_Pts {NAN};
+    };
+
+    // first block fixes the stream format, the clock and the output file
+    void Open(const ImGui::ImMat& mat)
+    {
+        m_audio_channels = mat.c;
+        m_audio_sample_rate = mat.rate.num > 0 ? mat.rate.num : 44100;
+        m_audio_samples = mat.w;
+        m_running_clock = m_clock;
+        OpenOutput();
+        if (m_running_clock == 0)
+        {
+            m_samples.Reset((size_t)AUDIO_SINK_MAX_BLOCKS * m_audio_samples * m_audio_channels);
+            m_marks.Reset(AUDIO_SINK_MAX_BLOCKS);
+            m_period_frames = std::max(1, m_audio_sample_rate * AUDIO_SINK_PERIOD_MS / 1000);
+            m_chunk.resize((size_t)m_period_frames * m_audio_channels);
+            m_quit = false;
+            m_paused = false;
+            m_clock_thread = std::thread(&AudioSinkNode::ClockThread, this);
+        }
+    }
+
+    bool HasRoom() const
+    {
+        return m_marks.Writable() > 0 && m_samples.Writable() >= (size_t)m_audio_samples * m_audio_channels;
+    }
+
+    // ---[ Realtime clock ]---
+    void ClockThread()
+    {
+        auto period = std::chrono::microseconds((int64_t)m_period_frames * 1000000 / m_audio_sample_rate);
+        auto deadline = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(m_clock_mutex);
+        while (!m_quit)
+        {
+            if (m_paused)
+            {
+                m_clock_cond.wait(lock, [&] { return m_quit || !m_paused; });
+                deadline = std::chrono::steady_clock::now();
+                continue;
+            }
+            deadline += period;
+            if (m_clock_cond.wait_until(lock, deadline, [&] { return m_quit || m_paused; }))
+                continue;
+            lock.unlock();
+            Consume();
+            lock.lock();
+        }
+    }
+
+    // one simulated device period, the ring consumer side, same as the SDL callback
+    void Consume()
+    {
+        int channels = m_audio_channels;
+        size_t read_pos = m_samples.ReadPos();
+        const AudioMark* mark = nullptr;
+        while ((mark = m_marks.Peek(1)) && mark->m_Pos <= read_pos)
+            m_marks.Pop();
+        if ((mark = m_marks.Peek(0)) && mark->m_Pos <= read_pos)
+            m_current_pts = mark->m_Pts + (double)((read_pos - mark->m_Pos) / channels) / m_audio_sample_rate;
+        size_t got = m_samples.Read(m_chunk.data(), m_chunk.size());
+        // an underrun plays silence on a device, the file only gets what arrived
+        WriteOutput(m_chunk.data(), (int)(got / channels));
+        m_frames_consumed += got / channels;
+        m_buffer_available = HasRoom();
+    }
+
+    void SetPaused(bool paused)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_clock_mutex);
+            m_paused = paused;
+        }
+        m_clock_cond.notify_all();
+    }
+
+    void StopClock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_clock_mutex);
+            m_quit = true;
+        }
+        m_clock_cond.notify_all();
+        if (m_clock_thread.joinable()) m_clock_thread.join();
+    }
+
+    // ---[ File output ]---
+    static void PutLE(FILE* fp, uint32_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+            fputc((value >> (i * 8)) & 0xFF, fp);
+    }
+
+    // 32 bit IEEE float WAV header, rewritten with the final size on close
+    void WriteWavHeader()
+    {
+        uint32_t data_bytes = (uint32_t)std::min<uint64_t>(m_output_bytes, 0xFFFFFFFFu - 36);
+        fseek(m_output_file, 0, SEEK_SET);
+        fwrite("RIFF", 1, 4, m_output_file);
+        PutLE(m_output_file, 36 + data_bytes, 4);
+        fwrite("WAVEfmt ", 1, 8, m_output_file);
+        PutLE(m_output_file, 16, 4);
+        PutLE(m_output_file, 3, 2);     // WAVE_FORMAT_IEEE_FLOAT
+        PutLE(m_output_file, m_audio_channels, 2);
+        PutLE(m_output_file, m_audio_sample_rate, 4);
+        PutLE(m_output_file, m_audio_sample_rate * m_audio_channels * sizeof(float), 4);
+        PutLE(m_output_file, m_audio_channels * sizeof(float), 2);
+        PutLE(m_output_file, 32, 2);
+        fwrite("data", 1, 4, m_output_file);
+        PutLE(m_output_file, data_bytes, 4);
+    }
+
+    void OpenOutput()
+    {
+        if (m_output == 0 || m_output_path.empty())
+            return;
+        m_output_file = fopen(m_output_path.c_str(), "wb");
+        if (!m_output_file)
+        {
+            fprintf(stderr, "Can't open audio sink output %s\n", m_output_path.c_str());
+            return;
+        }
+        m_output_bytes = 0;
+        m_output_wav = m_output == 1;
+        if (m_output_wav)
+            WriteWavHeader();
+    }
+
+    void WriteOutput(const float* data, int frames)
+    {
+        if (!m_output_file || frames <= 0)
+            return;
+        m_output_bytes += fwrite(data, sizeof(float), (size_t)frames * m_audio_channels, m_output_file) * sizeof(float);
+    }
+
+    void CloseOutput()
+    {
+        if (!m_output_file)
+            return;
+        if (m_output_wav)
+            WriteWavHeader();
+        fclose(m_output_file);
+        m_output_file = nullptr;
+    }
+
+    int m_clock {0};                // 0 = realtime 1 = as fast as possible
+    int m_output {0};               // 0 = none 1 = wav 2 = raw f32le
+    std::string m_output_path;
+
+    int m_running_clock {0};
+    int m_audio_channels {0};
+    int m_audio_sample_rate {0};
+    int m_audio_samples {0};
+    int m_period_frames {0};
+    // written by the clock thread in realtime mode
+    std::atomic<double> m_current_pts {NAN};
+    std::atomic<uint64_t> m_frames_consumed {0};
+    std::atomic<bool> m_buffer_available {true};
+    std::vector<float> m_block;     // producer scratch, one interleaved block
+    std::vector<float> m_chunk;     // consumer scratch, one period
+
+    // Execute produces, the clock thread consumes
+    SPSCRing<float>     m_samples;
+    SPSCRing<AudioMark> m_marks;
+    std::thread         m_clock_thread;
+    std::mutex          m_clock_mutex;
+    std::condition_variable m_clock_cond;
+    bool                m_quit {false};
+    bool                m_paused {false};
+
+    FILE*               m_output_file {nullptr};
+    uint64_t            m_output_bytes {0};
+    bool                m_output_wav {false};
+};
+} // namespace BluePrint
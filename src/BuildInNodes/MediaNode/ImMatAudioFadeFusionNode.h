@@ -1,6 +1,9 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
+#include <AudioDSP.h>
 
 namespace BluePrint
 {
@@ -18,6 +21,7 @@ struct AudioFadeNode final : Node
         Node::Reset(context);
         m_mutex.lock();
         m_MatOut.SetValue(ImGui::ImMat());
+        m_last_fade = NAN;
         m_mutex.unlock();
     }
 
@@ -25,23 +29,54 @@ struct AudioFadeNode final : Node
     {
         auto mat_first = context.GetPinValue<ImGui::ImMat>(m_MatInFirst);
         auto mat_second = context.GetPinValue<ImGui::ImMat>(m_MatInSecond);
-        float fade = 1.0f - context.GetPinValue<float>(m_FadeIn);
+        float fade = context.GetPinValue<float>(m_FadeIn);   // weight of the second input
         if (!mat_first.empty() && !mat_second.empty())
         {
-            if (!m_Enabled)
+            if (!m_Enabled || mat_first.w != mat_second.w || mat_first.c != mat_second.c)
             {
                 m_MatOut.SetValue(mat_first);
                 return m_Exit;
             }
-            ImGui::ImMat im_mat;
-            im_mat = mat_first * fade + mat_second * (1 - fade);
-            im_mat.clip(-1.f, 1.f);
+            ImGui::ImMat im_mat = AudioWritableMat(mat_first);
+            ImGui::ImMat second = mat_second.type == IM_DT_FLOAT32 ? mat_second : AudioWritableMat(mat_second);
+            float from = isnan(m_last_fade) ? fade : m_last_fade;
+            Crossfade(im_mat, second, from, fade);
+            m_last_fade = fade;
             im_mat.copy_attribute(mat_first);
             m_MatOut.SetValue(im_mat);
         }
         return m_Exit;
     }
 
+    // out = first faded into second in place, second brought to the layout of out first
+    void Crossfade(ImGui::ImMat& out, ImGui::ImMat& second, float from, float to)
+    {
+        size_t frames = out.w;
+        int channels = out.c;
+        bool planar = AudioChannelPointers(out, m_first) == 1;
+        bool second_planar = AudioChannelPointers(second, m_second) == 1;
+        if (planar && !second_planar)
+        {
+            m_scratch.resize(frames * channels);
+            for (int c = 0; c < channels; c++)
+                m_second[c] = m_scratch.data() + frames * c;
+            AudioDeinterleave(m_second.data(), (const float*)second.data, channels, frames);
+        }
+        else if (!planar && second_planar)
+        {
+            m_scratch.resize(frames * channels);
+            AudioInterleave(m_scratch.data(), m_second.data(), channels, frames);
+            m_second.assign(1, m_scratch.data());
+        }
+        if (planar)
+        {
+            for (int c = 0; c < channels; c++)
+                AudioCrossfade(m_first[c], m_first[c], m_second[c], frames, from, to, (AudioFadeCurve)m_curve, true);
+        }
+        else
+            AudioCrossfade((float*)out.data, (const float*)out.data, m_second[0], frames * channels, from, to, (AudioFadeCurve)m_curve, true);
+    }
+
     void DrawSettingLayout(ImGuiContext * ctx) override
     {
         // Draw Setting
@@ -53,11 +88,16 @@ struct AudioFadeNode final : Node
         ImGui::RadioButton("Int16", (int *)&m_mat_data_type, (int)IM_DT_INT16); ImGui::SameLine();
         ImGui::RadioButton("Float16", (int *)&m_mat_data_type, (int)IM_DT_FLOAT16); ImGui::SameLine();
         ImGui::RadioButton("Float32", (int *)&m_mat_data_type, (int)IM_DT_FLOAT32);
+        ImGui::TextUnformatted("Fade Curve:"); ImGui::SameLine();
+        ImGui::RadioButton("Linear", &m_curve, (int)AudioFadeCurve::Linear); ImGui::SameLine();
+        ImGui::RadioButton("Equal Power", &m_curve, (int)AudioFadeCurve::EqualPower);
     }
 
     bool CustomLayout() const override { return false; }
     bool Skippable() const override { return true; }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -70,6 +110,14 @@ struct AudioFadeNode final : Node
             if (val.is_number()) 
                 m_mat_data_type = (ImDataType)val.get<imgui_json::number>();
         }
+        if (value.contains("fade_curve"))
+        {
+            auto& val = value["fade_curve"];
+            if (val.is_number()) 
+                m_curve = val.get<imgui_json::number>();
+        }
+        else
+            m_curve = (int)AudioFadeCurve::Linear; // documents saved before the option faded linearly
         return ret;
     }
 
@@ -77,6 +125,7 @@ struct AudioFadeNode final : Node
     {
         Node::Save(value, MapID);
         value["mat_type"] = imgui_json::number(m_mat_data_type);
+        value["fade_curve"] = imgui_json::number(m_curve);
     }
 
     void DrawNodeLogo(ImGuiContext * ctx, ImVec2 size) const override
@@ -117,5 +166,10 @@ struct AudioFadeNode final : Node
 private:
     ImDataType m_mat_data_type {IM_DT_UNDEFINED};
     int m_device        {-1};
+    int m_curve         {(int)AudioFadeCurve::Linear};
+    float m_last_fade   {NAN};
+    std::vector<float*> m_first;
+    std::vector<float*> m_second;
+    std::vector<float> m_scratch;
 };
 } // namespace BluePrint
@@ -1,6 +1,9 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
+#include <AudioDSP.h>
 
 namespace BluePrint
 {
@@ -18,6 +21,7 @@ struct AudioGainNode final : Node
         Node::Reset(context);
         m_mutex.lock();
         m_MatOut.SetValue(ImGui::ImMat());
+        m_last_gain = NAN;
         m_mutex.unlock();
     }
 
@@ -35,9 +39,17 @@ struct AudioGainNode final : Node
                 m_MatOut.SetValue(mat_in);
                 return m_Exit;
             }
-            ImGui::ImMat im_mat;
-            im_mat = mat_in * m_gain;
-            im_mat.clip(-1.f, 1.f);
+            // ramp from the gain of the previous block, clipped in the same pass
+            ImGui::ImMat im_mat = AudioWritableMat(mat_in);
+            float from = isnan(m_last_gain) ? m_gain : m_last_gain;
+            if (AudioChannelPointers(im_mat, m_channels) == 1)
+            {
+                for (auto channel : m_channels)
+                    AudioGain(channel, im_mat.w, from, m_gain, true);
+            }
+            else
+                AudioGain((float*)im_mat.data, (size_t)im_mat.w * im_mat.c, from, m_gain, true);
+            m_last_gain = m_gain;
             im_mat.copy_attribute(mat_in);
             m_MatOut.SetValue(im_mat);
         }
@@ -86,6 +98,8 @@ struct AudioGainNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -152,5 +166,7 @@ private:
     ImDataType m_mat_data_type {IM_DT_UNDEFINED};
     int m_device        {-1};
     float m_gain        {1.0f};
+    float m_last_gain   {NAN};
+    std::vector<float*> m_channels;
 };
 } // namespace BluePrint
@@ -18,12 +18,22 @@
 #endif
 #define USE_BOOKMARK
 #include <ImGuiFileDialog.h>
+#include <atomic>
+
+#define PREVIEW_HIDDEN_MS   250     // no draw for this long and Execute stops converting
 
-namespace ed = ax::NodeEditor;
 namespace BluePrint
 {
 struct MatRenderNode final : Node
 {
+    struct RenderSlot
+    {
+        ImGui::ImMat m_Mat;     // RGBA8 for video, as received for audio
+#if IMGUI_VULKAN_SHADER && IMGUI_RENDERING_VULKAN
+        ImGui::VkMat m_VkMat;
+#endif
+    };
+
     BP_NODE_WITH_NAME(MatRenderNode, "Media Render", VERSION_BLUEPRINT, NodeType::Internal, NodeStyle::Default, "Media")
     MatRenderNode(BP* blueprint): Node(blueprint) { m_Name = "Mat Render"; }
     ~MatRenderNode()
@@ -39,14 +49,16 @@ struct MatRenderNode final : Node
     void Reset(Context& context) override
     {
         Node::Reset(context);
-        if (m_textureID) { ImGui::ImDestroyTexture(m_textureID); m_textureID = 0; }
-        m_RenderMat = ImGui::ImMat();
 #if IMGUI_VULKAN_SHADER
         if (m_convert) { delete m_convert; m_convert = nullptr; }
         m_RenderVkMat = ImGui::VkMat();
 #endif
-        m_image_width = 0;
-        m_image_height = 0;
+        // the texture belongs to the UI thread, it drops it on the next draw
+        std::lock_guard<std::mutex> lock(m_slot_mutex);
+        for (auto& slot : m_slots)
+            slot = RenderSlot();
+        m_fresh = false;
+        m_clear = true;
     }
 
     void OnClose(Context& context) override
@@ -56,74 +68,145 @@ struct MatRenderNode final : Node
         m_mutex.unlock();
     }
 
-#if IMGUI_VULKAN_SHADER
-    void GeneratorTexture(ImGui::VkMat & mat)
+    // ---[ Producer, graph thread ]---
+    template<typename T>
+    static void Detach(T& mat)
     {
-        if (!mat.empty())
-        {
-#if !IMGUI_RENDERING_VULKAN
-            ImGui::ImMat cpu_mat;
-            ImGui::ImVulkanVkMatToImMat(mat, cpu_mat);
-            ImGui::ImGenerateOrUpdateTexture(m_textureID, cpu_mat.w, cpu_mat.h, cpu_mat.c, (const unsigned char *)cpu_mat.data);
-#else
-            ImGui::ImGenerateOrUpdateTexture(m_textureID, mat.w, mat.h, mat.c, (const unsigned char *)&mat, true);
-#endif
-        }
+        // the UI may still hold the buffer of a slot it took earlier, convert into a new one then
+        if (mat.refcount && *mat.refcount > 1)
+            mat = T();
     }
-#endif
 
-    void GeneratorTexture(ImGui::ImMat & mat)
+    bool IsPreviewVisible() const
     {
-        if (!mat.empty())
+        uint64_t last = m_last_visible.load(std::memory_order_relaxed);
+        return ImGui::get_current_time_msec() - last < PREVIEW_HIDDEN_MS;
+    }
+
+    // RGBA8 copy of a video frame the UI uploads as is, called with m_mutex held
+    bool ConvertFrame(ImGui::ImMat& mat, RenderSlot& slot)
+    {
+#if IMGUI_VULKAN_SHADER
+        if (!m_convert)
+        {
+            int gpu = mat.device == IM_DD_VULKAN ? mat.device_number : ImGui::get_default_gpu_index();
+            m_convert = new ImGui::ColorConvert_vulkan(gpu);
+            if (!m_convert)
+                return false;
+        }
+#if IMGUI_RENDERING_VULKAN
+        ImGui::VkMat& out = slot.m_VkMat;   // the UI samples it without a readback
+        Detach(out);
+        slot.m_Mat = ImGui::ImMat();
+#else
+        ImGui::VkMat& out = m_RenderVkMat;
+#endif
+        if (mat.device == IM_DD_VULKAN)
         {
             if (mat.c == 1)
             {
-#if IMGUI_VULKAN_SHADER
-                ImGui::ImGenerateOrUpdateTexture(m_textureID, mat.w, mat.h, mat.c, (const unsigned char *)mat.data);
-#else
-                ImGui::ImMat im_RGB(mat.w, mat.h, 4, 1u, 4);
-                for (int y = 0; y < mat.h; y++)
+                int video_depth = mat.type == IM_DT_INT8 ? 8 : mat.type == IM_DT_INT16 ? 16 : 8;
+                int video_shift = mat.depth != 0 ? mat.depth : mat.type == IM_DT_INT8 ? 8 : mat.type == IM_DT_INT16 ? 16 : 8;
+                if (mat.flags & IM_MAT_FLAGS_VIDEO_FRAME_UV)
+                    mat.color_format = IM_CF_NV12;
+                ImGui::VkMat in_mat = mat;
+                out.type = IM_DT_INT8;
+                m_convert->GRAY2RGBA(in_mat, out, mat.color_space, mat.color_range, video_depth, video_shift);
+            }
+            else if (mat.c == 2)
+            {
+                out.type = IM_DT_INT8;
+                m_convert->ConvertColorFormat(mat, out);
+            }
+            else if (mat.c == 3)
+            {
+                out.type = IM_DT_INT8;
+                if (IM_ISYUV(mat.color_format))
+                    m_convert->ConvertColorFormat(mat, out);
+                else
                 {
-                    for (int x = 0; x < mat.w; x++)
-                    {
-                        unsigned char val = 0;
-                        int planer = mat.flags == 0 ? x : x % 2 == 0 ? x / 2 : x / 2 + mat.w / 2;
-                        if (mat.depth > 8)
-                        {
-                            auto val16 = mat.at<unsigned short>(x, y);
-                            val = val16 >> 8;
-                        }
-                        else
-                            val = mat.at<unsigned char>(x, y);
-                        im_RGB.at<unsigned char>(planer, y, 0) =
-                        im_RGB.at<unsigned char>(planer, y, 1) =
-                        im_RGB.at<unsigned char>(planer, y, 2) = val;
-                        im_RGB.at<unsigned char>(planer, y, 3) = 0xFF;
-                    }
+                    ImGui::VkMat in_mat = mat;
+                    m_convert->Conv(in_mat, out);
                 }
-                ImGui::ImGenerateOrUpdateTexture(m_textureID, im_RGB.w, im_RGB.h, im_RGB.c, (const unsigned char *)im_RGB.data);
-#endif
             }
-            else if (mat.c == 3)
+            else
             {
-                ImGui::ImMat im_RGB(mat.w, mat.h, 4, 1u, 4);
-                for (int y = 0; y < mat.h; y++)
+                if (mat.type == IM_DT_INT8)
+                    out = mat;
+                else
                 {
-                    for (int x = 0; x < mat.w; x++)
+                    ImGui::VkMat in_mat = mat;
+                    out.type = IM_DT_INT8;
+                    m_convert->Conv(in_mat, out);
+                }
+            }
+        }
+        else
+        {
+            out.type = IM_DT_INT8;
+            m_convert->ConvertColorFormat(mat, out);
+        }
+#if !IMGUI_RENDERING_VULKAN
+        Detach(slot.m_Mat);
+        ImGui::ImVulkanVkMatToImMat(out, slot.m_Mat);
+#endif
+#else
+        if (mat.c == 4)
+        {
+            slot.m_Mat = mat;
+            return true;
+        }
+        if (mat.c != 1 && mat.c != 3)
+            return false;
+        Detach(slot.m_Mat);
+        ImGui::ImMat& im_RGB = slot.m_Mat;
+        im_RGB.create(mat.w, mat.h, 4, 1u, 4);
+        if (mat.c == 1)
+        {
+            for (int y = 0; y < mat.h; y++)
+            {
+                for (int x = 0; x < mat.w; x++)
+                {
+                    unsigned char val = 0;
+                    int planer = mat.flags == 0 ? x : x % 2 == 0 ? x / 2 : x / 2 + mat.w / 2;
+                    if (mat.depth > 8)
                     {
-                        im_RGB.at<unsigned char>(x, y, 0) = mat.at<unsigned char>(x, y, 0);
-                        im_RGB.at<unsigned char>(x, y, 1) = mat.at<unsigned char>(x, y, 1);
-                        im_RGB.at<unsigned char>(x, y, 2) = mat.at<unsigned char>(x, y, 2);
-                        im_RGB.at<unsigned char>(x, y, 3) = 0xFF;
+                        auto val16 = mat.at<unsigned short>(x, y);
+                        val = val16 >> 8;
                     }
+                    else
+                        val = mat.at<unsigned char>(x, y);
+                    im_RGB.at<unsigned char>(planer, y, 0) =
+                    im_RGB.at<unsigned char>(planer, y, 1) =
+                    im_RGB.at<unsigned char>(planer, y, 2) = val;
+                    im_RGB.at<unsigned char>(planer, y, 3) = 0xFF;
                 }
-                ImGui::ImGenerateOrUpdateTexture(m_textureID, im_RGB.w, im_RGB.h, im_RGB.c, (const unsigned char *)im_RGB.data);
             }
-            else if (mat.c == 4)
+        }
+        else
+        {
+            for (int y = 0; y < mat.h; y++)
             {
-                ImGui::ImGenerateOrUpdateTexture(m_textureID, mat.w, mat.h, mat.c, (const unsigned char *)mat.data);
+                for (int x = 0; x < mat.w; x++)
+                {
+                    im_RGB.at<unsigned char>(x, y, 0) = mat.at<unsigned char>(x, y, 0);
+                    im_RGB.at<unsigned char>(x, y, 1) = mat.at<unsigned char>(x, y, 1);
+                    im_RGB.at<unsigned char>(x, y, 2) = mat.at<unsigned char>(x, y, 2);
+                    im_RGB.at<unsigned char>(x, y, 3) = 0xFF;
+                }
             }
         }
+#endif
+        return true;
+    }
+
+    // the back slot becomes the newest frame, an earlier one the UI never took is overwritten
+    void Publish()
+    {
+        std::lock_guard<std::mutex> lock(m_slot_mutex);
+        m_front = m_back;
+        m_back ^= 1;
+        m_fresh = true;
     }
 
     FlowPin Execute(Context& context, FlowPin& entryPoint, bool threading = false) override
@@ -136,82 +219,71 @@ struct MatRenderNode final : Node
         else if (entryPoint.m_ID == m_Enter.m_ID)
         {
             auto mat = context.GetPinValue<ImGui::ImMat>(m_Mat);
-            if (!mat.empty() && mat.flags & IM_MAT_FLAGS_VIDEO_FRAME)
+            if (mat.empty() || !IsPreviewVisible())
+                return m_Exit;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            RenderSlot& slot = m_slots[m_back];     // only Publish moves m_back, the UI never reads it
+            if (mat.flags & IM_MAT_FLAGS_VIDEO_FRAME)
             {
-                m_mutex.lock();
-#if IMGUI_VULKAN_SHADER
-                if (!m_convert)
-                {
-                    int gpu = mat.device == IM_DD_VULKAN ? mat.device_number : ImGui::get_default_gpu_index();
-                    m_convert = new ImGui::ColorConvert_vulkan(gpu);
-                    if (!m_convert)
-                    {
-                        m_mutex.unlock();
-                        return {};
-                    }
-                }
-#endif
-                m_image_width = mat.w;
-                m_image_height = mat.h;
-#if IMGUI_VULKAN_SHADER
-                if (mat.device == IM_DD_VULKAN)
-                {
-                    if (mat.c == 1)
-                    {
-                        int video_depth = mat.type == IM_DT_INT8 ? 8 : mat.type == IM_DT_INT16 ? 16 : 8;
-                        int video_shift = mat.depth != 0 ? mat.depth : mat.type == IM_DT_INT8 ? 8 : mat.type == IM_DT_INT16 ? 16 : 8;
-                        if (mat.flags & IM_MAT_FLAGS_VIDEO_FRAME_UV)
-                            mat.color_format = IM_CF_NV12;
-                        ImGui::VkMat in_mat = mat;
-                        m_RenderVkMat.type = IM_DT_INT8;
-                        m_convert->GRAY2RGBA(in_mat, m_RenderVkMat, mat.color_space, mat.color_range, video_depth, video_shift);
-                    }
-                    else if (mat.c == 2)
-                    {
-                        m_RenderVkMat.type = IM_DT_INT8;
-                        m_convert->ConvertColorFormat(mat, m_RenderVkMat);
-                    }
-                    else if (mat.c == 3)
-                    {
-                        m_RenderVkMat.type = IM_DT_INT8;
-                        if (IM_ISYUV(mat.color_format))
-                            m_convert->ConvertColorFormat(mat, m_RenderVkMat);
-                        else
-                        {
-                            ImGui::VkMat in_mat = mat;
-                            m_convert->Conv(in_mat, m_RenderVkMat);
-                        }
-                    }
-                    else
-                    {
-                        if (mat.type == IM_DT_INT8)
-                            m_RenderVkMat = mat;
-                        else
-                        {
-                            ImGui::VkMat in_mat = mat;
-                            m_RenderVkMat.type = IM_DT_INT8;
-                            m_convert->Conv(in_mat, m_RenderVkMat);
-                        }
-                    }
-                }
-                else
-                {
-                    m_RenderVkMat.type = IM_DT_INT8;
-                    m_convert->ConvertColorFormat(mat, m_RenderVkMat);
-                }
-#else
-                m_RenderMat = mat; // TODO::Dicky Software convert?
-#endif
-                m_mutex.unlock();
+                slot.m_Mat.flags = 0;
+                if (!ConvertFrame(mat, slot))
+                    return {};
+                Publish();
             }
-            else if (!mat.empty() && mat.flags & IM_MAT_FLAGS_AUDIO_FRAME)
+            else if (mat.flags & IM_MAT_FLAGS_AUDIO_FRAME)
             {
-                m_RenderMat = mat;
+                slot = RenderSlot();
+                slot.m_Mat = mat;
+                Publish();
             }
         }
         return m_Exit;
     }
 
+    // ---[ Consumer, UI thread ]---
+    // newest published frame, sharing its buffers
+    bool TakeFrame(RenderSlot& frame)
+    {
+        std::lock_guard<std::mutex> lock(m_slot_mutex);
+        if (m_clear)
+        {
+            if (m_textureID) { ImGui::ImDestroyTexture(m_textureID); m_textureID = 0; }
+            m_RenderMat = ImGui::ImMat();
+            m_image_width = 0;
+            m_image_height = 0;
+            m_clear = false;
+        }
+        if (!m_fresh)
+            return false;
+        frame = m_slots[m_front];
+        m_fresh = false;
+        return true;
+    }
+
+    void UploadFrame(RenderSlot& frame)
+    {
+#if IMGUI_VULKAN_SHADER && IMGUI_RENDERING_VULKAN
+        if (!frame.m_VkMat.empty())
+        {
+            m_image_width = frame.m_VkMat.w;
+            m_image_height = frame.m_VkMat.h;
+            ImGui::ImGenerateOrUpdateTexture(m_textureID, frame.m_VkMat.w, frame.m_VkMat.h, frame.m_VkMat.c, (const unsigned char *)&frame.m_VkMat, true);
+            return;
+        }
+#endif
+        auto& mat = frame.m_Mat;
+        if (mat.empty())
+            return;
+        if (mat.flags & IM_MAT_FLAGS_AUDIO_FRAME)
+        {
+            m_RenderMat = mat;
+            return;
+        }
+        m_image_width = mat.w;
+        m_image_height = mat.h;
+        ImGui::ImGenerateOrUpdateTexture(m_textureID, mat.w, mat.h, mat.c, (const unsigned char *)mat.data);
+    }
+
     void DrawSettingLayout(ImGuiContext * ctx) override
     {
         // Draw Setting
@@ -286,19 +358,11 @@ struct MatRenderNode final : Node
     bool DrawCustomLayout(ImGuiContext * ctx, float zoom, ImVec2 origin, ImGui::ImCurveEdit::keys * key) override
     {
         ImGui::SetCurrentContext(ctx);
-        m_mutex.lock();
-#if IMGUI_VULKAN_SHADER
-        if (!m_RenderVkMat.empty())
-        {
-            GeneratorTexture(m_RenderVkMat);
-        }
-        else 
-#endif
-        if (!m_RenderMat.empty())
-        {
-            if (m_RenderMat.flags & IM_MAT_FLAGS_VIDEO_FRAME)
-                GeneratorTexture(m_RenderMat);
-        }
+        if (ImGui::IsRectVisible(ImVec2(m_preview_width, m_preview_height)))
+            m_last_visible.store(ImGui::get_current_time_msec(), std::memory_order_relaxed);
+        RenderSlot frame;
+        if (TakeFrame(frame))
+            UploadFrame(frame);     // frame goes out of scope here, the producer can reuse its buffers
         if (m_textureID)
         {
             ImGuiIO& io = ImGui::GetIO();
@@ -323,7 +387,7 @@ struct MatRenderNode final : Node
                 else if (region_x > m_image_width - region_sz) { region_x = m_image_width - region_sz; }
                 if (region_y < 0.0f) { region_y = 0.0f; }
                 else if (region_y > m_image_height - region_sz) { region_y = m_image_height - region_sz; }
-                ed::Suspend();
+                Editor::Suspend();
                 if (ImGui::BeginTooltip())
                 {
                     ImGui::SameLine();
@@ -340,7 +404,7 @@ struct MatRenderNode final : Node
                     ImGui::EndChild();
                     ImGui::EndTooltip();
                 }
-                ed::Resume();
+                Editor::Resume();
             }
         }
         else
@@ -383,7 +447,6 @@ struct MatRenderNode final : Node
             else
                 ImGui::Dummy(ImVec2(m_preview_width,m_preview_height));
         }
-        m_mutex.unlock();
         return false;
     }
 
@@ -478,10 +541,21 @@ struct MatRenderNode final : Node
     std::string m_bookmark {""};
     bool m_isShowBookmark {false};
     bool m_isShowHiddenFiles {true};
-    std::mutex m_mutex;
-    ImGui::ImMat m_RenderMat;
+    std::mutex m_mutex;             // conversion state, never taken by the UI
+    ImGui::ImMat m_RenderMat;       // UI side, last audio frame for the waves
 #if IMGUI_VULKAN_SHADER
-    ImGui::VkMat m_RenderVkMat;
+    ImGui::VkMat m_RenderVkMat;     // GPU conversion target before the readback
 #endif
+
+    // Two slot mailbox: Execute converts into the back slot and publishes it,
+    // the UI takes the newest one and uploads it. Neither waits on the other
+    // for longer than swapping the indices.
+    RenderSlot m_slots[2];
+    int m_front {1};
+    int m_back {0};
+    bool m_fresh {false};           // front holds a frame the UI hasn't taken
+    bool m_clear {false};           // Reset ran, the UI drops its texture
+    std::mutex m_slot_mutex;
+    std::atomic<uint64_t> m_last_visible {0};
 };
 } // namespace BluePrint
@@ -1,8 +1,20 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <immat.h>
+#define USE_BOOKMARK
 #include <ImGuiFileDialog.h>
+#include <YUVConvert.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <sys/stat.h>
 #ifdef SDK_WITH_FFMPEG
 #ifdef __cplusplus
 extern "C" {
@@ -67,6 +79,15 @@ extern "C" {
     format == AV_PIX_FMT_NV42 || \
     format == AV_PIX_FMT_NV20)
 
+#define MEDIA_QUEUE_DEPTH       8                   // default decoded frames kept ahead per stream
+#define MEDIA_QUEUE_MEMORY      256                 // default cap of all decoded frames, in MB
+#define MEDIA_PACKET_BYTES      (15 * 1024 * 1024)  // demuxer stops reading ahead beyond this
+#define MEDIA_PACKET_DEPTH      25                  // or once every stream has this many packets
+#define MEDIA_WAIT_MS           20
+#define MEDIA_INDEX_EXTENSION   ".bpidx"            // keyframe index cache in the user cache dir
+#define MEDIA_INDEX_VERSION     1
+#define MEDIA_TIME_EPSILON      1e-6                // seconds, absorbs time base rounding
+
 static inline std::string PrintTimeStamp(double time_stamp)
 {
     char buffer[1024] = {0};
@@ -83,13 +104,13 @@ static inline std::string PrintTimeStamp(double time_stamp)
     return std::string(buffer);
 }
 
-static enum AVPixelFormat  m_hw_pix_fmt {AV_PIX_FMT_NONE};
-static enum AVHWDeviceType m_hw_type {AV_HWDEVICE_TYPE_NONE};
+// ctx->opaque points to the hw pixel format chosen for this decoder by open_codec_context
 static enum AVPixelFormat get_hw_format(AVCodecContext *ctx, const enum AVPixelFormat *pix_fmts)
 {
+    const enum AVPixelFormat hw_pix_fmt = *(const enum AVPixelFormat *)ctx->opaque;
     const enum AVPixelFormat *p;
     for (p = pix_fmts; *p != -1; p++) {
-        if (*p == m_hw_pix_fmt)
+        if (*p == hw_pix_fmt)
             return *p;
     }
     av_log(NULL, AV_LOG_WARNING, "Failed to get HW surface format.");
@@ -110,8 +131,11 @@ static int hw_decoder_init(AVCodecContext *ctx, const enum AVHWDeviceType type)
     return err;
 }
 
-static int open_codec_context(int *stream_idx, AVCodecContext **dec_ctx, AVFormatContext *fmt_ctx, enum AVMediaType type, int device_type = 0)
+// hw_pix_fmt receives the hw surface format of a video decoder, it must outlive the decoder
+static int open_codec_context(int *stream_idx, AVCodecContext **dec_ctx, AVFormatContext *fmt_ctx, enum AVMediaType type, int device_type = 0,
+                              int thread_count = 1, int thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE, enum AVPixelFormat *hw_pix_fmt = nullptr)
 {
+    enum AVHWDeviceType hw_type = AV_HWDEVICE_TYPE_NONE;
     int ret, stream_index;
     AVStream *st;
     AVCodec *dec = NULL;
@@ -153,7 +177,9 @@ static int open_codec_context(int *stream_idx, AVCodecContext **dec_ctx, AVForma
         fprintf(stderr, "Failed to copy %s codec parameters to decoder context\n", av_get_media_type_string(type));
         return ret;
     }
-    if ((*dec_ctx)->codec_type == AVMEDIA_TYPE_VIDEO && device_type == 0)
+    if (hw_pix_fmt)
+        *hw_pix_fmt = AV_PIX_FMT_NONE;
+    if ((*dec_ctx)->codec_type == AVMEDIA_TYPE_VIDEO && device_type == 0 && hw_pix_fmt)
     {
         // try hw codec
         for (int i = 0;; i++) 
@@ -162,26 +188,28 @@ static int open_codec_context(int *stream_idx, AVCodecContext **dec_ctx, AVForma
             if (!config)
             {
                 av_log(NULL, AV_LOG_WARNING,"Decoder %s does not support HW.", dec->name);
-                m_hw_pix_fmt = AV_PIX_FMT_NONE;
-                m_hw_type = AV_HWDEVICE_TYPE_NONE;
                 break;
             }
             if (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) 
             {
-                m_hw_pix_fmt = config->pix_fmt;
-                m_hw_type = config->device_type;
+                *hw_pix_fmt = config->pix_fmt;
+                hw_type = config->device_type;
                 break;
             }
         }
     }
     (*dec_ctx)->codec_id = dec->id;
     // init hw codec
-    if ((*dec_ctx)->codec_type == AVMEDIA_TYPE_VIDEO && device_type == 0 && m_hw_pix_fmt != AV_PIX_FMT_NONE)
+    if (hw_pix_fmt && *hw_pix_fmt != AV_PIX_FMT_NONE)
     {
+        (*dec_ctx)->opaque = hw_pix_fmt;
         (*dec_ctx)->get_format = get_hw_format;
-        if ((ret = hw_decoder_init(*dec_ctx, m_hw_type)) < 0)
+        if ((ret = hw_decoder_init(*dec_ctx, hw_type)) < 0)
             return ret;
     }
+    /* Decoder threading, 0 threads lets ffmpeg pick from the core count */
+    (*dec_ctx)->thread_count = thread_count;
+    (*dec_ctx)->thread_type = thread_type;
     /* Init the decoders */
     if ((ret = avcodec_open2(*dec_ctx, dec, &opts)) < 0) 
     {
@@ -194,6 +222,115 @@ static int open_codec_context(int *stream_idx, AVCodecContext **dec_ctx, AVForma
     return 0;
 }
 
+// ---[ Decoder thread budget ]---
+// Cores reserved by the video decoders of every media source node sharing the
+// budget. The CPU color converter runs on what is left, so several sources
+// don't oversubscribe the machine.
+static int hardware_threads()
+{
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+inline std::atomic<int>& decode_threads_in_use()
+{
+    static std::atomic<int> in_use {0};
+    return in_use;
+}
+
+// reserve up to wanted threads, 0 when the budget is spent
+inline int reserve_decode_threads(int wanted)
+{
+    auto& in_use = decode_threads_in_use();
+    int used = in_use.load();
+    int granted = 0;
+    do
+    {
+        granted = std::max(0, std::min(wanted, hardware_threads() - used));
+    } while (!in_use.compare_exchange_weak(used, used + granted));
+    return granted;
+}
+
+inline void release_decode_threads(int count)
+{
+    decode_threads_in_use() -= count;
+}
+
+// software video decoders drawing from the shared budget, for the auto share
+inline std::atomic<int>& decode_thread_users()
+{
+    static std::atomic<int> users {0};
+    return users;
+}
+
+// bumped whenever a decoder joins or leaves the budget, running ones rebalance
+inline std::atomic<int>& decode_thread_generation()
+{
+    static std::atomic<int> generation {0};
+    return generation;
+}
+
+// share of one decoder, one more share is left to the color converter
+inline int decode_thread_share(int users)
+{
+    return std::max(1, hardware_threads() / (std::max(1, users) + 1));
+}
+
+// true when open_codec_context would decode this stream on a hw device
+static bool has_hw_decoder(const AVCodecParameters* codecpar)
+{
+    const AVCodec* dec = avcodec_find_decoder(codecpar->codec_id);
+    if (!dec)
+        return false;
+    for (int i = 0;; i++)
+    {
+        const AVCodecHWConfig* config = avcodec_get_hw_config(dec, i);
+        if (!config)
+            return false;
+        if (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX)
+            return true;
+    }
+}
+
+// describe a software frame for BluePrint::ConvertYUVToRGBA, false for layouts it doesn't handle
+static bool make_yuv_frame(const AVFrame* frame, int width, ImColorSpace color_space, ImColorRange color_range, BluePrint::YUVFrame& yuv)
+{
+    const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get((AVPixelFormat)frame->format);
+    if (!desc || desc->nb_components != 3 || (desc->flags & (AV_PIX_FMT_FLAG_BE | AV_PIX_FMT_FLAG_RGB | AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_PAL)))
+        return false;
+    int depth = desc->comp[0].depth;
+    if (depth < 8 || depth > 16 || desc->comp[0].plane != 0)
+        return false;
+    bool semi_planar = desc->comp[1].plane == desc->comp[2].plane;
+    if (semi_planar)
+    {
+        // NV12 / P010 / P016, NV21 and friends keep V first
+        if (desc->comp[1].plane != 1 || desc->comp[1].offset > desc->comp[2].offset || desc->log2_chroma_w != 1 || desc->log2_chroma_h != 1)
+            return false;
+        yuv.m_Layout = BluePrint::YUVLayout::NV12;
+    }
+    else if (desc->log2_chroma_w == 1 && desc->log2_chroma_h == 1)
+        yuv.m_Layout = BluePrint::YUVLayout::I420;
+    else if (desc->log2_chroma_w == 1 && desc->log2_chroma_h == 0)
+        yuv.m_Layout = BluePrint::YUVLayout::I422;
+    else if (desc->log2_chroma_w == 0 && desc->log2_chroma_h == 0)
+        yuv.m_Layout = BluePrint::YUVLayout::I444;
+    else
+        return false;
+    for (int i = 0; i < 3; i++)
+    {
+        yuv.m_Data[i] = frame->data[i];
+        yuv.m_Stride[i] = frame->linesize[i];
+    }
+    yuv.m_Width = width;
+    yuv.m_Height = frame->height;
+    yuv.m_Depth = depth;
+    yuv.m_Shift = desc->comp[0].shift;
+    yuv.m_Matrix = color_space == IM_CS_BT601 ? BluePrint::YUVMatrix::BT601 :
+                   color_space == IM_CS_BT2020 ? BluePrint::YUVMatrix::BT2020 : BluePrint::YUVMatrix::BT709;
+    yuv.m_FullRange = color_range == IM_CR_FULL_RANGE;
+    return true;
+}
+
 namespace BluePrint
 {
 struct MediaSourceNode final : Node
@@ -205,6 +342,8 @@ struct MediaSourceNode final : Node
         AVCodecContext *    m_dec_ctx {nullptr};
         AVStream *          m_stream {nullptr};
         AVFrame *           m_frame {nullptr};
+        AVFrame *           m_sw_frame {nullptr};   // reused for hw frame mapping
+        enum AVPixelFormat  m_hw_pix_fmt {AV_PIX_FMT_NONE}; // decoder's hw surface format, its opaque
         Pin *               m_flow {nullptr};
         Pin *               m_mat {nullptr};
 #if IMGUI_VULKAN_SHADER
@@ -212,6 +351,20 @@ struct MediaSourceNode final : Node
 #else
         struct SwsContext*  m_img_convert_ctx {nullptr};
 #endif
+        // owned by the decode thread
+        std::thread         m_thread;
+        int                 m_reserved {0};         // threads taken from the shared budget
+        int                 m_thread_wanted {-1};   // explicit count, 0 = auto, -1 = not on the budget
+        int                 m_thread_type {0};
+        int                 m_generation {0};       // decode_thread_generation() at the last rebalance
+        int                 m_serial {0};
+        int64_t             m_last_video_pts {AV_NOPTS_VALUE};
+        // guarded by m_queue_mutex
+        std::deque<std::pair<AVPacket*, int>> m_packets;   // demuxed packets with their seek serial
+        size_t              m_packet_bytes {0};
+        std::deque<ImGui::ImMat> m_frames;                  // decoded frames ready for Execute
+        size_t              m_frame_bytes {0};
+        bool                m_finished {false};             // decoder drained after end of file
     };
 
     BP_NODE_WITH_NAME(MediaSourceNode, "Media Source", VERSION_BLUEPRINT, NodeType::Internal, NodeStyle::Default, "Media")
@@ -242,6 +395,7 @@ struct MediaSourceNode final : Node
 
     void CloseMedia()
     {
+        StopThreads();
         // rebuild output pins
         for (auto iter = m_OutputPins.begin(); iter != m_OutputPins.end();)
         {
@@ -266,8 +420,10 @@ struct MediaSourceNode final : Node
         }
         for (auto stream : m_streams)
         {
+            release_decode_threads(stream->m_reserved);
             if (stream->m_dec_ctx) avcodec_free_context(&stream->m_dec_ctx);
             if (stream->m_frame) av_frame_free(&stream->m_frame);
+            if (stream->m_sw_frame) av_frame_free(&stream->m_sw_frame);
 #if IMGUI_VULKAN_SHADER
             if (stream->m_yuv2rgb) delete stream->m_yuv2rgb;
 #else
@@ -278,13 +434,15 @@ struct MediaSourceNode final : Node
             delete stream;
         }
         m_streams.clear();
+        if (m_thread_users)
+        {
+            decode_thread_users() -= m_thread_users;
+            decode_thread_generation()++;
+            m_thread_users = 0;
+        }
 
         if (m_fmt_ctx) { avformat_close_input(&m_fmt_ctx); m_fmt_ctx = nullptr; }
-        if (m_pkt) { av_packet_free(&m_pkt); m_pkt = nullptr; }
         //m_next_pts = AV_NOPTS_VALUE;
-        m_last_video_pts = AV_NOPTS_VALUE;
-        m_hw_pix_fmt = AV_PIX_FMT_NONE;
-        m_hw_type = AV_HWDEVICE_TYPE_NONE;
         m_total_time = 0;
         m_current_pts = 0;
         m_need_update = false;
@@ -309,22 +467,49 @@ struct MediaSourceNode final : Node
             {
                 // create video codec context
                 AVCodecContext* video_dec_ctx = nullptr;
-                if (open_codec_context(&stream_index, &video_dec_ctx, m_fmt_ctx, AVMEDIA_TYPE_VIDEO, m_device) >= 0)
+                int thread_count = m_thread_count > 0 ? m_thread_count : 0;
+                int reserved = 0;
+                bool shared = false;
+                if (m_thread_share && m_device == 0 && has_hw_decoder(stream->codecpar))
                 {
-                    struct media_stream * new_stream = new media_stream;
-                    if (new_stream)
-                    {
-                        new_stream->m_index = stream_index;
-                        new_stream->m_type = AVMEDIA_TYPE_VIDEO;
-                        new_stream->m_dec_ctx = video_dec_ctx;
-                        new_stream->m_stream = m_fmt_ctx->streams[stream_index];
-                        new_stream->m_frame = av_frame_alloc();
-                        std::string flow_pin_name = "VOut:" + std::to_string(stream_index);
-                        new_stream->m_flow = InsertOutputPin(BluePrint::PinType::Flow, flow_pin_name);
-                        std::string mat_pin_name = "V:" + std::to_string(stream_index);
-                        new_stream->m_mat = InsertOutputPin(BluePrint::PinType::Mat, mat_pin_name);
-                        m_streams.push_back(new_stream);
-                    }
+                    // the hw device does the work, its few decoder threads mostly wait
+                    thread_count = m_thread_count > 0 ? m_thread_count : 1;
+                }
+                else if (m_thread_share)
+                {
+                    // each decoder is capped at an even share, leaving one for the converter
+                    int users = ++decode_thread_users();
+                    m_thread_users++;
+                    decode_thread_generation()++;
+                    int share = decode_thread_share(users);
+                    reserved = reserve_decode_threads(thread_count > 0 ? std::min(thread_count, share) : share);
+                    thread_count = std::max(1, reserved);
+                    shared = true;
+                }
+                int thread_type = m_thread_type == 1 ? FF_THREAD_FRAME : m_thread_type == 2 ? FF_THREAD_SLICE : FF_THREAD_FRAME | FF_THREAD_SLICE;
+                struct media_stream * new_stream = new media_stream;
+                if (open_codec_context(&stream_index, &video_dec_ctx, m_fmt_ctx, AVMEDIA_TYPE_VIDEO, m_device, thread_count, thread_type, &new_stream->m_hw_pix_fmt) < 0)
+                {
+                    if (video_dec_ctx) avcodec_free_context(&video_dec_ctx);
+                    release_decode_threads(reserved);
+                    delete new_stream;
+                }
+                else
+                {
+                    new_stream->m_reserved = reserved;
+                    new_stream->m_thread_wanted = shared ? m_thread_count : -1;
+                    new_stream->m_thread_type = thread_type;
+                    new_stream->m_generation = decode_thread_generation().load();
+                    new_stream->m_index = stream_index;
+                    new_stream->m_type = AVMEDIA_TYPE_VIDEO;
+                    new_stream->m_dec_ctx = video_dec_ctx;
+                    new_stream->m_stream = m_fmt_ctx->streams[stream_index];
+                    new_stream->m_frame = av_frame_alloc();
+                    std::string flow_pin_name = "VOut:" + std::to_string(stream_index);
+                    new_stream->m_flow = InsertOutputPin(BluePrint::PinType::Flow, flow_pin_name);
+                    std::string mat_pin_name = "V:" + std::to_string(stream_index);
+                    new_stream->m_mat = InsertOutputPin(BluePrint::PinType::Mat, mat_pin_name);
+                    m_streams.push_back(new_stream);
                 }
             }
             else if (stream->codecpar->codec_type == AVMEDIA_TYPE_AUDIO)
@@ -360,34 +545,503 @@ struct MediaSourceNode final : Node
                     break;
             }
         }
-        m_pkt = av_packet_alloc();
+        m_index_stream = -1;
+        for (auto stream : m_streams)
+        {
+            if (stream->m_type == AVMEDIA_TYPE_VIDEO)
+            {
+                m_index_stream = stream->m_index;
+                break;
+            }
+        }
         m_paused = false;
         m_need_update = false;
+        StartThreads();
     }
 
-    int OutVideoFrame(media_stream* stream)
+    // ---[ Prefetch ]---
+    // A demux thread reads packets into per stream queues, one decode thread per
+    // stream turns them into ImMat ahead of playback, and Execute only dequeues.
+    // A seek bumps m_serial, anything tagged with an older serial is dropped.
+    void StartThreads()
+    {
+        m_quit = false;
+        m_eof = false;
+        m_frame_bytes = 0;
+        // the demuxer index is read before the demux thread owns m_fmt_ctx
+        m_index_abort = false;
+        if (m_index_stream >= 0 && !LoadDemuxerIndex() && !LoadIndexCache())
+            m_index_thread = std::thread(&MediaSourceNode::IndexThread, this, m_path, m_index_stream);
+        m_demux_thread = std::thread(&MediaSourceNode::DemuxThread, this);
+        for (auto stream : m_streams)
+            stream->m_thread = std::thread(&MediaSourceNode::DecodeThread, this, stream);
+    }
+
+    void StopThreads()
     {
-        int ret;
-        AVFrame *tmp_frame = nullptr;
-        AVFrame *sw_frame = av_frame_alloc();
-        if (!sw_frame)
         {
-            fprintf(stderr, "Can not alloc frame\n");
-            return -1;
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_quit = true;
         }
-        if (m_last_video_pts != AV_NOPTS_VALUE)
+        m_queue_cond.notify_all();
+        m_index_abort = true;
+        if (m_index_thread.joinable()) m_index_thread.join();
+        if (m_demux_thread.joinable()) m_demux_thread.join();
+        for (auto stream : m_streams)
         {
-            if (stream->m_frame->pict_type == AV_PICTURE_TYPE_B && stream->m_frame->pts < m_last_video_pts)
+            if (stream->m_thread.joinable()) stream->m_thread.join();
+            ClearQueues(stream);
+        }
+        {
+            // the demux thread reads the index for seeks until it is joined
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_keyframes.clear();
+        }
+        m_frame_bytes = 0;
+    }
+
+    // with m_queue_mutex held
+    void ClearQueues(media_stream* stream)
+    {
+        for (auto& packet : stream->m_packets)
+            av_packet_free(&packet.first);
+        stream->m_packets.clear();
+        stream->m_packet_bytes = 0;
+        m_frame_bytes -= stream->m_frame_bytes;
+        stream->m_frames.clear();
+        stream->m_frame_bytes = 0;
+        stream->m_finished = false;
+    }
+
+    static size_t MatBytes(const ImGui::ImMat& mat)
+    {
+        return (size_t)mat.w * mat.h * mat.c * mat.elemsize;
+    }
+
+    // with m_queue_mutex held
+    bool PacketQueueFull() const
+    {
+        size_t bytes = 0;
+        bool enough = true;
+        for (auto stream : m_streams)
+        {
+            bytes += stream->m_packet_bytes;
+            if (stream->m_packets.size() < MEDIA_PACKET_DEPTH) enough = false;
+        }
+        return bytes > MEDIA_PACKET_BYTES || enough;
+    }
+
+    // with m_queue_mutex held, a stream may always hold one frame so the others can't starve it
+    bool FrameQueueFull(const media_stream* stream) const
+    {
+        if (stream->m_frames.empty())
+            return false;
+        return stream->m_frames.size() >= (size_t)m_queue_depth || m_frame_bytes >= (size_t)m_queue_memory * 1024 * 1024;
+    }
+
+    void SeekTo(double time)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_seek_time = time;
+            m_serial++;
+            m_eof = false;
+            for (auto stream : m_streams)
+                ClearQueues(stream);
+        }
+        m_queue_cond.notify_all();
+    }
+
+    // ---[ Keyframe index ]---
+    // Keyframe pts of the first video stream, in its time base. Taken from the
+    // demuxer when the container carries an index (mp4, avi, ...), otherwise
+    // built by a scan that reads packets without decoding them, and cached in
+    // the user cache dir keyed on the media path, size and mtime.
+    static bool StatMedia(const std::string& path, int64_t& mtime, int64_t& size)
+    {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0)
+            return false;
+        mtime = (int64_t)st.st_mtime;
+        size = (int64_t)st.st_size;
+        return true;
+    }
+
+    static std::string IndexCachePath(const std::string& path)
+    {
+        auto dir = GetUserCacheDir("media");
+        if (dir.empty())
+            return "";
+        return dir + "/" + IDToHexString(fnv1a_hash_32(path)) + MEDIA_INDEX_EXTENSION;
+    }
+
+    bool LoadDemuxerIndex()
+    {
+        if (!m_fmt_ctx || m_index_stream < 0 || m_index_stream >= (int)m_fmt_ctx->nb_streams)
+            return false;
+        AVStream* st = m_fmt_ctx->streams[m_index_stream];
+        std::vector<int64_t> index;
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+        int count = avformat_index_get_entries_count(st);
+        for (int i = 0; i < count; i++)
+        {
+            auto entry = avformat_index_get_entry(st, i);
+            if (entry && (entry->flags & AVINDEX_KEYFRAME) && entry->timestamp != AV_NOPTS_VALUE)
+                index.push_back(entry->timestamp);
+        }
+#else
+        for (int i = 0; i < st->nb_index_entries; i++)
+        {
+            auto entry = &st->index_entries[i];
+            if ((entry->flags & AVINDEX_KEYFRAME) && entry->timestamp != AV_NOPTS_VALUE)
+                index.push_back(entry->timestamp);
+        }
+#endif
+        if (index.empty())
+            return false;
+        std::sort(index.begin(), index.end());
+        index.erase(std::unique(index.begin(), index.end()), index.end());
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_keyframes.swap(index);
+        return true;
+    }
+
+    bool LoadIndexCache()
+    {
+        int64_t mtime = 0, size = 0;
+        if (!m_index_cache || !StatMedia(m_path, mtime, size))
+            return false;
+        auto cache_path = IndexCachePath(m_path);
+        if (cache_path.empty())
+            return false;
+        auto loadResult = imgui_json::value::load(cache_path);
+        if (!loadResult.second)
+            return false;
+        auto& value = loadResult.first;
+        double version = 0, cache_mtime = 0, cache_size = 0, stream = -1;
+        std::string media; // the hashed name may collide
+        const imgui_json::array* keyframes = nullptr;
+        if (!imgui_json::GetTo<imgui_json::number>(value, "version", version) || version != MEDIA_INDEX_VERSION ||
+            !imgui_json::GetTo<imgui_json::number>(value, "mtime", cache_mtime) || (int64_t)cache_mtime != mtime ||
+            !imgui_json::GetTo<imgui_json::number>(value, "size", cache_size) || (int64_t)cache_size != size ||
+            !imgui_json::GetTo<imgui_json::number>(value, "stream", stream) || (int)stream != m_index_stream ||
+            !imgui_json::GetTo<imgui_json::string>(value, "path", media) || media != m_path ||
+            !imgui_json::GetPtrTo(value, "keyframes", keyframes))
+            return false;
+        std::vector<int64_t> index;
+        index.reserve(keyframes->size());
+        for (auto& key : *keyframes)
+        {
+            if (key.is_number())
+                index.push_back((int64_t)key.get<imgui_json::number>());
+        }
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_keyframes.swap(index);
+        return !m_keyframes.empty();
+    }
+
+    void SaveIndexCache(const std::string& path, int stream, const std::vector<int64_t>& keyframes)
+    {
+        int64_t mtime = 0, size = 0;
+        auto cache_path = IndexCachePath(path);
+        if (cache_path.empty() || !StatMedia(path, mtime, size))
+            return;
+        imgui_json::value value;
+        value["path"] = path;
+        value["version"] = imgui_json::number(MEDIA_INDEX_VERSION);
+        value["mtime"] = imgui_json::number(mtime);
+        value["size"] = imgui_json::number(size);
+        value["stream"] = imgui_json::number(stream);
+        imgui_json::value keys = imgui_json::array();
+        for (auto key : keyframes)
+            keys.push_back(imgui_json::number(key));
+        value["keyframes"] = keys;
+        if (!value.save(cache_path))
+            fprintf(stderr, "Can't write keyframe index for %s\n", path.c_str());
+    }
+
+    void IndexThread(std::string path, int stream)
+    {
+        AVFormatContext* fmt_ctx = nullptr;
+        if (avformat_open_input(&fmt_ctx, path.c_str(), NULL, NULL) < 0)
+            return;
+        AVPacket* pkt = av_packet_alloc();
+        std::vector<int64_t> keyframes;
+        bool complete = false;
+        while (!m_index_abort)
+        {
+            int ret = av_read_frame(fmt_ctx, pkt);
+            if (ret < 0)
+            {
+                complete = ret == AVERROR_EOF;
+                break;
+            }
+            if (pkt->stream_index == stream && (pkt->flags & AV_PKT_FLAG_KEY))
+            {
+                int64_t ts = pkt->pts != AV_NOPTS_VALUE ? pkt->pts : pkt->dts;
+                if (ts != AV_NOPTS_VALUE)
+                    keyframes.push_back(ts);
+            }
+            av_packet_unref(pkt);
+        }
+        av_packet_free(&pkt);
+        avformat_close_input(&fmt_ctx);
+        if (!complete || keyframes.empty())
+            return;
+        std::sort(keyframes.begin(), keyframes.end());
+        keyframes.erase(std::unique(keyframes.begin(), keyframes.end()), keyframes.end());
+        if (m_index_cache)
+            SaveIndexCache(path, stream, keyframes);
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_keyframes.swap(keyframes);
+    }
+
+    // jump to the keyframe at or before time, the decoders skip up to the exact frame
+    void SeekDemuxer(double time)
+    {
+        int64_t keyframe = AV_NOPTS_VALUE;
+        auto iter = std::find_if(m_streams.begin(), m_streams.end(), [&](const media_stream* ss) {
+            return ss->m_index == m_index_stream;
+        });
+        if (iter != m_streams.end())
+        {
+            // demuxer indexes hold dts, which may lead pts by the codec's reorder delay
+            double lead = (*iter)->m_stream->codecpar->video_delay * FrameDuration(*iter);
+            int64_t target = (int64_t)((time - lead) / av_q2d((*iter)->m_stream->time_base));
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            auto key = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), target);
+            if (key != m_keyframes.begin())
+                keyframe = *(key - 1);
+        }
+        if (keyframe == AV_NOPTS_VALUE || av_seek_frame(m_fmt_ctx, m_index_stream, keyframe, AVSEEK_FLAG_BACKWARD) < 0)
+            av_seek_frame(m_fmt_ctx, -1, (int64_t)(time * AV_TIME_BASE), AVSEEK_FLAG_BACKWARD);
+    }
+
+    // a frame shows from its pts for one frame duration, the one covering the target is kept
+    static double FrameDuration(const media_stream* stream)
+    {
+        double fps = av_q2d(stream->m_stream->avg_frame_rate);
+        return fps > 0 ? 1.0 / fps : 0;
+    }
+
+    // true while a decoded frame still ends before the seek target
+    static bool BeforeTarget(const media_stream* stream, const AVFrame* frame, double target)
+    {
+        if (isnan(target))
+            return false;
+        if (stream->m_type == AVMEDIA_TYPE_AUDIO)
+        {
+            if (frame->pts == AV_NOPTS_VALUE || frame->sample_rate <= 0)
+                return false;
+            return frame->pts * av_q2d(stream->m_stream->time_base) + (double)frame->nb_samples / frame->sample_rate <= target;
+        }
+        int64_t ts = frame->best_effort_timestamp;
+        if (ts == AV_NOPTS_VALUE)
+            return false;
+        return ts * av_q2d(stream->m_stream->time_base) + FrameDuration(stream) <= target + MEDIA_TIME_EPSILON;
+    }
+
+    void DemuxThread()
+    {
+        int serial = 0;
+        AVPacket* pkt = av_packet_alloc();
+        while (true)
+        {
+            double seek_time = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_queue_mutex);
+                m_queue_cond.wait(lock, [&] { return m_quit || serial != m_serial || (!m_eof && !PacketQueueFull()); });
+                if (m_quit)
+                    break;
+                if (serial != m_serial)
+                {
+                    serial = m_serial;
+                    seek_time = m_seek_time;
+                }
+                else
+                    seek_time = NAN;
+            }
+            if (!isnan(seek_time))
+            {
+                SeekDemuxer(seek_time);
+                continue;
+            }
+
+            int ret = av_read_frame(m_fmt_ctx, pkt);
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            if (ret < 0)
+            {
+                if (serial == m_serial)
+                    m_eof = true;
+            }
+            else
+            {
+                auto iter = std::find_if(m_streams.begin(), m_streams.end(), [&](const media_stream* ss) {
+                    return ss->m_index == pkt->stream_index;
+                });
+                if (iter != m_streams.end())
+                {
+                    AVPacket* packet = av_packet_alloc();
+                    av_packet_move_ref(packet, pkt);
+                    (*iter)->m_packets.emplace_back(packet, serial);
+                    (*iter)->m_packet_bytes += packet->size;
+                }
+                av_packet_unref(pkt);
+            }
+            m_queue_cond.notify_all();
+        }
+        av_packet_free(&pkt);
+    }
+
+    void DecodeThread(media_stream* stream)
+    {
+        double target = NAN;    // seek target this stream still has to reach
+        while (true)
+        {
+            AVPacket* packet = nullptr;
+            int serial = 0;
+            double seek_time = NAN;
+            {
+                std::unique_lock<std::mutex> lock(m_queue_mutex);
+                m_queue_cond.wait(lock, [&] { return m_quit || !stream->m_packets.empty() || (m_eof && !stream->m_finished); });
+                if (m_quit)
+                    break;
+                if (!stream->m_packets.empty())
+                {
+                    packet = stream->m_packets.front().first;
+                    serial = stream->m_packets.front().second;
+                    stream->m_packets.pop_front();
+                    stream->m_packet_bytes -= packet->size;
+                    m_queue_cond.notify_all();
+                }
+                else
+                    serial = m_serial; // drain at end of file
+                if (serial == m_serial)
+                    seek_time = m_seek_time;
+            }
+            if (serial != stream->m_serial)
+            {
+                avcodec_flush_buffers(stream->m_dec_ctx);
+                stream->m_serial = serial;
+                stream->m_last_video_pts = AV_NOPTS_VALUE;
+                target = serial > 0 ? seek_time : NAN;
+            }
+            if (packet && (packet->flags & AV_PKT_FLAG_KEY) && stream->m_thread_wanted >= 0 &&
+                stream->m_generation != decode_thread_generation().load())
+                RebalanceDecoder(stream, serial, target);
+            if (packet && stream->m_type == AVMEDIA_TYPE_VIDEO)
+            {
+                // frames nothing else references can be skipped until the target is close
+                bool early = !isnan(target) && packet->pts != AV_NOPTS_VALUE &&
+                            packet->pts * av_q2d(stream->m_stream->time_base) + FrameDuration(stream) <= target + MEDIA_TIME_EPSILON;
+                stream->m_dec_ctx->skip_frame = early ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+            }
+            bool drain = !packet;
+            int ret = avcodec_send_packet(stream->m_dec_ctx, packet);
+            if (packet) av_packet_free(&packet);
+            if (ret >= 0)
+                ret = ReceiveFrames(stream, serial, target);
+            if (drain && ret == AVERROR_EOF)
+            {
+                avcodec_flush_buffers(stream->m_dec_ctx);
+                std::lock_guard<std::mutex> lock(m_queue_mutex);
+                if (serial == m_serial)
+                    stream->m_finished = true;
+                m_queue_cond.notify_all();
+            }
+        }
+    }
+
+    // queue every frame the decoder has ready, returns the last receive error
+    int ReceiveFrames(media_stream* stream, int serial, double& target)
+    {
+        int ret = 0;
+        while (ret >= 0)
+        {
+            ret = avcodec_receive_frame(stream->m_dec_ctx, stream->m_frame);
+            if (ret < 0)
+                break;
+            if (BeforeTarget(stream, stream->m_frame, target))
+            {
+                av_frame_unref(stream->m_frame);
+                continue;
+            }
+            target = NAN;
+            ImGui::ImMat mat;
+            int out = stream->m_type == AVMEDIA_TYPE_VIDEO ? OutVideoFrame(stream, mat) : OutAudioFrame(stream, mat);
+            av_frame_unref(stream->m_frame);
+            if (out != 0)
+                continue;
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_queue_cond.wait(lock, [&] { return m_quit || serial != m_serial || !FrameQueueFull(stream); });
+            if (m_quit || serial != m_serial)
+                continue; // seeked away, drop it
+            auto bytes = MatBytes(mat);
+            stream->m_frames.push_back(mat);
+            stream->m_frame_bytes += bytes;
+            m_frame_bytes += bytes;
+            m_queue_cond.notify_all();
+        }
+        return ret;
+    }
+
+    // Decoders joined or left the budget: on a keyframe, drain the decoder and
+    // reopen it with the current share. The thread count of an open ffmpeg
+    // decoder can't be changed.
+    void RebalanceDecoder(media_stream* stream, int serial, double& target)
+    {
+        stream->m_generation = decode_thread_generation().load();
+        int share = decode_thread_share(decode_thread_users().load());
+        int wanted = stream->m_thread_wanted > 0 ? std::min(stream->m_thread_wanted, share) : share;
+        if (wanted == stream->m_reserved)
+            return;
+        if (wanted > stream->m_reserved && decode_threads_in_use().load() >= hardware_threads())
+            return; // nothing to grow into yet
+        int reserved = wanted < stream->m_reserved ? wanted :
+                        stream->m_reserved + reserve_decode_threads(wanted - stream->m_reserved);
+        int index = stream->m_index;
+        AVCodecContext* dec_ctx = nullptr;
+        if (open_codec_context(&index, &dec_ctx, m_fmt_ctx, AVMEDIA_TYPE_VIDEO, m_device, std::max(1, reserved), stream->m_thread_type, &stream->m_hw_pix_fmt) < 0)
+        {
+            if (dec_ctx) avcodec_free_context(&dec_ctx);
+            if (reserved > stream->m_reserved)
+                release_decode_threads(reserved - stream->m_reserved);
+            return;
+        }
+        avcodec_send_packet(stream->m_dec_ctx, nullptr);
+        ReceiveFrames(stream, serial, target);
+        avcodec_free_context(&stream->m_dec_ctx);
+        stream->m_dec_ctx = dec_ctx;
+        if (reserved < stream->m_reserved)
+            release_decode_threads(stream->m_reserved - reserved);
+        stream->m_reserved = reserved;
+    }
+
+    int OutVideoFrame(media_stream* stream, ImGui::ImMat& out)
+    {
+        int ret;
+        AVFrame *tmp_frame = nullptr;
+        AVFrame *sw_frame = nullptr;
+        if (stream->m_last_video_pts != AV_NOPTS_VALUE)
+        {
+            if (stream->m_frame->pict_type == AV_PICTURE_TYPE_B && stream->m_frame->pts < stream->m_last_video_pts)
             {
                 // do we only need skip first gop B frame after first I frame?
                 fprintf(stderr, "Output frame isn't in current GOP and decoder maybe not completed\n");
-                av_frame_free(&sw_frame);
                 return -1;
             }
         }
-        m_last_video_pts = stream->m_frame->pts;
-        if (stream->m_frame->format == m_hw_pix_fmt)
+        stream->m_last_video_pts = stream->m_frame->pts;
+        if (stream->m_hw_pix_fmt != AV_PIX_FMT_NONE && stream->m_frame->format == stream->m_hw_pix_fmt)
         {
+            if (!stream->m_sw_frame)
+                stream->m_sw_frame = av_frame_alloc();
+            sw_frame = stream->m_sw_frame;
+            if (!sw_frame)
+            {
+                fprintf(stderr, "Can not alloc frame\n");
+                return -1;
+            }
             /* retrieve data from GPU to CPU */
             if ((ret = av_hwframe_map(sw_frame, stream->m_frame, AV_HWFRAME_MAP_READ)) < 0)
             {
@@ -397,7 +1051,7 @@ struct MediaSourceNode final : Node
                 if ((ret = av_hwframe_transfer_data(sw_frame, stream->m_frame, 0)) < 0) 
                 {
                     fprintf(stderr, "Error transferring the data to system memory\n");
-                    av_frame_free(&sw_frame);
+                    av_frame_unref(sw_frame);
                     return -1;
                 }
                 else
@@ -441,7 +1095,6 @@ struct MediaSourceNode final : Node
         int out_h = tmp_frame->height;
         int UV_shift_w = ISYUV420P(tmp_frame->format) || ISYUV422P(tmp_frame->format) ? 1 : 0;
         int UV_shift_h = ISYUV420P(tmp_frame->format) || ISNV12(tmp_frame->format) ? 1 : 0;
-        m_mutex.lock();
         
         // using separated mat to convert color from AVFrame, prevent copy frame one time
         ImGui::ImMat mat_Y, mat_U, mat_V;
@@ -467,6 +1120,7 @@ struct MediaSourceNode final : Node
             stream->m_yuv2rgb = new ImGui::ColorConvert_vulkan(gpu);
             if (!stream->m_yuv2rgb)
             {
+                if (sw_frame) av_frame_unref(sw_frame);
                 return -1;
             }
         }
@@ -488,42 +1142,51 @@ struct MediaSourceNode final : Node
             im_RGB.color_range = color_range;
             im_RGB.depth = video_depth;
             im_RGB.rate = {stream->m_stream->avg_frame_rate.num, stream->m_stream->avg_frame_rate.den};
-            auto pin = (MatPin*)stream->m_mat;
-            if (pin) pin->SetValue(im_RGB);
+            out = im_RGB;
         }
 #else
-        // ffmpeg swscale
-        if (!stream->m_img_convert_ctx)
+        ImGui::ImMat im_RGB;
+        BluePrint::YUVFrame yuv;
+        if (make_yuv_frame(tmp_frame, mat_Y.w, color_space, color_range, yuv))
         {
-            AVPixelFormat format =  mat_Y.color_format == IM_CF_YUV420 ? (video_depth > 8 ? AV_PIX_FMT_YUV420P10 : AV_PIX_FMT_YUV420P) :
-                                    mat_Y.color_format == IM_CF_YUV422 ? (video_depth > 8 ? AV_PIX_FMT_YUV422P10 : AV_PIX_FMT_YUV422P) :
-                                    mat_Y.color_format == IM_CF_YUV444 ? (video_depth > 8 ? AV_PIX_FMT_YUV444P10 : AV_PIX_FMT_YUV444P) :
-                                    mat_Y.color_format == IM_CF_NV12 ? (video_depth > 8 ? AV_PIX_FMT_P010LE : AV_PIX_FMT_NV12) :
-                                    AV_PIX_FMT_YUV420P;
-            stream->m_img_convert_ctx = sws_getCachedContext(
-                                stream->m_img_convert_ctx,
-                                mat_Y.w,
-                                mat_Y.h,
-                                (AVPixelFormat)tmp_frame->format,
-                                mat_Y.w,
-                                mat_Y.h,
-                                AV_PIX_FMT_RGBA,
-                                SWS_BICUBIC,
-                                NULL, NULL, NULL);
+            // SDK SIMD converter, straight into the output mat
+            im_RGB = ImGui::ImMat(mat_Y.w, mat_Y.h, 4, 1u);
+            int threads = m_thread_share ? std::max(1, hardware_threads() - decode_threads_in_use().load()) : 0;
+            BluePrint::ConvertYUVToRGBA(yuv, (uint8_t *)im_RGB.data, mat_Y.w * 4, threads);
         }
-        if (stream->m_img_convert_ctx)
+        else
+        {
+            // ffmpeg swscale for the formats it doesn't cover
+            if (!stream->m_img_convert_ctx)
+            {
+                stream->m_img_convert_ctx = sws_getCachedContext(
+                                    stream->m_img_convert_ctx,
+                                    mat_Y.w,
+                                    mat_Y.h,
+                                    (AVPixelFormat)tmp_frame->format,
+                                    mat_Y.w,
+                                    mat_Y.h,
+                                    AV_PIX_FMT_RGBA,
+                                    SWS_BICUBIC,
+                                    NULL, NULL, NULL);
+            }
+            if (stream->m_img_convert_ctx)
+            {
+                im_RGB = ImGui::ImMat(mat_Y.w, mat_Y.h, 4, 1u);
+                uint8_t *dst_data[] = { (uint8_t *)im_RGB.data };
+                int dst_linesize[] = { mat_Y.w * 4 }; // how many for 16 bits?
+                sws_scale(
+                    stream->m_img_convert_ctx,
+                    tmp_frame->data,
+                    tmp_frame->linesize,
+                    0, mat_Y.h,
+                    dst_data,
+                    dst_linesize
+                );
+            }
+        }
+        if (!im_RGB.empty())
         {
-            ImGui::ImMat im_RGB(mat_Y.w, mat_Y.h, 4, 1u);
-            uint8_t *dst_data[] = { (uint8_t *)im_RGB.data };
-            int dst_linesize[] = { mat_Y.w * 4 }; // how many for 16 bits?
-            sws_scale(
-                stream->m_img_convert_ctx,
-                tmp_frame->data,
-                tmp_frame->linesize,
-                0, mat_Y.h,
-                dst_data,
-                dst_linesize
-            );
             im_RGB.flags = mat_Y.flags;
             im_RGB.type = IM_DT_INT8;
             im_RGB.time_stamp = current_video_pts;
@@ -531,8 +1194,7 @@ struct MediaSourceNode final : Node
             im_RGB.color_range = color_range;
             im_RGB.depth = video_depth;
             im_RGB.rate = {stream->m_stream->avg_frame_rate.num, stream->m_stream->avg_frame_rate.den};
-            auto pin = (MatPin*)stream->m_mat;
-            if (pin) pin->SetValue(im_RGB);
+            out = im_RGB;
         }
 #endif
 /*
@@ -698,119 +1360,125 @@ struct MediaSourceNode final : Node
         }
 #endif
 */
-        m_mutex.unlock();
-        av_frame_free(&sw_frame);
-        m_current_pts = current_video_pts;
+        if (sw_frame) av_frame_unref(sw_frame);
         return 0;
     }
 
-    int OutAudioFrame(media_stream* stream)
+    template <typename T>
+    static void DeinterleaveAudio(const uint8_t* src, ImGui::ImMat& mat, int channels, int samples)
+    {
+        const T* in = (const T*)src;
+        for (int i = 0; i < channels; i++)
+        {
+            T* out = (T*)mat.channel(i).data;
+            for (int x = 0; x < samples; x++)
+                out[x] = in[x * channels + i];
+        }
+    }
+
+    int OutAudioFrame(media_stream* stream, ImGui::ImMat& out)
     {
         // Generate Audio Mat
         ImGui::ImMat mat_A;
         int data_size = av_get_bytes_per_sample((enum AVSampleFormat)stream->m_frame->format);
-        AVRational tb = (AVRational){1, stream->m_frame->sample_rate};
+        AVRational tb = stream->m_stream->time_base; // decoder pkt_timebase, frame pts stay in stream units
         ImDataType type  =  (stream->m_frame->format == AV_SAMPLE_FMT_FLT) || (stream->m_frame->format == AV_SAMPLE_FMT_FLTP) ? IM_DT_FLOAT32 :
                             (stream->m_frame->format == AV_SAMPLE_FMT_S32) || (stream->m_frame->format == AV_SAMPLE_FMT_S32P) ? IM_DT_INT32:
                             (stream->m_frame->format == AV_SAMPLE_FMT_S16) || (stream->m_frame->format == AV_SAMPLE_FMT_S16P) ? IM_DT_INT16:
                             IM_DT_INT8;
         double current_audio_pts = (stream->m_frame->pts == AV_NOPTS_VALUE) ? NAN : stream->m_frame->pts * av_q2d(tb);
-        m_mutex.lock();
 #if !defined(FF_API_OLD_CHANNEL_LAYOUT) && (LIBAVUTIL_VERSION_MAJOR < 58)
         int channels = stream->m_frame->channels;
 #else
         int channels = stream->m_frame->ch_layout.nb_channels;
 #endif
-        mat_A.create_type(stream->m_frame->nb_samples, 1, channels, type);
-        for (int i = 0; i < channels; i++)
+        int nb_samples = stream->m_frame->nb_samples;
+        mat_A.create_type(nb_samples, 1, channels, type);
+        if (data_size == (int)mat_A.elemsize && av_sample_fmt_is_planar((enum AVSampleFormat)stream->m_frame->format))
+        {
+            // ImMat keeps channels as planes too, one memcpy per channel
+            for (int i = 0; i < channels; i++)
+                memcpy(mat_A.channel(i).data, stream->m_frame->data[i], (size_t)nb_samples * data_size);
+        }
+        else if (data_size == (int)mat_A.elemsize)
         {
-            for (int x = 0; x < stream->m_frame->nb_samples; x++)
+            // packed samples, deinterleave in one pass per channel
+            if (type == IM_DT_FLOAT32)
+                DeinterleaveAudio<float>(stream->m_frame->data[0], mat_A, channels, nb_samples);
+            else if (type == IM_DT_INT32)
+                DeinterleaveAudio<int32_t>(stream->m_frame->data[0], mat_A, channels, nb_samples);
+            else if (type == IM_DT_INT16)
+                DeinterleaveAudio<int16_t>(stream->m_frame->data[0], mat_A, channels, nb_samples);
+            else
+                DeinterleaveAudio<int8_t>(stream->m_frame->data[0], mat_A, channels, nb_samples);
+        }
+        else
+        {
+            // packed formats keep every channel interleaved in data[0]
+            bool planar = av_sample_fmt_is_planar((enum AVSampleFormat)stream->m_frame->format);
+            for (int i = 0; i < channels; i++)
             {
-                if (type == IM_DT_FLOAT32)
-                    mat_A.at<float>(x, 0, i) = ((float *)stream->m_frame->data[i])[x];
-                else if (type == IM_DT_INT32)
-                    mat_A.at<int32_t>(x, 0, i) = ((int32_t *)stream->m_frame->data[i])[x];
-                else if (type == IM_DT_INT16)
-                    mat_A.at<int16_t>(x, 0, i) = ((int16_t *)stream->m_frame->data[i])[x];
-                else
-                    mat_A.at<int8_t>(x, 0, i) = ((int8_t *)stream->m_frame->data[i])[x];
+                const uint8_t* plane = planar ? stream->m_frame->data[i] : stream->m_frame->data[0];
+                int offset = planar ? 0 : i;
+                int step = planar ? 1 : channels;
+                for (int x = 0; x < nb_samples; x++)
+                {
+                    int index = x * step + offset;
+                    if (type == IM_DT_FLOAT32)
+                        mat_A.at<float>(x, 0, i) = ((const float *)plane)[index];
+                    else if (type == IM_DT_INT32)
+                        mat_A.at<int32_t>(x, 0, i) = ((const int32_t *)plane)[index];
+                    else if (type == IM_DT_INT16)
+                        mat_A.at<int16_t>(x, 0, i) = ((const int16_t *)plane)[index];
+                    else
+                        mat_A.at<int8_t>(x, 0, i) = ((const int8_t *)plane)[index];
+                }
             }
         }
         mat_A.time_stamp = current_audio_pts;
         mat_A.rate = {stream->m_frame->sample_rate, 1};
         mat_A.flags = IM_MAT_FLAGS_AUDIO_FRAME;
-        auto pin = (MatPin*)stream->m_mat;
-        if (pin) pin->SetValue(mat_A);
-        m_mutex.unlock();
-        m_current_pts = current_audio_pts;
+        out = mat_A;
         return 0;
     }
 
     FlowPin DecodeMedia()
     {
-        while (true)
-        {
-            int ret = 0;
-            ret = av_read_frame(m_fmt_ctx, m_pkt);
-            if (ret < 0)
-            {
-                if (ret == AVERROR_EOF) 
-                {
-                    for (auto stream : m_streams) avcodec_flush_buffers(stream->m_dec_ctx); 
-                    return m_Exit;
-                }
-                break;
-            }
-            // find stream index
-            auto iter = std::find_if(m_streams.begin(), m_streams.end(), [&](const media_stream* ss) {
-                return ss->m_index == m_pkt->stream_index;
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        // wait a little for every stream so frames leave in time stamp order
+        m_queue_cond.wait_for(lock, std::chrono::milliseconds(MEDIA_WAIT_MS), [&] {
+            return std::all_of(m_streams.begin(), m_streams.end(), [](const media_stream* stream) {
+                return !stream->m_frames.empty() || stream->m_finished;
             });
-            if (iter == m_streams.end())
-                break;
-            media_stream * stream = *iter;
-            ret = avcodec_send_packet(stream->m_dec_ctx, m_pkt);
-            av_packet_unref(m_pkt);
-            if (ret < 0)
-            {
-                if (ret == AVERROR_EOF)
-                {
-                    for (auto stream : m_streams) avcodec_flush_buffers(stream->m_dec_ctx); 
-                    return m_Exit;
-                }
-                break;
-            }
-            ret = avcodec_receive_frame(stream->m_dec_ctx, stream->m_frame);
-            if (ret < 0) 
-            {
-                if (ret == AVERROR_EOF)
-                {
-                    for (auto stream : m_streams) avcodec_flush_buffers(stream->m_dec_ctx); 
-                    return m_Exit;
-                }
-                else if (ret == AVERROR(EAGAIN)) continue;
-                else break;
-            }
-            else
-            {
-                if (stream->m_type == AVMEDIA_TYPE_VIDEO)
-                {
-                    ret = OutVideoFrame(stream);
-                    av_frame_unref(stream->m_frame);
-                    if (ret != 0)
-                        break;
-                    return *(FlowPin*)stream->m_flow;
-                }
-                else if (stream->m_type == AVMEDIA_TYPE_AUDIO)
-                {
-                    ret = OutAudioFrame(stream);
-                    av_frame_unref(stream->m_frame);
-                    if (ret != 0)
-                        break;
-                    return *(FlowPin*)stream->m_flow;
-                }
-            }
+        });
+        media_stream* next = nullptr;
+        for (auto stream : m_streams)
+        {
+            if (stream->m_frames.empty())
+                continue;
+            if (!next || stream->m_frames.front().time_stamp < next->m_frames.front().time_stamp)
+                next = stream;
         }
-        return {};
+        if (!next)
+        {
+            bool finished = m_eof && std::all_of(m_streams.begin(), m_streams.end(), [](const media_stream* stream) { return stream->m_finished; });
+            return finished ? m_Exit : FlowPin {};
+        }
+        ImGui::ImMat mat = next->m_frames.front();
+        next->m_frames.pop_front();
+        auto bytes = MatBytes(mat);
+        next->m_frame_bytes -= bytes;
+        m_frame_bytes -= bytes;
+        lock.unlock();
+        m_queue_cond.notify_all();
+
+        m_mutex.lock();
+        auto pin = (MatPin*)next->m_mat;
+        if (pin) pin->SetValue(mat);
+        m_mutex.unlock();
+        m_current_pts = mat.time_stamp;
+        m_need_update = false;
+        return *(FlowPin*)next->m_flow;
     }
 
     void Reset(Context& context) override
@@ -829,7 +1497,6 @@ struct MediaSourceNode final : Node
         {
             if (m_need_update || !m_paused)
             {
-                m_need_update = false;
                 auto ret = DecodeMedia();
                 if (ret.m_Name != "Exit")
                     context.PushReturnPoint(entryPoint);
@@ -878,6 +1545,22 @@ struct MediaSourceNode final : Node
         ImGui::Separator();
         ImGui::RadioButton("GPU",  (int *)&m_device, 0); ImGui::SameLine();
         ImGui::RadioButton("CPU",   (int *)&m_device, -1);
+        ImGui::Separator();
+        ImGui::PushItemWidth(200);
+        ImGui::SliderInt("Prefetch Frames", &m_queue_depth, 1, 64);
+        ImGui::SliderInt("Prefetch Memory(MB)", &m_queue_memory, 16, 4096);
+        ImGui::PopItemWidth();
+        ImGui::Checkbox("Cache Keyframe Index", &m_index_cache);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Decode Threads:"); ImGui::SameLine();
+        ImGui::RadioButton("Auto", &m_thread_type, 0); ImGui::SameLine();
+        ImGui::RadioButton("Frame", &m_thread_type, 1); ImGui::SameLine();
+        ImGui::RadioButton("Slice", &m_thread_type, 2);
+        ImGui::PushItemWidth(200);
+        ImGui::SliderInt("Thread Count(0 = Auto)", &m_thread_count, 0, hardware_threads());
+        ImGui::PopItemWidth();
+        ImGui::Checkbox("Share Thread Budget", &m_thread_share);
+        ImGui::TextUnformatted("Decoder threads apply when the media is opened");
 
         if (ImGuiFileDialog::Instance()->Display("##NodeMediaSourceDlgKey", ImGuiWindowFlags_NoCollapse, minSize, maxSize))
         {
@@ -917,8 +1600,7 @@ struct MediaSourceNode final : Node
             if (m_fmt_ctx)
             {
                 // Seek
-                int64_t seek_time = time * AV_TIME_BASE;
-                av_seek_frame(m_fmt_ctx, -1, seek_time, AVSEEK_FLAG_BACKWARD);
+                SeekTo(time);
                 m_current_pts = time;
                 m_need_update = true;
             }
@@ -1001,6 +1683,9 @@ struct MediaSourceNode final : Node
         if (!value.is_object())
             return BP_ERR_NODE_LOAD;
 
+        // loading into an open node (undo, plugin reload), stop its threads before the pins are rebuilt
+        CloseMedia();
+
         if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
             return BP_ERR_NODE_LOAD;
 
@@ -1023,6 +1708,42 @@ struct MediaSourceNode final : Node
             if (val.is_number()) 
                 m_device = (ImDataType)val.get<imgui_json::number>();
         }
+        if (value.contains("queue_depth"))
+        {
+            auto& val = value["queue_depth"];
+            if (val.is_number()) 
+                m_queue_depth = val.get<imgui_json::number>();
+        }
+        if (value.contains("queue_memory"))
+        {
+            auto& val = value["queue_memory"];
+            if (val.is_number()) 
+                m_queue_memory = val.get<imgui_json::number>();
+        }
+        if (value.contains("thread_type"))
+        {
+            auto& val = value["thread_type"];
+            if (val.is_number()) 
+                m_thread_type = val.get<imgui_json::number>();
+        }
+        if (value.contains("thread_count"))
+        {
+            auto& val = value["thread_count"];
+            if (val.is_number()) 
+                m_thread_count = val.get<imgui_json::number>();
+        }
+        if (value.contains("thread_share"))
+        {
+            auto& val = value["thread_share"];
+            if (val.is_boolean()) 
+                m_thread_share = val.get<imgui_json::boolean>();
+        }
+        if (value.contains("index_cache"))
+        {
+            auto& val = value["index_cache"];
+            if (val.is_boolean()) 
+                m_index_cache = val.get<imgui_json::boolean>();
+        }
         if (value.contains("media_path"))
         {
             auto& val = value["media_path"];
@@ -1074,6 +1795,12 @@ struct MediaSourceNode final : Node
         Node::Save(value, MapID);
         value["mat_type"] = imgui_json::number(m_mat_data_type);
         value["device_type"] = imgui_json::number(m_device);
+        value["queue_depth"] = imgui_json::number(m_queue_depth);
+        value["queue_memory"] = imgui_json::number(m_queue_memory);
+        value["index_cache"] = imgui_json::boolean(m_index_cache);
+        value["thread_type"] = imgui_json::number(m_thread_type);
+        value["thread_count"] = imgui_json::number(m_thread_count);
+        value["thread_share"] = imgui_json::boolean(m_thread_share);
         value["media_path"] = m_path;
         value["file_name"] = m_file_name;
     }
@@ -1095,14 +1822,37 @@ private:
     std::string         m_file_name;
 
     AVFormatContext*    m_fmt_ctx {nullptr};
-    AVPacket*           m_pkt {nullptr};
     std::vector<media_stream*> m_streams;
 
     double              m_total_time    {0};
     double              m_current_pts   {0};
-    int64_t             m_last_video_pts {AV_NOPTS_VALUE};
     bool                m_paused        {false};
     bool                m_need_update   {false};
+
+    // prefetch
+    int                 m_queue_depth   {MEDIA_QUEUE_DEPTH};
+    int                 m_queue_memory  {MEDIA_QUEUE_MEMORY};
+    std::thread         m_demux_thread;
+    std::mutex          m_queue_mutex;
+    std::condition_variable m_queue_cond;
+    size_t              m_frame_bytes   {0};    // all streams
+    int                 m_serial        {0};    // bumped by every seek
+    double              m_seek_time     {0};
+    bool                m_eof           {false};
+    bool                m_quit          {false};
+
+    // keyframe index, guarded by m_queue_mutex once the threads run
+    int                 m_index_stream  {-1};
+    std::vector<int64_t> m_keyframes;
+    bool                m_index_cache   {true};
+    std::thread         m_index_thread;
+    std::atomic<bool>   m_index_abort   {false};
+
+    // video decoder threading, applied when the media is opened
+    int                 m_thread_type   {0};        // 0 = frame and slice, 1 = frame, 2 = slice
+    int                 m_thread_count  {0};        // 0 = auto
+    bool                m_thread_share  {true};     // reserve threads from the budget shared by all media nodes
+    int                 m_thread_users {0};     // decoders counted in decode_thread_users()
 };
 }
 #endif // SDK_WITH_FFMPEG
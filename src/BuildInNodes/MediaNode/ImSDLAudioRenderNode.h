@@ -5,6 +5,10 @@
 #include <imgui_extra_widget.h>
 #include <SDL.h>
 #include <SDL_thread.h>
+#include <SPSCRing.h>
+#include <AudioDSP.h>
+#include <algorithm>
+#include <atomic>
 
 #define MAX_AUDIO_BUFFER    128
 #define SDL_AUDIO_MIN_BUFFER_SIZE 512
@@ -43,6 +47,13 @@ static inline int log2_c(unsigned int v)
 static void sdl_audio_callback(void *opaque, Uint8 *stream, int len);
 namespace BluePrint
 {
+// pts of the sample at m_Pos of the sample ring
+struct AudioMark
+{
+    size_t m_Pos {0};
+    double m_Pts {NAN};
+};
+
 // ======================================================= //
 // ================ Rendering Node FFMPEG ================ //
 // ======================================================= //
@@ -59,12 +70,9 @@ struct SDLAudioRenderingNode final : Node
 
     ~SDLAudioRenderingNode()
     {
-        m_mutex.lock();
-        for (auto mat : m_queue) { mat.release(); } m_queue.clear();
-        m_mutex.unlock();
+        SDL_CloseAudioDevice(m_audio_dev);
         for (auto data : m_channel_wave_data) { if (data) free(data); data = nullptr; }
         m_channel_wave_data.clear();
-        SDL_CloseAudioDevice(m_audio_dev);
 #if !IMGUI_APPLICATION_PLATFORM_SDL2
         SDL_Quit();
 #endif
@@ -73,25 +81,34 @@ struct SDLAudioRenderingNode final : Node
     void Reset(Context& context) override
     {
         Node::Reset(context);
-        m_mutex.lock();
-        for (auto mat : m_queue) { mat.release(); } m_queue.clear();
-        m_mutex.unlock();
+        // the callback is the ring consumer, stop it before touching the rings
+        SDL_CloseAudioDevice(m_audio_dev);
+        m_audio_dev = 0;
+        m_samples.Reset(0);
+        m_marks.Reset(0);
         m_buffer_available = true;
         m_BufferAvailable.SetValue(true);
         m_audio_callback_time = 0;
         m_current_pts = NAN;
-        m_Tick.SetValue(m_current_pts);
+        m_Tick.SetValue(m_current_pts.load());
         m_audio_sample_rate = 0;
         m_audio_channels = 0;
-        m_audio_data_type = IM_DT_FLOAT32;
         m_channel_levels.clear();
         m_channel_stack.clear();
         m_channel_count.clear();
         for (auto data : m_channel_wave_data) { if (data) free(data); data = nullptr; }
         m_channel_wave_data.clear();
-        SDL_ClearQueuedAudio(m_audio_dev);
-        SDL_CloseAudioDevice(m_audio_dev);
-        m_audio_dev = 0;
+    }
+
+    // the SDL callback only moves the atomics, readers of the outputs see them here
+    PinValue EvaluatePin(const Context& context, const Pin& pin, bool threading = false) const override
+    {
+        if (pin.m_ID == m_BufferAvailable.m_ID)
+            return m_buffer_available.load();
+        else if (pin.m_ID == m_Tick.m_ID)
+            return m_current_pts.load();
+        else
+            return Node::EvaluatePin(context, pin, threading);
     }
 
     void OnPause(Context& context) override 
@@ -104,7 +121,7 @@ struct SDLAudioRenderingNode final : Node
 
     void OnStop(Context& context) override 
     { 
-        if (m_audio_dev) { SDL_ClearQueuedAudio(m_audio_dev); SDL_PauseAudioDevice(m_audio_dev, 1); }
+        if (m_audio_dev) SDL_PauseAudioDevice(m_audio_dev, 1);
         for ( int i = 0; i < m_channel_levels.size(); i++) m_channel_levels[i] = 0;;
     }
 
@@ -121,26 +138,16 @@ struct SDLAudioRenderingNode final : Node
         }
         else if (entryPoint.m_ID == m_Enter.m_ID)
         {
-            m_mutex.lock();
             auto mat = context.GetPinValue<ImGui::ImMat>(m_Mat);
             if (!mat.empty())
             {
-                m_audio_sample_rate = mat.rate.num;
-                m_audio_channels = mat.c;
-                m_audio_samples = mat.w;
                 if (!m_audio_dev)
                 {
-                    SDL_AudioSpec wanted_spec, spec;
-                    wanted_spec.channels = m_audio_channels;
-                    wanted_spec.freq = m_audio_sample_rate;
-                    wanted_spec.format = AUDIO_F32SYS;//mat.type == IM_DT_FLOAT32 ? AUDIO_F32SYS : mat.type == IM_DT_INT32 ? AUDIO_S32SYS : AUDIO_S16SYS;
-                    wanted_spec.silence = 0;
-                    wanted_spec.samples = MAX(SDL_AUDIO_MIN_BUFFER_SIZE, 2 << log2_c(wanted_spec.freq / SDL_AUDIO_MAX_CALLBACKS_PER_SEC)); // mat.w ? 
-                    wanted_spec.callback = sdl_audio_callback;
-                    wanted_spec.userdata = this;
-                    m_audio_dev = SDL_OpenAudioDevice(NULL, 0, &wanted_spec, &spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_CHANNELS_CHANGE);
-                    if (m_audio_dev)
-                        SDL_PauseAudioDevice(m_audio_dev, 0);
+                    m_audio_sample_rate = mat.rate.num;
+                    m_audio_channels = mat.c;
+                    m_audio_samples = mat.w;
+                    m_samples.Reset((size_t)MAX_AUDIO_BUFFER * m_audio_samples * m_audio_channels);
+                    m_marks.Reset(MAX_AUDIO_BUFFER);
                     m_channel_levels.resize(m_audio_channels);
                     m_channel_stack.resize(m_audio_channels);
                     m_channel_count.resize(m_audio_channels);
@@ -148,26 +155,53 @@ struct SDLAudioRenderingNode final : Node
                     m_channel_wave_data.clear();
                     for (int i = 0; i < m_audio_channels; i++)
                     {
-                        float * data = (float *)malloc(m_audio_samples * sizeof(float));
+                        float * data = (float *)calloc(m_audio_samples, sizeof(float));
                         m_channel_wave_data.push_back(data);
                     }
-                    //m_audio_data_type = mat.type;
-                }
-                if (m_queue.size() < MAX_AUDIO_BUFFER)
-                {
-                    ImGui::ImMat data;
-                    data = mat;
-                    m_queue.push_back(data);
+                    SDL_AudioSpec wanted_spec, spec;
+                    wanted_spec.channels = m_audio_channels;
+                    wanted_spec.freq = m_audio_sample_rate;
+                    wanted_spec.format = AUDIO_F32SYS;
+                    wanted_spec.silence = 0;
+                    wanted_spec.samples = MAX(SDL_AUDIO_MIN_BUFFER_SIZE, 2 << log2_c(wanted_spec.freq / SDL_AUDIO_MAX_CALLBACKS_PER_SEC)); // mat.w ? 
+                    wanted_spec.callback = sdl_audio_callback;
+                    wanted_spec.userdata = this;
+                    // the ring holds the stream as it came in, let SDL convert rate and layout
+                    m_audio_dev = SDL_OpenAudioDevice(NULL, 0, &wanted_spec, &spec, 0);
+                    if (m_audio_dev)
+                        SDL_PauseAudioDevice(m_audio_dev, 0);
                 }
-                m_buffer_available = m_queue.size() < MAX_AUDIO_BUFFER;
-                m_BufferAvailable.SetValue(m_buffer_available);
+                if (mat.c == m_audio_channels)
+                    PushSamples(mat);
+                m_buffer_available = HasRoom();
+                m_BufferAvailable.SetValue(m_buffer_available.load());
+                m_Tick.SetValue(m_current_pts.load());
                 mat.release();
             }
-            m_mutex.unlock();
         }
         return {};
     }
 
+    // producer side, room for one more block of the current size
+    bool HasRoom() const
+    {
+        return m_marks.Writable() > 0 && m_samples.Writable() >= (size_t)m_audio_samples * m_audio_channels;
+    }
+
+    // interleave one block into the sample ring as float, a block that doesn't fit is dropped
+    void PushSamples(ImGui::ImMat& mat)
+    {
+        size_t count = (size_t)mat.w * mat.c;
+        if (count == 0 || m_marks.Writable() == 0 || m_samples.Writable() < count)
+            return;
+        AudioInterleaveMat(mat, m_block);
+        AudioMark mark;
+        mark.m_Pos = m_samples.WritePos();
+        mark.m_Pts = mat.time_stamp;
+        m_samples.Write(m_block.data(), count);
+        m_marks.Push(mark);
+    }
+
     bool CustomLayout() const override { return true; }
 
     bool DrawCustomLayout(ImGuiContext * ctx, float zoom, ImVec2 origin, ImGui::ImCurveEdit::keys * key) override
@@ -246,21 +280,22 @@ struct SDLAudioRenderingNode final : Node
     Pin* m_OutputPins[3] = { &m_Exit, &m_BufferAvailable, &m_Tick };
 
     SDL_AudioDeviceID m_audio_dev {0};
-    int64_t m_audio_callback_time {0};
-    double m_current_pts {NAN};
-    bool m_buffer_available {true};
+    std::atomic<int64_t> m_audio_callback_time {0};
+    std::atomic<double> m_current_pts {NAN};    // written by the SDL callback
+    std::atomic<bool> m_buffer_available {true};
     int m_audio_channels {0};
     int m_audio_sample_rate {0};
     int m_audio_samples {0};
     int m_view_type {0}; // 0 = levels 1 = wave data
-    ImDataType m_audio_data_type {IM_DT_FLOAT32};
     std::vector<int> m_channel_levels;
     std::vector<int> m_channel_stack;
     std::vector<int> m_channel_count;
     std::vector<float*> m_channel_wave_data;
 
-    std::vector<ImGui::ImMat>   m_queue;
-    std::mutex                  m_mutex;
+    // Execute produces, the SDL callback consumes, neither locks
+    SPSCRing<float>     m_samples;  // interleaved float PCM
+    SPSCRing<AudioMark> m_marks;    // one per pushed block, for the tick
+    std::vector<float>  m_block;    // producer scratch, one interleaved block
 };
 } // namespace BluePrint
 
@@ -285,111 +320,48 @@ static int calculate_audio_db(const T* data, int channels, int channel_index, si
     return static_cast<int>(rms + 0.5);
 }
 
+// Runs on the SDL audio thread: no locks and no allocations. Whatever part of
+// a block isn't played stays in the ring for the next callback.
 static void sdl_audio_callback(void *opaque, Uint8 *stream, int len)
 {
     BluePrint::SDLAudioRenderingNode * node = (BluePrint::SDLAudioRenderingNode *)opaque;
-    int audio_size, len1 = 0;
     node->m_audio_callback_time = ImGui::get_current_time_msec();
-    node->m_mutex.lock();
-    Uint8 * stream_data = stream;
-    while (len > 0)
+    int channels = node->m_audio_channels;
+    if (channels <= 0)
     {
-        if (node->m_queue.size() > 0)
-        {
-            auto mat = node->m_queue.at(0);
-            node->m_current_pts = mat.time_stamp;
-            int data_size = node->m_audio_data_type == IM_DT_FLOAT32 || node->m_audio_data_type == IM_DT_INT32 ? 4 : node->m_audio_data_type == IM_DT_INT16 ? 2 : 1;
-            for (int i = 0; i < mat.w; i++)
-            {
-                for (int c = 0; c < mat.c; c++)
-                {
-                    if (mat.type == IM_DT_FLOAT32)
-                    {
-                        if (c < node->m_channel_wave_data.size())
-                        {
-                            auto data = node->m_channel_wave_data[c];
-                            data[i] = mat.at<float>(i, 0, c);
-                            *(float *)stream_data = data[i];
-                        }
-                    }
-                    else if (mat.type == IM_DT_INT32)
-                    {
-                        if (c < node->m_channel_wave_data.size())
-                        {
-                            auto data = node->m_channel_wave_data[c];
-                            data[i] = mat.at<int32_t>(i, 0, c) / float(INT32_MAX);
-                             *(float *)stream_data = data[i];
-                        }
-                    }
-                    else if (mat.type == IM_DT_INT16)
-                    {
-                        if (c < node->m_channel_wave_data.size())
-                        {
-                            auto data = node->m_channel_wave_data[c];
-                            data[i] = mat.at<int16_t>(i, 0, c) / float(INT16_MAX);
-                             *(float *)stream_data = data[i];
-                        }
-                    }
-                    else
-                    {
-                        if (c < node->m_channel_wave_data.size())
-                        {
-                            auto data = node->m_channel_wave_data[c];
-                            data[i] = mat.at<Uint8>(i, 0, c) / float(INT8_MAX);
-                             *(float *)stream_data = data[i];
-                        }
-                    }
-                    stream_data += data_size;
-                    len -= data_size;
-                    len1 += data_size;
-                    if (len <= 0)
-                        break;
-                }
-                if (len <= 0)
-                    break;
-            }
-            mat.release();
-            node->m_queue.erase(node->m_queue.begin());
-            node->m_buffer_available = node->m_queue.size() < MAX_AUDIO_BUFFER;
-            node->m_BufferAvailable.SetValue(node->m_buffer_available);
-            node->m_Tick.SetValue(node->m_current_pts);
-        }
-        else
-        {
-            memset(stream_data, 0, len);
-            break;
-        }
+        memset(stream, 0, len);
+        return;
     }
-    for (int c = 0; c < node->m_audio_channels; c++)
+
+    // tick is the pts of the first sample played by this callback
+    size_t read_pos = node->m_samples.ReadPos();
+    const BluePrint::AudioMark* mark = nullptr;
+    while ((mark = node->m_marks.Peek(1)) && mark->m_Pos <= read_pos)
+        node->m_marks.Pop();
+    if ((mark = node->m_marks.Peek(0)) && mark->m_Pos <= read_pos && node->m_audio_sample_rate > 0)
+        node->m_current_pts = mark->m_Pts + (double)((read_pos - mark->m_Pos) / channels) / node->m_audio_sample_rate;
+
+    float * stream_data = (float *)stream;
+    size_t wanted = len / sizeof(float);
+    size_t got = node->m_samples.Read(stream_data, wanted);
+    if (got < wanted)
+        memset(stream_data + got, 0, (wanted - got) * sizeof(float));
+
+    node->m_buffer_available = node->HasRoom();
+
+    size_t frames = got / channels;
+    size_t wave = std::min(frames, (size_t)node->m_audio_samples);
+    for (int c = 0; c < channels; c++)
     {
         if (c < node->m_channel_levels.size())
+            node->m_channel_levels[c] = frames ? calculate_audio_db<float>(stream_data, channels, c, frames * channels, 1.0f) : 0;
+        if (c < node->m_channel_wave_data.size() && node->m_channel_wave_data[c])
         {
-            if (node->m_audio_data_type == IM_DT_FLOAT32)
-            {
-                float * audio_data = (float *)stream;
-                int sample_len = len1 / (sizeof(float) * node->m_audio_channels);
-                node->m_channel_levels[c] = calculate_audio_db<float>(audio_data, node->m_audio_channels, c, sample_len, 1.0f);
-            }
-            else if (node->m_audio_data_type == IM_DT_INT32)
-            {
-                int32_t * audio_data = (int32_t *)stream;
-                int sample_len = len1 / (sizeof(int32_t) * node->m_audio_channels);
-                node->m_channel_levels[c] = calculate_audio_db<int32_t>(audio_data, node->m_audio_channels, c, sample_len, (float)(INT32_MAX));
-            }
-            else if (node->m_audio_data_type == IM_DT_INT16)
-            {
-                short * audio_data = (short *)stream;
-                int sample_len = len1 / (sizeof(short) * node->m_audio_channels);
-                node->m_channel_levels[c] = calculate_audio_db<short>(audio_data, node->m_audio_channels, c, sample_len, (float)(INT16_MAX));
-            }
-            else if (node->m_audio_data_type == IM_DT_INT8)
-            {
-                int8_t * audio_data = (int8_t *)stream;
-                int sample_len = len1 / (sizeof(int8_t) * node->m_audio_channels);
-                node->m_channel_levels[c] = calculate_audio_db<int8_t>(audio_data, node->m_audio_channels, c, sample_len, (float)(INT8_MAX));
-            }
+            auto data = node->m_channel_wave_data[c];
+            const float * src = stream_data + (frames - wave) * channels + c;
+            for (size_t i = 0; i < wave; i++)
+                data[i] = src[i * channels];
         }
     }
-    node->m_mutex.unlock();
 }
-#endif // SDK_WITH_SDL2
\ No newline at end of file
+#endif // SDK_WITH_SDL2
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
 #include "ALM_vulkan.h"
@@ -109,6 +111,8 @@ struct AlmNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
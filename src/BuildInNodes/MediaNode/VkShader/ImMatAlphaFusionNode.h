@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct AlphaFusionNode final : Node
     ~AlphaFusionNode()
     {
         if (m_alpha) { delete m_alpha; m_alpha = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -71,6 +73,8 @@ struct AlphaFusionNode final : Node
     bool CustomLayout() const override { return false; }
     bool Skippable() const override { return true; }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -96,7 +100,7 @@ struct AlphaFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue3a5"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -124,13 +128,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 51906;
-    const unsigned int logo_data[51908/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 51906;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[51908/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1213,6 +1219,8 @@ private:
     0xffa70afe, 0xa12be200, 0x29a97327, 0x6dd8f35c, 0x6ec3beed, 0x3189887c, 0xa5073baf, 0xa1095f74, 0x782e7e81, 0x0fc61023, 0x218fe5f6, 0x25fcfc47, 
     0x4fc21f4f, 0x1192fd1e, 0x4f0800ff, 0x5123f288, 0x8f9bec8f, 0x7b2bf74f, 0x9fc25fe1, 0x577cdb1c, 0x78d364f0, 0x4331c433, 0xef64b71e, 0xaa53e923, 
     0x92d089aa, 0x07004c49, 0xdc49e97a, 0x3f778aea, 0x1f03d9ff, 
-};
+        };
+        return logo_data;
+    }
 };
 } // namespace BluePrint
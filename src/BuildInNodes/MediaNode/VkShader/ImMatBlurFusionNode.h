@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct BlurFusionNode final : Node
     ~BlurFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -90,6 +92,8 @@ struct BlurFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -129,7 +133,7 @@ struct BlurFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue427"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -159,13 +163,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 41615;
-    const unsigned int logo_data[41616/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 41615;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[41616/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1033,7 +1039,9 @@ private:
     0x23c7abf0, 0xe053b54e, 0x228210cf, 0x5cf64740, 0x8afd83fe, 0xa3f073ab, 0xf03847c7, 0xfd4f885f, 0x00ffa7c2, 0x27a12be2, 0x5c29ad73, 0xedadc8f3, 
     0x7c6ec5fe, 0x5c63b288, 0xbad283fc, 0x40b1842f, 0x117c17bf, 0xfb076388, 0x8fa2c776, 0x9e4af8f9, 0x3d7e843f, 0xf88f7016, 0x91477c42, 0x647f8c1a, 
     0xb97f7adc, 0xfe0adf5b, 0xdbe6f814, 0x2683bfe2, 0x219ec19b, 0xbbf5188a, 0x4a1f7927, 0x4e14559d, 0x704a9284, 0x295def00, 0x4e519d3b, 0x00d9ffe7, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct BookFlipFusionNode final : Node
     ~BookFlipFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -71,6 +73,8 @@ struct BookFlipFusionNode final : Node
     bool CustomLayout() const override { return false; }
     bool Skippable() const override { return true; }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -96,7 +100,7 @@ struct BookFlipFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue0e0"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -124,13 +128,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 59497;
-    const unsigned int logo_data[59500/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 59497;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[59500/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1371,7 +1377,9 @@ private:
     0x789ca3e3, 0xe927c42f, 0x00ff4fa5, 0x4e4257c4, 0xb95252e7, 0x5b5b91e7, 0xf9dc867d, 0x5e631211, 0xe84a0f76, 0x024313be, 0x46f05cfc, 0xed1f8c21, 
     0x8f421ecb, 0xb14af8f9, 0x1e4fc21f, 0xff1192fd, 0x884f0800, 0x8f5123f2, 0x4f8f9bec, 0xe17b2bf7, 0x1c9fc267, 0xf0577cdb, 0x3378d364, 0x1e4331c4, 
     0x23ef64b7, 0xaaaa53e9, 0x4992d089, 0x7a07004c, 0x3a778ae8, 0xffcf9da2, 0x000000d9, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct BounceFusionNode final : Node
     ~BounceFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct BounceFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -143,7 +147,7 @@ struct BounceFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf2d0"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -174,13 +178,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 57860;
-    const unsigned int logo_data[57860/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 57860;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[57860/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1387,7 +1393,9 @@ private:
     0x2f752a74, 0x95923ab3, 0xde8635cf, 0xe736ecdb, 0x1a9388c8, 0x577ab0f3, 0x189af045, 0x82e7e217, 0xff600c31, 0xf2586e00, 0xc2cf7f14, 0x1bf88856, 
     0x23282ef1, 0x781efe89, 0x0a4524ad, 0xc825dac8, 0x11e4402a, 0x16beb7b2, 0x8df8157c, 0xc157f16b, 0x03f813b7, 0xc5db10c5, 0x244959ad, 0x2ad768b2, 
     0x2574a2a8, 0x00802989, 0x9c0a5def, 0xa23ab3ef, 0xd9ffcf9d, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct BurnFusionNode final : Node
     ~BurnFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -84,6 +86,8 @@ struct BurnFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -119,7 +123,7 @@ struct BurnFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf1fd"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -148,13 +152,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 51865;
-    const unsigned int logo_data[51868/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 51865;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[51868/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1236,7 +1242,9 @@ private:
     0xc7393a3e, 0x7e42fc82, 0x00ff549a, 0xa47445fc, 0x2ba574ee, 0xbd15799e, 0x3eb7b2b9, 0xae315944, 0x5de9417e, 0x6068c21f, 0x089e8b5f, 0xfd8331c4, 
     0x51c863b9, 0x093f00ff, 0x8ff04553, 0x11cea2c7, 0x4f0800ff, 0x5123f288, 0x8f9bec8f, 0x7f2bf74f, 0x9fc25fe1, 0x577cdb1c, 0x78d364f0, 0x4331c433, 
     0xef64b71e, 0xaa53e923, 0x92d089aa, 0x07004c49, 0x7327dd7a, 0xffdc29aa, 0xc000ffd9, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,10 +1,10 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
 #include <ChromaKey_vulkan.h>
-#include <imgui_node_editor_internal.h>
-namespace edd = ax::NodeEditor::Detail;
 
 namespace BluePrint
 {
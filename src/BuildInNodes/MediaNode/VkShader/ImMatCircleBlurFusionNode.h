@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct CircleBlurFusionNode final : Node
     ~CircleBlurFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -92,6 +94,8 @@ struct CircleBlurFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -131,7 +135,7 @@ struct CircleBlurFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf140"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -161,13 +165,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 58785;
-    const unsigned int logo_data[58788/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 58785;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[58788/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1393,7 +1399,9 @@ private:
     0x03c7cf65, 0x73a98afd, 0x47c7a3f0, 0x885ff038, 0x9f4ad34f, 0xae8800ff, 0x94ce9d84, 0x21cf73a5, 0x0dfbb6b6, 0x2422f2b9, 0x07f9b9c6, 0x095f74a5, 
     0x2e7e81a1, 0xc6102378, 0x8fe5f60f, 0xfcfc4721, 0xc2174f25, 0x388b1e3f, 0x3e21fc07, 0x468dc823, 0x3d6eb23f, 0xefaddc3f, 0x7c0a9f85, 0x5ff16d73, 
     0xe04d93c1, 0x0cc510cf, 0xbc93dd7a, 0xaa4ea58f, 0x494227aa, 0x1d003025, 0x7327a1eb, 0xffdc29ae, 0x00ff8bd9, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
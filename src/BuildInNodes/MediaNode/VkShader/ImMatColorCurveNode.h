@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 //#include <imgui_extra_widget.h>
 #include <imgui_spline.h>
@@ -445,6 +447,8 @@ struct ColorCurveNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
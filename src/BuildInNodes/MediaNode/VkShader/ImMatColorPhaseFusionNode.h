@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct ColorPhaseFusionNode final : Node
     ~ColorPhaseFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -90,6 +92,8 @@ struct ColorPhaseFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -135,7 +139,7 @@ struct ColorPhaseFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue162"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -165,13 +169,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 58268;
-    const unsigned int logo_data[58268/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 58268;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[58268/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1386,7 +1392,9 @@ private:
     0xcfe053b5, 0x40228210, 0xfc5cf647, 0xaad83f70, 0x3c0a3f97, 0x058f7374, 0x34fd84f8, 0xf800ffa9, 0xdc49e88a, 0x3c574ae9, 0x6f6b1bf2, 0x229fdbb0, 
     0x9f6b4c22, 0x45577a90, 0x17189af0, 0x3182e7e2, 0x00ff600c, 0x14f2586e, 0x54c2cf7f, 0xf1237cf1, 0x7f80b3e8, 0x3ce213c2, 0xfb63d488, 0xfdd3e326, 
     0x59f8deca, 0x36c7a7f0, 0x19fc15df, 0xf10cde34, 0xadc7500c, 0xfac83bd9, 0xa2aaea54, 0x53922474, 0xbade0100, 0xe23a7712, 0xd9ffcf9d, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
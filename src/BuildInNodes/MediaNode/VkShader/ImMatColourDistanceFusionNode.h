@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct ColourDistanceFusionNode final : Node
     ~ColourDistanceFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -86,6 +88,8 @@ struct ColourDistanceFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -118,7 +122,7 @@ struct ColourDistanceFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf391"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -148,13 +152,15 @@ private:
     mutable int m_logo_index {0};
 
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 63718;
-    const unsigned int logo_data[63720/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 63718;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[63720/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1483,7 +1489,9 @@ private:
     0x09f10b1e, 0xff5369fa, 0xd015f100, 0x94d4b993, 0x36dc79ae, 0xb761dfd6, 0x9388673f, 0x7ab0f31a, 0x9af04757, 0xe7e21718, 0x600c3182, 0x586e00ff, 
     0xcf7f14f2, 0x7cd154c2, 0xb3e8f124, 0x13c27f80, 0xd4883ce2, 0xe326fb63, 0xdecafdd3, 0xa7f059f8, 0x15df36c7, 0xde3419fc, 0x500cf10c, 0x3bd9ad47, 
     0xea54fac8, 0x2474a2aa, 0x01005392, 0x7712bade, 0xcf9da23a, 0xcce2d9ff, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -116,6 +116,8 @@ struct MatCropNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
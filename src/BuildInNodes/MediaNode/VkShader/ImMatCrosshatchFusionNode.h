@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct CrosshatchFusionNode final : Node
     ~CrosshatchFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -90,6 +92,8 @@ struct CrosshatchFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -129,7 +133,7 @@ struct CrosshatchFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue9ef"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -159,13 +163,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 91801;
-    const unsigned int logo_data[91804/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 91801;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[91804/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -2079,7 +2085,9 @@ private:
     0x0b1ee7e8, 0x69fa09f1, 0xf100ff53, 0xb993d015, 0x79ae94d2, 0xdfd636e4, 0x443eb761, 0x3fd79844, 0x8baef420, 0x2f3034e1, 0x6204cfc5, 0xdcfec118, 
     0xff28e4b1, 0xa9849f00, 0xe347f8e2, 0xff0067d1, 0xc4278400, 0xc7a81179, 0xa7c74df6, 0xf0bd95fb, 0x8e4fe1b3, 0xf82bbe6d, 0x19bc6932, 0x8fa118e2, 
     0x9177b25b, 0x55d5a9f4, 0x2449e844, 0xbd0300a6, 0x75ee2474, 0xff9f3bc5, 0x000000d9, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct CubeFusionNode final : Node
     ~CubeFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -98,6 +100,8 @@ struct CubeFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -151,7 +155,7 @@ struct CubeFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf6d1"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -183,13 +187,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 72655;
-    const unsigned int logo_data[72656/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 72655;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[72656/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1704,7 +1710,9 @@ private:
     0x09854940, 0xf2f35a3e, 0x73ab6a8f, 0xc5096865, 0xecf73fac, 0xfeda5654, 0xaa75ba9e, 0xcb60fb1b, 0xcb0c0212, 0xea3d7090, 0x60bbc6ad, 0xb9edc5d9, 
     0xe3bf4afa, 0xe74a095d, 0x54ae8c4a, 0xecdbde86, 0x88c8e736, 0xb0f31a93, 0xad66567a, 0x71650b14, 0xf2c128b6, 0xf42804db, 0x6dd5a3a9, 0xdc20a445, 
     0x318a90c3, 0xcd4a0fe6, 0x2408b5d4, 0x685699b6, 0x002094d8, 0x22bad2c3, 0xa7b8ce9d, 0xebd9ff73, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
 #include "DeBand_vulkan.h"
@@ -118,6 +120,8 @@ struct DeBandNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct DoorFusionNode final : Node
     ~DoorFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct DoorFusionNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -133,7 +137,7 @@ struct DoorFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue8ea"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -163,13 +167,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 58365;
-    const unsigned int logo_data[58368/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 58365;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[58368/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1386,7 +1392,9 @@ private:
     0xe053b54d, 0x228210cf, 0x5cf64740, 0xd83f70fc, 0x0a3f97aa, 0x8f73743c, 0xfd84f805, 0x00ffa934, 0x49e88af8, 0x574ae9dc, 0x6b1bf23c, 0x9fdbb06f, 
     0x6b4c2222, 0x577a909f, 0x189af045, 0x82e7e217, 0xff600c31, 0xf2586e00, 0xc2cf7f14, 0x237cf154, 0x80b3e8f1, 0xe213c27f, 0x63d4883c, 0xd3e326fb, 
     0xf8decafd, 0xc7a7f059, 0xfc15df36, 0x0cde3419, 0xc7500cf1, 0xc83bd9ad, 0xaaea54fa, 0x922474a2, 0xde010053, 0x3a7712ba, 0xffcf9de2, 0xe0718ed9, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
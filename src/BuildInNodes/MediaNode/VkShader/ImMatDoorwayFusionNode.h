@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct DoorwayFusionNode final : Node
     ~DoorwayFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct DoorwayFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -140,7 +144,7 @@ struct DoorwayFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue8eb"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -171,13 +175,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 59738;
-    const unsigned int logo_data[59740/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 59738;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[59740/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1423,7 +1429,9 @@ private:
     0x8ff2f35a, 0x6573ab6a, 0xacc50968, 0x54ecf73f, 0x9efeda56, 0x1baa75ba, 0x12cb60fb, 0x90cb0c02, 0xadea3d70, 0xd960bbc6, 0xfab9edc5, 0x5de3bf4a, 
     0x4ae74a09, 0x8654ae8c, 0x36ecdbde, 0x9388c8e7, 0x7ab0f31a, 0x14ad6656, 0xb671650b, 0xdbf2c128, 0xa9f42804, 0x456dd5a3, 0xc3dc20a4, 0xe6318a90, 
     0xd4cd4a0f, 0xb62408b5, 0xd8685699, 0xc3002094, 0x9d22bad2, 0x73a7b8ce, 0x64b7d9ff, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
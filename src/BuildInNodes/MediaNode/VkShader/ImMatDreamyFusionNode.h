@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct DreamyFusionNode final : Node
     ~DreamyFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -71,6 +73,8 @@ struct DreamyFusionNode final : Node
     bool CustomLayout() const override { return false; }
     bool Skippable() const override { return true; }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -96,7 +100,7 @@ struct DreamyFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf773"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -124,13 +128,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 58555;
-    const unsigned int logo_data[58556/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 58555;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[58556/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1351,7 +1357,9 @@ private:
     0xf10c3e55, 0x04242208, 0xc7cf657f, 0xa98afd03, 0xc7a7f073, 0x5ff03847, 0x4ad34f88, 0x8800ff9f, 0xce9d84ae, 0xcf73a594, 0xfbb7b721, 0x22f2b90d, 
     0x807f8dc9, 0xf047577a, 0xe217189a, 0x0c3182e7, 0x6e00ff60, 0x7f14f258, 0xd154c2cf, 0xe8f1237c, 0xc27f80b3, 0x883ce213, 0x26fb63d4, 0xcafdd3e3, 
     0xf059f8de, 0xdf36c7a7, 0x3419fc15, 0x0cf10cde, 0xd9adc750, 0x54fac83b, 0x74a2aaea, 0x00539224, 0x12bade01, 0x9de23a77, 0xfad9ffcf, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
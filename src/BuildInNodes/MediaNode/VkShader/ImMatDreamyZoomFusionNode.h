@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct DreamyZoomFusionNode final : Node
     ~DreamyZoomFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -90,6 +92,8 @@ struct DreamyZoomFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -129,7 +133,7 @@ struct DreamyZoomFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf3e1"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -159,13 +163,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 48272;
-    const unsigned int logo_data[48272/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 48272;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[48272/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1172,7 +1178,9 @@ private:
     0xcf553cc8, 0xa9415806, 0xd6c3e778, 0x42d7688f, 0x8db653e7, 0x5d3886a1, 0x8d2adde5, 0x5b1e66a1, 0x9300ce31, 0xe3e6e7e5, 0xbbf44d35, 0x84290beb, 
     0xdf1617f6, 0x5c5a9462, 0x7932b0f9, 0x23df7c33, 0x7cac0de4, 0x83d30eb9, 0x1a1cb7f2, 0xf80dbeea, 0xb7bac457, 0x6a0b0fc4, 0x35863ffa, 0xd3ce768d, 
     0xfa2eb55b, 0xa548a375, 0xa6d85892, 0xc15684f3, 0x0c94791f, 0xd71c4882, 0x5ca7564c, 0xd9ffa756, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct FadeFusionNode final : Node
     ~FadeFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -96,6 +98,8 @@ struct FadeFusionNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -138,7 +142,7 @@ struct FadeFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue3e8"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -168,13 +172,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 37387;
-    const unsigned int logo_data[37388/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 37387;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[37388/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -954,7 +960,9 @@ private:
     0x10dfe053, 0x47402202, 0x70fc5cf6, 0xb7aad83f, 0x747c0a3f, 0xf8058f73, 0xa934fd84, 0x8af800ff, 0xeadc49e8, 0xf23c574a, 0xb06f7b1b, 0x22229fdb, 
     0xc1ce6b4c, 0xc2175de9, 0x8b5f6068, 0x31c4089e, 0x63b9fd83, 0x00ff51c8, 0xc753093f, 0xbfc793f0, 0xc27f8464, 0x883ce213, 0x26fb63d4, 0xcafdd3e3, 
     0xf057f8de, 0xdf36c7a7, 0x3419fc15, 0x0cf10cde, 0xd9adc750, 0x54fac83b, 0x74a2aaea, 0x00539224, 0x52bade01, 0x9da23a77, 0xe6d9ffcf, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct FlyeyeFusionNode final : Node
     ~FlyeyeFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct FlyeyeFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -126,7 +130,7 @@ struct FlyeyeFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf00a"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -157,13 +161,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 55292;
-    const unsigned int logo_data[55292/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 55292;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[55292/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1316,7 +1322,9 @@ private:
     0x3e55db34, 0x2200f10d, 0x657f0424, 0xfd03c7cf, 0xf073ab8a, 0x3847c7a7, 0x4f885ff0, 0xff9f4ad3, 0x84ae8800, 0xa5a4ce9d, 0xb721cf73, 0xb90dfbb6, 
     0xc62422f2, 0x951eecbc, 0x86267cd1, 0xe0b9f805, 0x3f18438c, 0x853c96db, 0x95f0f31f, 0x3c097f3c, 0x4748f67b, 0x233e21fc, 0x3f468dc8, 0x3f3d6eb2, 
     0x85efaddc, 0x737c0a7f, 0xc15ff16d, 0xcfe04d93, 0x7a0cc510, 0x8fbc93dd, 0xaaaa4ea5, 0x25494227, 0xeb1d0030, 0xaa7327a5, 0xd9ffdc29, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct GridFlipFusionNode final : Node
     ~GridFlipFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -110,6 +112,8 @@ struct GridFlipFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -180,7 +184,7 @@ struct GridFlipFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf37f"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -214,13 +218,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 71366;
-    const unsigned int logo_data[71368/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 71366;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[71368/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1708,7 +1714,9 @@ private:
     0xfb232011, 0x1f387e2e, 0x9f5b55ec, 0x393a3e85, 0x42fc82c7, 0xff549a7e, 0x7445fc00, 0x2575ee24, 0x0d799e2b, 0x6dd8b7bd, 0x261191cf, 0xf460e735, 
     0x34e18bae, 0xcfc52f30, 0xc1186204, 0xe4b1dcfe, 0x9f00ff28, 0xf8e3a984, 0xb2dfe349, 0x09e13f42, 0x6a441ef1, 0x7193fd31, 0x6fe5fee9, 0x53f82b7c, 
     0x8a6f9be3, 0x6f9a0cfe, 0x28867806, 0x9decd663, 0x752a7de4, 0x123a5155, 0x00802949, 0x3b295def, 0xe74e519d, 0xc3f8d9ff, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
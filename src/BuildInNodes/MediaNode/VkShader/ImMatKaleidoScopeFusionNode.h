@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct KaleidoScopeFusionNode final : Node
     ~KaleidoScopeFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct KaleidoScopeFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -140,7 +144,7 @@ struct KaleidoScopeFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf2b0"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -171,13 +175,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 54126;
-    const unsigned int logo_data[54128/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 54126;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[54128/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1306,7 +1312,9 @@ private:
     0xa52af60f, 0x1d8fc2cf, 0x7ec1e31c, 0x2a4d3f21, 0xba22fe7f, 0x523a7712, 0x863ccf95, 0x36ecdbda, 0x9388c8e7, 0x1ee4e71a, 0x267cd195, 0xb9f80586, 
     0x18438ce0, 0x3c96db3f, 0xf0f31f85, 0x085f3c95, 0xe02c7afc, 0xf884f01f, 0x1835228f, 0xf4b8c9fe, 0xb77200ff, 0x297c16be, 0xc5b7cdf1, 0x374d067f, 
     0x14433c83, 0x4e76eb31, 0x3a953ef2, 0x099da8aa, 0x00c09424, 0x9d84ae77, 0x73a7b8ce, 0x8991d9ff, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
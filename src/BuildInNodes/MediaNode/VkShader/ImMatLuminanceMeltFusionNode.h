@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct LuminanceMeltFusionNode final : Node
     ~LuminanceMeltFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct LuminanceMeltFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -140,7 +144,7 @@ struct LuminanceMeltFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue1b8"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -171,13 +175,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 69585;
-    const unsigned int logo_data[69588/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 69585;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[69588/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1628,7 +1634,9 @@ private:
     0xfe81e3e7, 0xf8b955c5, 0x9ca3e353, 0x27c42f78, 0xff4fa5e9, 0x4257c400, 0x5252e74e, 0xdb90e7b9, 0xdc867ddb, 0x631211f9, 0x4a0f765e, 0x4313bee8, 
     0xf05cfc02, 0x1f8c2146, 0x421ecbed, 0x4af8f98f, 0x9e843f9e, 0x2324fb3d, 0x119f10fe, 0x1fa346e4, 0x9f1e37d9, 0xc2f756ee, 0x393e85bf, 0xe0aff8b6, 
     0x67f0a6c9, 0x3d866288, 0x47dec96e, 0x5555a7d2, 0x9224a113, 0xf50e0098, 0xd5b993d2, 0xff7fee14, 0xc715fed9, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
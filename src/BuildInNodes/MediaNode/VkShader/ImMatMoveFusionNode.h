@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct MoveFusionNode final : Node
     ~MoveFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -90,6 +92,8 @@ struct MoveFusionNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -122,7 +126,7 @@ struct MoveFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue883"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -151,13 +155,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 56491;
-    const unsigned int logo_data[56492/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 56491;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[56492/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1335,7 +1341,9 @@ private:
     0x8908403c, 0x73d91f01, 0x00ffc0f1, 0xfcdcaa62, 0xced1f129, 0x13e2173c, 0xa97000ff, 0x8af800ff, 0x3a7751e8, 0x0ace5dd4, 0x6f617119, 0x5fb3fccf, 
     0xc0975de5, 0xfee2bf49, 0xff19357c, 0x4c9b9900, 0xa8d200ff, 0x097f84ea, 0x48f67b3c, 0x3e21fc47, 0x468dc822, 0xf467b23f, 0xba7200ff, 0x0b9f81df, 
     0xf1636f7c, 0xd5d5e1d3, 0xfbb583cf, 0x493c586b, 0xd22c49a7, 0x46aa73e9, 0xcc32ea82, 0x000053cc, 0xfcd62409, 0xae1c9dbb, 0x30d9ffcc, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct PixelizeFusionNode final : Node
     ~PixelizeFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -90,6 +92,8 @@ struct PixelizeFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -129,7 +133,7 @@ struct PixelizeFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue3ea"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -159,13 +163,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 43007;
-    const unsigned int logo_data[43008/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 43007;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[43008/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1062,7 +1068,9 @@ private:
     0x6dba72bc, 0x78069faa, 0x02121184, 0xe3e7b23f, 0x54c5fe81, 0xe351f8b9, 0x2f789ca3, 0xa5e927c4, 0xc400ff4f, 0xe74e4257, 0xe7b9524a, 0x7d5bdb90, 
     0x11f9dc86, 0xfc5c6312, 0x2fbad283, 0xbfc0d084, 0x88113c17, 0x72fb0763, 0xfea390c7, 0x8ba7127e, 0x458f1fe1, 0x10fe039c, 0x46e4119f, 0x37d91fa3, 
     0x56ee9f1e, 0x85cfc2f7, 0xf8b6393e, 0xa6c9e0af, 0x628867f0, 0xc96e3d86, 0xa7d247de, 0xa1135555, 0x00989224, 0x93d0f50e, 0xee14d7b9, 0x25d9ff7f, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct PolarFusionNode final : Node
     ~PolarFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -86,6 +88,8 @@ struct PolarFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -118,7 +122,7 @@ struct PolarFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf666"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -147,13 +151,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 64880;
-    const unsigned int logo_data[64880/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 64880;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[64880/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1506,7 +1512,9 @@ private:
     0xfb078e9f, 0xe1e75615, 0x718e8e4f, 0x9f10bfe0, 0xff3f95a6, 0x095d1100, 0x4a499d3b, 0x6f439ee7, 0x731bf66d, 0x8d4944e4, 0x2b3dd879, 0x0c4df8a2, 
     0xc173f10b, 0x7f308618, 0x0a792cb7, 0x2ae1e73f, 0x7812fe78, 0x8f90ecf7, 0x477c42f8, 0x7f8c1a91, 0x7f7adc64, 0x0adf5bb9, 0xe6f814fe, 0x83bfe2db, 
     0x9ec19b26, 0xf5188a21, 0x1f7927bb, 0x54559d4a, 0x4a92844e, 0xd73b0060, 0x54e74e4a, 0xd9ffb953, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct RotateScaleFusionNode final : Node
     ~RotateScaleFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -96,6 +98,8 @@ struct RotateScaleFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -145,7 +149,7 @@ struct RotateScaleFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\uf2dd"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -176,13 +180,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 47890;
-    const unsigned int logo_data[47892/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 47890;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[47892/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1181,7 +1187,9 @@ private:
     0x5ff03847, 0x4ad34f88, 0x8800ff9f, 0xce9d94ae, 0xcf73a5a4, 0x2c89612d, 0x3d8a5622, 0xd1fd0aca, 0x50873df4, 0x748dbd3e, 0x6d040a9f, 0xf9c06ff1, 
     0x6cd73845, 0x131cc888, 0xdba79970, 0xe7f124fc, 0x82cfa1d8, 0x404848bc, 0xe0266d3e, 0xb602fd1f, 0x1ffc1c7e, 0x13dfb4f1, 0x5e97243c, 0xbd2df10d, 
     0x82f66aa3, 0xb94f9369, 0x729ec684, 0xa822616e, 0xb8938129, 0x47504710, 0xdc49e85a, 0xcf5d8ceb, 0xb35bd9ff, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
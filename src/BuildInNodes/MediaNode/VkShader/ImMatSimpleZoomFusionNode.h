@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct SimpleZoomFusionNode final : Node
     ~SimpleZoomFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -86,6 +88,8 @@ struct SimpleZoomFusionNode final : Node
         return m_Enabled ? changed : false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -118,7 +122,7 @@ struct SimpleZoomFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue8c4"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -147,13 +151,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 44064;
-    const unsigned int logo_data[44064/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 44064;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[44064/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1072,7 +1078,9 @@ private:
     0xdaa691e3, 0x886ff0a9, 0x23201101, 0x387e2efb, 0x4b55ec1f, 0x3a3e859f, 0xfc82c739, 0x549a7e42, 0x45fc00ff, 0x75ee2474, 0x799e2b25, 0xd8bfbd15, 
     0x7100ffad, 0x936b4c16, 0x47577ab0, 0x17189af0, 0x3182e7e2, 0x00ff600c, 0x14f2586e, 0x54c2cf7f, 0xf1237cd1, 0x7f84b4e8, 0x3ce213c2, 0xec8f5184, 
     0xf74f8f9b, 0x67e17f2b, 0xdb1c9fc2, 0x64f0577c, 0xc43378d3, 0xb71e4331, 0xe923ef64, 0x89aaaa53, 0x4c4992d0, 0xe87a0700, 0xa23a778a, 0xd9ffcf9d, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
@@ -1,4 +1,6 @@
-#include <UI.h>
+#include <BluePrint.h>
+#include <Node.h>
+#include <Pin.h>
 #include <imgui_json.h>
 #include <imgui_extra_widget.h>
 #include <ImVulkanShader.h>
@@ -14,7 +16,7 @@ struct SliderFusionNode final : Node
     ~SliderFusionNode()
     {
         if (m_fusion) { delete m_fusion; m_fusion = nullptr; }
-        if (m_logo) { ImGui::ImDestroyTexture(m_logo); m_logo = nullptr; }
+        if (m_logo) { Node::ReleaseNodeLogo(m_logo); m_logo = nullptr; }
     }
 
     void Reset(Context& context) override
@@ -94,6 +96,8 @@ struct SliderFusionNode final : Node
         return changed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -133,7 +137,7 @@ struct SliderFusionNode final : Node
     {
         if (ctx) ImGui::SetCurrentContext(ctx); // External Node must set context
         // if show icon then we using u8"\ue882"
-        if (!m_logo) m_logo = Node::LoadNodeLogo((void *)logo_data, logo_size);
+        if (!m_logo) m_logo = Node::AcquireNodeLogo(GetLogoData(), logo_size);
         Node::DrawNodeLogo(m_logo, m_logo_index, logo_cols, logo_rows, size);
     }
 
@@ -163,13 +167,15 @@ private:
     mutable ImTextureID  m_logo {nullptr};
     mutable int m_logo_index {0};
 
-    const unsigned int logo_width = 128;
-    const unsigned int logo_height = 80;
-    const unsigned int logo_cols = 4;
-    const unsigned int logo_rows = 4;
-    const unsigned int logo_size = 61771;
-    const unsigned int logo_data[61772/4] =
-{
+    static const unsigned int logo_width = 128;
+    static const unsigned int logo_height = 80;
+    static const unsigned int logo_cols = 4;
+    static const unsigned int logo_rows = 4;
+    static const unsigned int logo_size = 61771;
+    static const unsigned int * GetLogoData()
+    {
+        static const unsigned int logo_data[61772/4] =
+        {
     0xe0ffd8ff, 0x464a1000, 0x01004649, 0x01000001, 0x00000100, 0x8400dbff, 0x02020300, 0x03020203, 0x04030303, 0x05040303, 0x04050508, 0x070a0504, 
     0x0c080607, 0x0b0c0c0a, 0x0d0b0b0a, 0x0d10120e, 0x0b0e110e, 0x1016100b, 0x15141311, 0x0f0c1515, 0x14161817, 0x15141218, 0x04030114, 0x05040504, 
     0x09050509, 0x0d0b0d14, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 0x14141414, 
@@ -1457,7 +1463,9 @@ private:
     0x0d3e55db, 0x242200f1, 0xcf657f04, 0x8afd03c7, 0xa7f073ab, 0xf03847c7, 0xd34f885f, 0x00ff9f4a, 0x9d84ae88, 0x73a5a4ce, 0xb6b721cf, 0xf2b90dfb, 
     0xbcc62422, 0xd1951eec, 0x0586267c, 0x8ce0b9f8, 0xdb3f1843, 0x1f853c96, 0x3c95f0f3, 0x7b3c097f, 0xfc4748f6, 0xc8233e21, 0xb23f468d, 0xdc3f3d6e, 
     0x7f85efad, 0x6d737c0a, 0x93c15ff1, 0x10cfe04d, 0xdd7a0cc5, 0xa58fbc93, 0x27aaaa4e, 0x30254942, 0xa5eb1d00, 0x29aa7327, 0x4dd9ffdc, 
-};
+        };
+        return logo_data;
+    }
 
 };
 } // namespace BluePrint
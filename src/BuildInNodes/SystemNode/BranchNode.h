@@ -18,6 +18,8 @@ struct BranchNode final : Node
             return m_False;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
@@ -128,6 +128,8 @@ struct ComparatorNode final : Node
         return false;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
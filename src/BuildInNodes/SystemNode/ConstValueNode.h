@@ -153,6 +153,8 @@ struct ConstValueNode final : Node
         m_pintype = type;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -53,6 +53,8 @@ struct CountNode final : Node
         ImGui::TextUnformatted("Accumulate"); ImGui::SameLine(0.f, 100.f); ImGui::ToggleButton("##toggle_acc", &m_Accumulate);
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -25,6 +25,8 @@ struct FlipFlopNode final : Node
             return m_B;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
@@ -39,6 +39,8 @@ struct LoopNode final : Node
         return m_Completed;
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
@@ -78,6 +78,8 @@ struct TimerNode final : Node
         ImGui::InputInt("Timer count", &m_count);
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
@@ -160,6 +160,8 @@ struct ToStringNode final : Node
             SetType(PinType::Any);
     }
 
+    bool ParallelLoad() const override { return true; }   // Load only parses its own json
+
     int Load(const imgui_json::value& value) override
     {
         int ret = BP_ERR_NONE;
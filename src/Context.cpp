@@ -316,8 +316,10 @@ void Context::ShowFlow()
     {
         return;
     }
-    ed::PushStyleVar(ed::StyleVar_FlowMarkerDistance, 30.0f);
-    ed::PushStyleVar(ed::StyleVar_FlowDuration, 1.0f);
+    if (!Editor::BeginFlow())
+    {
+        return;
+    }
     if (m_PrevNode)
     {
         for (auto pin : m_PrevNode->GetOutputPins())
@@ -332,11 +334,11 @@ void Context::ShowFlow()
             }
             if (!link || link->m_Node != m_CurrentNode)
                 continue;
-            ed::Flow(pin->m_ID, pin->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
+            Editor::Flow(pin->m_ID, pin->GetType() == PinType::Flow);
             link = pin->GetLink();
             while (link && link->IsMappedPin())
             {
-                ed::Flow(link->m_ID, link->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
+                Editor::Flow(link->m_ID, link->GetType() == PinType::Flow);
                 link = link->GetLink(bp);
             }
         }
@@ -357,16 +359,16 @@ void Context::ShowFlow()
             if (!link)
                 continue;
             
-            ed::Flow(pin->m_ID, pin->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
+            Editor::Flow(pin->m_ID, pin->GetType() == PinType::Flow);
             link = pin->GetLink(bp);
             while (link && link->IsMappedPin())
             {
-                ed::Flow(link->m_ID, link->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
+                Editor::Flow(link->m_ID, link->GetType() == PinType::Flow);
                 link = link->GetLink(bp);
             }
         }
     }
-    ed::PopStyleVar(2);
+    Editor::EndFlow();
 }
 
 Node* Context::CurrentNode()
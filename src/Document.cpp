@@ -1,6 +1,10 @@
 #include <Document.h>
+#include <BluePrintBinary.h>
 #include <Utils.h>
 #include <Debug.h>
+#include <chrono>
+#include <algorithm>
+#include <stdio.h>
 
 namespace BluePrint
 {
@@ -36,6 +40,125 @@ static string SaveReasonFlagsToString(ed::SaveReasonFlags flags, std::string sep
         return string(builder.c_str(), builder.size() - separator.size());
 }
 
+static std::string JournalPath(const std::string& path)
+{
+    return path + ".journal";
+}
+
+static bool WriteDocument(const imgui_json::value& value, const std::string& path)
+{
+    if (IsBinaryBlueprintPath(path))
+        return SaveBinaryBlueprint(value, path);
+    return value.save(path);
+}
+
+// Replay "<path>.journal" records on top of the document loaded from the base file
+static void ApplyJournal(imgui_json::value& document, const std::string& path)
+{
+    FILE* fp = fopen(JournalPath(path).c_str(), "rb");
+    if (!fp)
+        return;
+    std::string text;
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        text.append(buffer, size);
+    fclose(fp);
+
+    if (!document.contains("document") || !document["document"].contains("blueprint"))
+        return;
+    auto& nodesValue = document["document"]["blueprint"]["nodes"];
+    if (!nodesValue.is_array())
+        return;
+
+    std::vector<imgui_json::value> nodes = nodesValue.get<imgui_json::array>();
+    std::map<ID_TYPE, size_t> index;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        ID_TYPE id;
+        if (imgui_json::GetTo<imgui_json::number>(nodes[i], "id", id))
+            index[id] = i;
+    }
+
+    imgui_json::value root;
+    int records = 0;
+    size_t start = 0;
+    while (start < text.size())
+    {
+        auto end = text.find('\n', start);
+        if (end == string::npos)
+            break; // incomplete record, crashed while appending
+        auto record = imgui_json::value::parse(text.substr(start, end - start));
+        start = end + 1;
+        if (!record.is_object())
+            break;
+
+        const imgui_json::array* removedArray = nullptr;
+        if (imgui_json::GetPtrTo(record, "removed", removedArray))
+        {
+            for (auto& idValue : *removedArray)
+            {
+                if (!idValue.is_number())
+                    continue;
+                auto it = index.find((ID_TYPE)idValue.get<imgui_json::number>());
+                if (it == index.end())
+                    continue;
+                nodes[it->second] = imgui_json::value();
+                index.erase(it);
+            }
+        }
+
+        const imgui_json::array* nodesArray = nullptr;
+        if (imgui_json::GetPtrTo(record, "nodes", nodesArray))
+        {
+            for (auto& nodeValue : *nodesArray)
+            {
+                ID_TYPE id;
+                if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id))
+                    continue;
+                auto it = index.find(id);
+                if (it != index.end())
+                    nodes[it->second] = nodeValue;
+                else
+                {
+                    index[id] = nodes.size();
+                    nodes.push_back(nodeValue);
+                }
+            }
+        }
+
+        if (record.contains("root") && record["root"].is_object())
+            root = record["root"];
+        records++;
+    }
+
+    imgui_json::value newNodes = imgui_json::array();
+    const imgui_json::array* orderArray = nullptr;
+    if (!root.is_null() && root.contains("document") && root["document"].contains("blueprint") &&
+        imgui_json::GetPtrTo(root["document"]["blueprint"], "node_order", orderArray))
+    {
+        // rebuild in the order of the last record, same as a full save
+        for (auto& idValue : *orderArray)
+        {
+            if (!idValue.is_number())
+                continue;
+            auto it = index.find((ID_TYPE)idValue.get<imgui_json::number>());
+            if (it == index.end())
+                continue;
+            newNodes.push_back(nodes[it->second]);
+            nodes[it->second] = imgui_json::value();
+        }
+        root["document"]["blueprint"].erase("node_order");
+    }
+    for (auto& nodeValue : nodes)
+        if (!nodeValue.is_null())
+            newNodes.push_back(nodeValue);
+    if (!root.is_null())
+        document = root;
+    document["document"]["blueprint"]["nodes"] = newNodes;
+    LOGI("[Document] Replay %d journal records", records);
+}
+
 imgui_json::value Document::DocumentState::Serialize() const
 {
     imgui_json::value result;
@@ -71,6 +194,463 @@ int Document::DocumentState::Deserialize(const imgui_json::value& value, Documen
     return BP_ERR_NONE;
 }
 
+# pragma region UndoHistory
+// ---[ json diff helpers ]---
+static bool IsEqual(const imgui_json::value& a, const imgui_json::value& b)
+{
+    if (a.type() != b.type())
+        return false;
+    if (a.is_object())
+    {
+        auto& objectA = a.get<imgui_json::object>();
+        auto& objectB = b.get<imgui_json::object>();
+        if (objectA.size() != objectB.size())
+            return false;
+        for (auto itA = objectA.begin(), itB = objectB.begin(); itA != objectA.end(); ++itA, ++itB)
+        {
+            if (itA->first != itB->first || !IsEqual(itA->second, itB->second))
+                return false;
+        }
+        return true;
+    }
+    if (a.is_array())
+    {
+        auto& arrayA = a.get<imgui_json::array>();
+        auto& arrayB = b.get<imgui_json::array>();
+        if (arrayA.size() != arrayB.size())
+            return false;
+        for (size_t i = 0; i < arrayA.size(); i++)
+        {
+            if (!IsEqual(arrayA[i], arrayB[i]))
+                return false;
+        }
+        return true;
+    }
+    if (a.is_null())
+        return true;
+    if (a.is_string())
+        return a.get<imgui_json::string>() == b.get<imgui_json::string>();
+    if (a.is_number())
+        return a.get<imgui_json::number>() == b.get<imgui_json::number>();
+    if (a.is_boolean())
+        return a.get<imgui_json::boolean>() == b.get<imgui_json::boolean>();
+    return a.dump() == b.dump();
+}
+
+static size_t EstimateSize(const imgui_json::value& value)
+{
+    size_t size = sizeof(imgui_json::value);
+    if (value.is_object())
+    {
+        for (auto& item : value.get<imgui_json::object>())
+            size += 32 + item.first.size() + EstimateSize(item.second);
+    }
+    else if (value.is_array())
+    {
+        for (auto& item : value.get<imgui_json::array>())
+            size += EstimateSize(item);
+    }
+    else if (value.is_string())
+        size += value.get<imgui_json::string>().size();
+    return size;
+}
+
+// patch: { "set": { key: value }, "erase": [ key ], "sub": { key: patch } }
+static bool DiffObject(const imgui_json::value& from, const imgui_json::value& to, imgui_json::value& patch, int depth)
+{
+    if (!from.is_object() || !to.is_object())
+    {
+        patch["value"] = to;
+        return true;
+    }
+
+    bool changed = false;
+    auto& objectFrom = from.get<imgui_json::object>();
+    auto& objectTo = to.get<imgui_json::object>();
+    imgui_json::array erase;
+    for (auto& item : objectFrom)
+    {
+        if (objectTo.find(item.first) == objectTo.end())
+            erase.push_back(imgui_json::string(item.first));
+    }
+    if (!erase.empty())
+    {
+        patch["erase"] = std::move(erase);
+        changed = true;
+    }
+    for (auto& item : objectTo)
+    {
+        auto it = objectFrom.find(item.first);
+        if (it == objectFrom.end())
+        {
+            patch["set"][item.first] = item.second;
+            changed = true;
+        }
+        else if (depth > 0 && it->second.is_object() && item.second.is_object())
+        {
+            imgui_json::value subPatch;
+            if (DiffObject(it->second, item.second, subPatch, depth - 1))
+            {
+                patch["sub"][item.first] = std::move(subPatch);
+                changed = true;
+            }
+        }
+        else if (!IsEqual(it->second, item.second))
+        {
+            patch["set"][item.first] = item.second;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+static void PatchObject(imgui_json::value& target, const imgui_json::value& patch)
+{
+    if (patch.contains("value"))
+    {
+        target = patch["value"];
+        return;
+    }
+    if (!target.is_object())
+        target = imgui_json::object();
+    const imgui_json::array* eraseArray = nullptr;
+    if (imgui_json::GetPtrTo(patch, "erase", eraseArray))
+    {
+        for (auto& key : *eraseArray)
+            target.erase(key.get<imgui_json::string>());
+    }
+    const imgui_json::object* setObject = nullptr;
+    if (imgui_json::GetPtrTo(patch, "set", setObject))
+    {
+        for (auto& item : *setObject)
+            target[item.first] = item.second;
+    }
+    const imgui_json::object* subObject = nullptr;
+    if (imgui_json::GetPtrTo(patch, "sub", subObject))
+    {
+        for (auto& item : *subObject)
+            PatchObject(target[item.first], item.second);
+    }
+}
+
+// blueprint nodes are matched by id, unchanged nodes cost nothing
+// patch: { "removed": [ id ], "changed": { id: patch }, "added": [ node ], "order": [ id ] }
+static bool DiffNodes(const imgui_json::value& from, const imgui_json::value& to, imgui_json::value& patch)
+{
+    if (!from.is_array() || !to.is_array())
+    {
+        patch["value"] = to;
+        return true;
+    }
+
+    std::map<ID_TYPE, const imgui_json::value*> fromNodes;
+    std::vector<ID_TYPE> order;
+    for (auto& nodeValue : from.get<imgui_json::array>())
+    {
+        ID_TYPE id;
+        if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id))
+        {
+            patch["value"] = to;
+            return true;
+        }
+        fromNodes[id] = &nodeValue;
+    }
+
+    bool changed = false;
+    imgui_json::array added, removed;
+    std::vector<ID_TYPE> toOrder;
+    std::set<ID_TYPE> toIDs;
+    for (auto& nodeValue : to.get<imgui_json::array>())
+    {
+        ID_TYPE id;
+        if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id))
+        {
+            patch = imgui_json::value();
+            patch["value"] = to;
+            return true;
+        }
+        toOrder.push_back(id);
+        toIDs.insert(id);
+        auto it = fromNodes.find(id);
+        if (it == fromNodes.end())
+        {
+            added.push_back(nodeValue);
+            continue;
+        }
+        imgui_json::value nodePatch;
+        if (DiffObject(*it->second, nodeValue, nodePatch, 0))
+        {
+            patch["changed"][std::to_string(id)] = std::move(nodePatch);
+            changed = true;
+        }
+    }
+
+    for (auto& nodeValue : from.get<imgui_json::array>())
+    {
+        ID_TYPE id;
+        imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id);
+        if (toIDs.find(id) == toIDs.end())
+            removed.push_back(imgui_json::number(id));
+        else
+            order.push_back(id);
+    }
+    if (!added.empty())
+    {
+        patch["added"] = std::move(added);
+        changed = true;
+    }
+    if (!removed.empty())
+    {
+        patch["removed"] = std::move(removed);
+        changed = true;
+    }
+
+    // kept nodes stay in place and added ones are appended, record the order otherwise
+    for (auto& nodeValue : to.get<imgui_json::array>())
+    {
+        ID_TYPE id;
+        imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id);
+        if (fromNodes.find(id) == fromNodes.end())
+            order.push_back(id);
+    }
+    if (order != toOrder)
+    {
+        imgui_json::array orderArray;
+        for (auto id : toOrder)
+            orderArray.push_back(imgui_json::number(id));
+        patch["order"] = std::move(orderArray);
+        changed = true;
+    }
+    return changed;
+}
+
+static void PatchNodes(imgui_json::value& target, const imgui_json::value& patch)
+{
+    if (patch.contains("value"))
+    {
+        target = patch["value"];
+        return;
+    }
+
+    std::vector<ID_TYPE> order;
+    std::map<ID_TYPE, imgui_json::value> nodes;
+    for (auto& nodeValue : target.get<imgui_json::array>())
+    {
+        ID_TYPE id;
+        imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id);
+        order.push_back(id);
+        nodes[id] = std::move(nodeValue);
+    }
+
+    const imgui_json::array* removedArray = nullptr;
+    if (imgui_json::GetPtrTo(patch, "removed", removedArray))
+    {
+        for (auto& idValue : *removedArray)
+        {
+            auto id = (ID_TYPE)idValue.get<imgui_json::number>();
+            nodes.erase(id);
+            order.erase(std::remove(order.begin(), order.end(), id), order.end());
+        }
+    }
+    const imgui_json::object* changedObject = nullptr;
+    if (imgui_json::GetPtrTo(patch, "changed", changedObject))
+    {
+        for (auto& item : *changedObject)
+        {
+            auto it = nodes.find((ID_TYPE)std::stoull(item.first));
+            if (it != nodes.end())
+                PatchObject(it->second, item.second);
+        }
+    }
+    const imgui_json::array* addedArray = nullptr;
+    if (imgui_json::GetPtrTo(patch, "added", addedArray))
+    {
+        for (auto& nodeValue : *addedArray)
+        {
+            ID_TYPE id;
+            imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id);
+            order.push_back(id);
+            nodes[id] = nodeValue;
+        }
+    }
+    const imgui_json::array* orderArray = nullptr;
+    if (imgui_json::GetPtrTo(patch, "order", orderArray))
+    {
+        order.clear();
+        for (auto& idValue : *orderArray)
+            order.push_back((ID_TYPE)idValue.get<imgui_json::number>());
+    }
+
+    imgui_json::value result = imgui_json::array();
+    for (auto id : order)
+    {
+        auto it = nodes.find(id);
+        if (it != nodes.end())
+            result.push_back(std::move(it->second));
+    }
+    target = std::move(result);
+}
+
+static imgui_json::value DiffDocumentState(const Document::DocumentState& from, const Document::DocumentState& to)
+{
+    imgui_json::value delta = imgui_json::object();
+    imgui_json::value patch;
+    // editor state is { "nodes": { node: state } }, go one level down to keep per node entries
+    if (DiffObject(from.m_NodesState, to.m_NodesState, patch, 1))
+        delta["nodes"] = std::move(patch);
+    if (!IsEqual(from.m_SelectionState, to.m_SelectionState))
+        delta["selection"] = to.m_SelectionState;
+
+    const imgui_json::value empty;
+    auto& fromNodes = from.m_BlueprintState.contains("nodes") ? from.m_BlueprintState["nodes"] : empty;
+    auto& toNodes = to.m_BlueprintState.contains("nodes") ? to.m_BlueprintState["nodes"] : empty;
+    patch = imgui_json::value();
+    if (DiffNodes(fromNodes, toNodes, patch))
+        delta["blueprint_nodes"] = std::move(patch);
+
+    imgui_json::value fromRoot = imgui_json::object(), toRoot = imgui_json::object();
+    if (from.m_BlueprintState.is_object())
+        for (auto& item : from.m_BlueprintState.get<imgui_json::object>())
+            if (item.first != "nodes") fromRoot[item.first] = item.second;
+    if (to.m_BlueprintState.is_object())
+        for (auto& item : to.m_BlueprintState.get<imgui_json::object>())
+            if (item.first != "nodes") toRoot[item.first] = item.second;
+    patch = imgui_json::value();
+    if (DiffObject(fromRoot, toRoot, patch, 0))
+        delta["blueprint"] = std::move(patch);
+    return delta;
+}
+
+static void PatchDocumentState(Document::DocumentState& state, const imgui_json::value& delta)
+{
+    if (delta.contains("nodes"))
+        PatchObject(state.m_NodesState, delta["nodes"]);
+    if (delta.contains("selection"))
+        state.m_SelectionState = delta["selection"];
+    if (delta.contains("blueprint"))
+    {
+        imgui_json::value nodes;
+        if (state.m_BlueprintState.contains("nodes"))
+            nodes = std::move(state.m_BlueprintState["nodes"]);
+        PatchObject(state.m_BlueprintState, delta["blueprint"]);
+        state.m_BlueprintState["nodes"] = std::move(nodes);
+    }
+    if (delta.contains("blueprint_nodes"))
+    {
+        auto& nodes = state.m_BlueprintState["nodes"];
+        if (!nodes.is_array())
+            nodes = imgui_json::array();
+        PatchNodes(nodes, delta["blueprint_nodes"]);
+    }
+}
+
+static size_t EstimateSize(const Document::DocumentState& state)
+{
+    return EstimateSize(state.m_NodesState) + EstimateSize(state.m_SelectionState) + EstimateSize(state.m_BlueprintState);
+}
+
+// ---[ UndoHistory ]---
+void Document::UndoHistory::Push(UndoState&& state)
+{
+    Entry entry;
+    entry.m_Name = state.m_Name;
+    if (m_Entries.empty() || m_SinceCheckpoint >= m_CheckpointInterval)
+    {
+        entry.m_Checkpoint = true;
+        entry.m_State = state.m_State;
+        entry.m_Bytes = EstimateSize(entry.m_State);
+        m_SinceCheckpoint = 0;
+    }
+    else
+    {
+        entry.m_Delta = DiffDocumentState(m_Tail, state.m_State);
+        entry.m_Bytes = EstimateSize(entry.m_Delta);
+        m_SinceCheckpoint++;
+    }
+    entry.m_Bytes += sizeof(Entry) + entry.m_Name.size();
+
+    m_Tail = std::move(state.m_State);
+    m_Bytes += entry.m_Bytes;
+    m_Entries.push_back(std::move(entry));
+    Evict();
+}
+
+Document::UndoState Document::UndoHistory::Pop()
+{
+    UndoState result;
+    if (m_Entries.empty())
+        return result;
+
+    result.m_Name = std::move(m_Entries.back().m_Name);
+    result.m_State = std::move(m_Tail);
+    m_Bytes -= m_Entries.back().m_Bytes;
+    m_Entries.pop_back();
+
+    m_Tail = DocumentState();
+    m_SinceCheckpoint = 0;
+    if (!m_Entries.empty())
+    {
+        m_Tail = Materialize(m_Entries.size() - 1);
+        for (size_t i = m_Entries.size(); i > 0 && !m_Entries[i - 1].m_Checkpoint; i--)
+            m_SinceCheckpoint++;
+    }
+    return result;
+}
+
+void Document::UndoHistory::Clear()
+{
+    m_Entries.clear();
+    m_Tail = DocumentState();
+    m_Bytes = 0;
+    m_SinceCheckpoint = 0;
+}
+
+void Document::UndoHistory::SetBudget(size_t bytes, int checkpoint_interval)
+{
+    m_Budget = bytes;
+    m_CheckpointInterval = ImMax(checkpoint_interval, 1);
+    Evict();
+}
+
+Document::DocumentState Document::UndoHistory::Materialize(size_t index) const
+{
+    size_t checkpoint = index;
+    while (checkpoint > 0 && !m_Entries[checkpoint].m_Checkpoint)
+        checkpoint--;
+
+    DocumentState state = m_Entries[checkpoint].m_State;
+    for (size_t i = checkpoint + 1; i <= index; i++)
+        PatchDocumentState(state, m_Entries[i].m_Delta);
+    return state;
+}
+
+void Document::UndoHistory::Evict()
+{
+    // the front entry is always a checkpoint, promote the next one before dropping it
+    while (m_Bytes > m_Budget && m_Entries.size() > 1)
+    {
+        auto& next = m_Entries[1];
+        if (!next.m_Checkpoint)
+        {
+            m_Bytes -= next.m_Bytes;
+            next.m_State = m_Entries[0].m_State;
+            PatchDocumentState(next.m_State, next.m_Delta);
+            next.m_Delta = imgui_json::value();
+            next.m_Checkpoint = true;
+            next.m_Bytes = EstimateSize(next.m_State) + sizeof(Entry) + next.m_Name.size();
+            m_Bytes += next.m_Bytes;
+        }
+        m_Bytes -= m_Entries.front().m_Bytes;
+        m_Entries.pop_front();
+    }
+    m_SinceCheckpoint = 0;
+    for (size_t i = m_Entries.size(); i > 0 && !m_Entries[i - 1].m_Checkpoint; i--)
+        m_SinceCheckpoint++;
+    if (m_Entries.size() == 1 && m_Bytes > m_Budget)
+        LOGW("[Document] Undo budget %zu is smaller than a single checkpoint (%zu)", m_Budget, m_Bytes);
+}
+# pragma endregion
+
 Document::UndoTransaction::UndoTransaction(Document& document, std::string name)
     : m_Name(name)
     , m_Document(&document)
@@ -175,8 +755,8 @@ void Document::UndoTransaction::Commit(std::string name)
             if (need_undo)
             {
                 //LOGV("[UndoTransaction] Commit: %" PRI_sv, FMT_sv(name));
-                m_Document->m_Undo.emplace_back(std::move(m_State));
-                m_Document->m_Redo.clear();
+                m_Document->m_Undo.Push(std::move(m_State));
+                m_Document->m_Redo.Clear();
             }
 
             m_Document->m_DocumentState = m_Document->BuildDocumentState();
@@ -312,11 +892,32 @@ int Document::Deserialize(const imgui_json::value& value, Document& result)
 int Document::Load(std::string path)
 {
     int ret = BP_ERR_NONE;
-    auto loadResult = imgui_json::value::load(path);
-    if (!loadResult.second)
-        return BP_ERR_DOC_LOAD;
+    imgui_json::value value;
+    {
+        std::lock_guard<std::mutex> lock(m_FileMutex);
+        if (IsBinaryBlueprint(path))
+        {
+            if ((ret = LoadBinaryBlueprint(path, value)) != BP_ERR_NONE)
+                return BP_ERR_DOC_LOAD;
+        }
+        else
+        {
+            auto loadResult = imgui_json::value::load(path);
+            if (!loadResult.second)
+                return BP_ERR_DOC_LOAD;
+            value = std::move(loadResult.first);
+        }
+        ApplyJournal(value, path);
+    }
+
+    {
+        // drop whatever was pending for the previous document
+        std::lock_guard<std::mutex> lock(m_JournalMutex);
+        m_Generation++;
+        m_Journal = JournalRecord();
+    }
 
-    if ((ret = Deserialize(loadResult.first, *this)) != BP_ERR_NONE)
+    if ((ret = Deserialize(value, *this)) != BP_ERR_NONE)
         return ret;
 
     return ret;
@@ -335,7 +936,23 @@ int Document::Import(std::string path, ImVec2 pos)
 bool Document::Save(std::string path) const
 {
     auto result = Serialize();
-    return result.save(path);
+    // explicit saves serialize every node, the cached state only tracks nodes marked dirty
+    auto& blueprintValue = result["document"]["blueprint"];
+    blueprintValue = imgui_json::value();
+    m_Blueprint.Save(blueprintValue);
+    std::lock_guard<std::mutex> lock(m_FileMutex);
+    if (!WriteDocument(result, path))
+        return false;
+
+    if (path == m_Path)
+    {
+        // base file is up to date, pending and written journal records are obsolete
+        std::lock_guard<std::mutex> journal_lock(m_JournalMutex);
+        m_Generation++;
+        m_Journal = JournalRecord();
+        remove(JournalPath(path).c_str());
+    }
+    return true;
 }
 
 bool Document::Save() const
@@ -345,13 +962,206 @@ bool Document::Save() const
     return Save(m_Path);
 }
 
+bool Document::SaveIncremental()
+{
+    if (m_Path.empty())
+        return false;
+
+    if (!m_JournalEnabled)
+    {
+        // changes made before journaling started are only in a full save
+        m_JournalEnabled = true;
+        return Save();
+    }
+    return FlushJournal();
+}
+
+void Document::EnableAutosave(int interval_ms)
+{
+    if (m_AutosaveThread)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_AutosaveMutex);
+            m_AutosaveQuit = true;
+        }
+        m_AutosaveCond.notify_all();
+        m_AutosaveThread->join();
+        delete m_AutosaveThread;
+        m_AutosaveThread = nullptr;
+    }
+
+    m_AutosaveInterval = interval_ms;
+    if (interval_ms <= 0)
+        return;
+
+    if (!m_JournalEnabled)
+    {
+        // first record carries the whole document, written by the autosave thread
+        m_JournalEnabled = true;
+        m_JournalCompact = true;
+    }
+    m_AutosaveQuit = false;
+    m_AutosaveThread = new std::thread(&Document::AutosaveThread, this);
+}
+
+Document::~Document()
+{
+    EnableAutosave(0);
+}
+
+void Document::AutosaveThread()
+{
+    std::unique_lock<std::mutex> lock(m_AutosaveMutex);
+    while (!m_AutosaveQuit)
+    {
+        m_AutosaveCond.wait_for(lock, std::chrono::milliseconds(m_AutosaveInterval), [this] { return m_AutosaveQuit.load(); });
+        lock.unlock();
+        FlushJournal();
+        lock.lock();
+    }
+}
+
+// Called on the UI thread after each BuildDocumentState, only copies json
+void Document::QueueJournal(const DocumentState& state, const std::vector<ID_TYPE>& changed, const std::vector<ID_TYPE>& removed)
+{
+    if (m_Path.empty())
+        return;
+
+    imgui_json::value root;
+    root["document"]["nodes"] = state.m_NodesState;
+    root["document"]["selection"] = state.m_SelectionState;
+    auto& blueprintValue = root["document"]["blueprint"];
+    blueprintValue = imgui_json::object();
+    if (state.m_BlueprintState.is_object())
+    {
+        for (auto& item : state.m_BlueprintState.get<imgui_json::object>())
+            if (item.first != "nodes")
+                blueprintValue[item.first] = item.second;
+    }
+    // node ids in blueprint order, replay keeps re-added nodes in place
+    auto& orderValue = blueprintValue["node_order"];
+    orderValue = imgui_json::array();
+    const imgui_json::array* orderArray = nullptr;
+    if (imgui_json::GetPtrTo(state.m_BlueprintState, "nodes", orderArray))
+    {
+        for (auto& nodeValue : *orderArray)
+        {
+            ID_TYPE id;
+            if (imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id))
+                orderValue.push_back(imgui_json::number(id));
+        }
+    }
+    root["view"] = m_NavigationState.m_ViewState;
+
+    imgui_json::value full;
+    if (m_JournalCompact.exchange(false))
+    {
+        full["document"] = state.Serialize();
+        full["view"] = m_NavigationState.m_ViewState;
+    }
+
+    std::map<ID_TYPE, imgui_json::value> nodes;
+    const imgui_json::array* nodesArray = nullptr;
+    if (full.is_null() && !changed.empty() && imgui_json::GetPtrTo(state.m_BlueprintState, "nodes", nodesArray))
+    {
+        std::set<ID_TYPE> changedSet(changed.begin(), changed.end());
+        for (auto& nodeValue : *nodesArray)
+        {
+            ID_TYPE id;
+            if (imgui_json::GetTo<imgui_json::number>(nodeValue, "id", id) && changedSet.count(id))
+                nodes[id] = nodeValue;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_JournalMutex);
+    if (!full.is_null())
+    {
+        m_Journal.m_Full = std::move(full);
+        m_Journal.m_Nodes.clear();
+        m_Journal.m_Removed.clear();
+    }
+    for (auto& item : nodes)
+    {
+        m_Journal.m_Removed.erase(item.first);
+        m_Journal.m_Nodes[item.first] = std::move(item.second);
+    }
+    for (auto id : removed)
+    {
+        m_Journal.m_Nodes.erase(id);
+        m_Journal.m_Removed.insert(id);
+    }
+    m_Journal.m_Root = std::move(root);
+    m_Journal.m_Path = m_Path;
+    m_Journal.m_Generation = m_Generation;
+}
+
+bool Document::FlushJournal()
+{
+    JournalRecord record;
+    {
+        std::lock_guard<std::mutex> lock(m_JournalMutex);
+        if (m_Journal.m_Root.is_null() && m_Journal.m_Full.is_null())
+            return true;
+        record = std::move(m_Journal);
+        m_Journal = JournalRecord();
+    }
+
+    // json dump and file io happen here, never on the UI thread
+    std::lock_guard<std::mutex> lock(m_FileMutex);
+    {
+        std::lock_guard<std::mutex> journal_lock(m_JournalMutex);
+        if (record.m_Generation != m_Generation)
+            return true; // a full save went through meanwhile
+    }
+
+    auto journalPath = JournalPath(record.m_Path);
+    if (!record.m_Full.is_null())
+    {
+        if (!WriteDocument(record.m_Full, record.m_Path))
+            return false;
+        remove(journalPath.c_str());
+        if (record.m_Nodes.empty() && record.m_Removed.empty())
+            return true;
+    }
+
+    imgui_json::value line;
+    line["root"] = std::move(record.m_Root);
+    auto& nodesValue = line["nodes"];
+    nodesValue = imgui_json::array();
+    for (auto& item : record.m_Nodes)
+        nodesValue.push_back(item.second);
+    auto& removedValue = line["removed"];
+    removedValue = imgui_json::array();
+    for (auto id : record.m_Removed)
+        removedValue.push_back(imgui_json::number(id));
+    auto text = line.dump() + "\n";
+
+    FILE* fp = fopen(journalPath.c_str(), "ab");
+    if (!fp)
+        return false;
+    bool done = fwrite(text.data(), 1, text.size(), fp) == text.size();
+    long journalSize = ftell(fp);
+    fclose(fp);
+
+    // journal grew past the base file, next record rewrites the whole document
+    long baseSize = 0;
+    if ((fp = fopen(record.m_Path.c_str(), "rb")) != nullptr)
+    {
+        fseek(fp, 0, SEEK_END);
+        baseSize = ftell(fp);
+        fclose(fp);
+    }
+    if (journalSize > 1024 * 1024 && journalSize > baseSize)
+        m_JournalCompact = true;
+    return done;
+}
+
 bool Document::Undo()
 {
-    if (m_Undo.empty())
+    if (m_Undo.IsEmpty())
         return false;
 
-    auto state = std::move(m_Undo.back());
-    m_Undo.pop_back();
+    auto state = m_Undo.Pop();
 
     LOGI("[Document] Undo: %s", state.m_Name.c_str());
 
@@ -361,18 +1171,17 @@ bool Document::Undo()
 
     ApplyState(state.m_State);
 
-    m_Redo.push_back(std::move(undoState));
+    m_Redo.Push(std::move(undoState));
 
     return true;
 }
 
 bool Document::Redo()
 {
-    if (m_Redo.empty())
+    if (m_Redo.IsEmpty())
         return true;
 
-    auto state = std::move(m_Redo.back());
-    m_Redo.pop_back();
+    auto state = m_Redo.Pop();
 
     LOGI("[Document] Redo: %s", state.m_Name.c_str());
 
@@ -382,17 +1191,26 @@ bool Document::Redo()
 
     ApplyState(state.m_State);
 
-    m_Undo.push_back(std::move(undoState));
+    m_Undo.Push(std::move(undoState));
 
     return true;
 }
 
+void Document::SetUndoBudget(size_t bytes, int checkpoint_interval)
+{
+    m_Undo.SetBudget(bytes, checkpoint_interval);
+    m_Redo.SetBudget(bytes, checkpoint_interval);
+}
+
 Document::DocumentState Document::BuildDocumentState()
 {
     DocumentState result;
-    m_Blueprint.Save(result.m_BlueprintState);
+    std::vector<ID_TYPE> changed, removed;
+    m_Blueprint.SaveIncremental(result.m_BlueprintState, &changed, &removed);
     result.m_SelectionState = ed::GetState(ed::StateType::Selection);
     result.m_NodesState = ed::GetState(ed::StateType::Nodes);
+    if (m_JournalEnabled)
+        QueueJournal(result, changed, removed);
     return result;
 }
 
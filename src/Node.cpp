@@ -1,8 +1,18 @@
 #include <Node.h>
-#include <Debug.h>
-#include <imgui_node_editor_internal.h>
+#include <Log.h>
 #include <imgui_helper.h>
 #include <BuildInNodes.h> // Which is generated by cmake
+#include <fstream>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <limits.h>
+#endif
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 #if IMGUI_ICONS
 #define ICON_NODE           u8"\uf1b3"
@@ -104,149 +114,166 @@ bool NodeVersionFromString(string str, VERSION_TYPE& version)
 
 NodeRegistry::NodeRegistry()
     : m_BuildInNodes({
-        DummyNode::GetStaticTypeInfo(),
-        SystemEntryPointNode::GetStaticTypeInfo(),
-        SystemExitPointNode::GetStaticTypeInfo(),
-        FilterEntryPointNode::GetStaticTypeInfo(),
-        FusionEntryPointNode::GetStaticTypeInfo(),
-        MatExitPointNode::GetStaticTypeInfo(),
-        CommentNode::GetStaticTypeInfo(),
-        GroupNode::GetStaticTypeInfo(),
-        DateTimeNode::GetStaticTypeInfo(),
-        ConstValueNode::GetStaticTypeInfo(),
-        LoopNode::GetStaticTypeInfo(),
-        FloatCountNode::GetStaticTypeInfo(),
-        CountNode::GetStaticTypeInfo(),
-        ToStringNode::GetStaticTypeInfo(),
-        TimerNode::GetStaticTypeInfo(),
-        FileSelectNode::GetStaticTypeInfo(),
-        AddNode::GetStaticTypeInfo(),
-        SubNode::GetStaticTypeInfo(),
-        MulNode::GetStaticTypeInfo(),
-        DivNode::GetStaticTypeInfo(),
-        CompareNode::GetStaticTypeInfo(),
-        ComparatorNode::GetStaticTypeInfo(),
-        SwitchNode::GetStaticTypeInfo(),
-        BranchNode::GetStaticTypeInfo(),
-        FlipFlopNode::GetStaticTypeInfo(),
-        PrintNode::GetStaticTypeInfo(),
+        &DummyNode::GetStaticTypeInfo(),
+        &SystemEntryPointNode::GetStaticTypeInfo(),
+        &SystemExitPointNode::GetStaticTypeInfo(),
+        &FilterEntryPointNode::GetStaticTypeInfo(),
+        &FusionEntryPointNode::GetStaticTypeInfo(),
+        &MatExitPointNode::GetStaticTypeInfo(),
+        &CommentNode::GetStaticTypeInfo(),
+        &GroupNode::GetStaticTypeInfo(),
+        &DateTimeNode::GetStaticTypeInfo(),
+        &ConstValueNode::GetStaticTypeInfo(),
+        &LoopNode::GetStaticTypeInfo(),
+        &FloatCountNode::GetStaticTypeInfo(),
+        &CountNode::GetStaticTypeInfo(),
+        &ToStringNode::GetStaticTypeInfo(),
+        &TimerNode::GetStaticTypeInfo(),
+        &FileSelectNode::GetStaticTypeInfo(),
+        &AddNode::GetStaticTypeInfo(),
+        &SubNode::GetStaticTypeInfo(),
+        &MulNode::GetStaticTypeInfo(),
+        &DivNode::GetStaticTypeInfo(),
+        &CompareNode::GetStaticTypeInfo(),
+        &ComparatorNode::GetStaticTypeInfo(),
+        &SwitchNode::GetStaticTypeInfo(),
+        &BranchNode::GetStaticTypeInfo(),
+        &FlipFlopNode::GetStaticTypeInfo(),
+        &PrintNode::GetStaticTypeInfo(),
 #if IMGUI_VULKAN_SHADER
         // video filter nodes
-        AlmNode::GetStaticTypeInfo(),
-        BilateralNode::GetStaticTypeInfo(),
-        BrightnessNode::GetStaticTypeInfo(),
-        BoxBlurNode::GetStaticTypeInfo(),
-        CannyNode::GetStaticTypeInfo(),
-        CasNode::GetStaticTypeInfo(),
-        ChromaKeyNode::GetStaticTypeInfo(),
-        ColorBalanceNode::GetStaticTypeInfo(),
-        ColorCurveNode::GetStaticTypeInfo(),
-        ColorInvertNode::GetStaticTypeInfo(),
-        ContrastNode::GetStaticTypeInfo(),
-        DeBandNode::GetStaticTypeInfo(),
-        DeinterlaceNode::GetStaticTypeInfo(),
-        ExposureNode::GetStaticTypeInfo(),
-        FlipNode::GetStaticTypeInfo(),
-        GammaNode::GetStaticTypeInfo(),
-        GaussianBlurNode::GetStaticTypeInfo(),
-        HQDN3DNode::GetStaticTypeInfo(),
-        HueNode::GetStaticTypeInfo(),
-        LaplacianNode::GetStaticTypeInfo(),
-        Lut3DNode::GetStaticTypeInfo(),
-        SaturationNode::GetStaticTypeInfo(),
-        SobelNode::GetStaticTypeInfo(),
-        USMNode::GetStaticTypeInfo(),
-        WhiteBalanceNode::GetStaticTypeInfo(),
-        VibranceNode::GetStaticTypeInfo(),
-        GuidedNode::GetStaticTypeInfo(),
+        &AlmNode::GetStaticTypeInfo(),
+        &BilateralNode::GetStaticTypeInfo(),
+        &BrightnessNode::GetStaticTypeInfo(),
+        &BoxBlurNode::GetStaticTypeInfo(),
+        &CannyNode::GetStaticTypeInfo(),
+        &CasNode::GetStaticTypeInfo(),
+        &ChromaKeyNode::GetStaticTypeInfo(),
+        &ColorBalanceNode::GetStaticTypeInfo(),
+        &ColorCurveNode::GetStaticTypeInfo(),
+        &ColorInvertNode::GetStaticTypeInfo(),
+        &ContrastNode::GetStaticTypeInfo(),
+        &DeBandNode::GetStaticTypeInfo(),
+        &DeinterlaceNode::GetStaticTypeInfo(),
+        &ExposureNode::GetStaticTypeInfo(),
+        &FlipNode::GetStaticTypeInfo(),
+        &GammaNode::GetStaticTypeInfo(),
+        &GaussianBlurNode::GetStaticTypeInfo(),
+        &HQDN3DNode::GetStaticTypeInfo(),
+        &HueNode::GetStaticTypeInfo(),
+        &LaplacianNode::GetStaticTypeInfo(),
+        &Lut3DNode::GetStaticTypeInfo(),
+        &SaturationNode::GetStaticTypeInfo(),
+        &SobelNode::GetStaticTypeInfo(),
+        &USMNode::GetStaticTypeInfo(),
+        &WhiteBalanceNode::GetStaticTypeInfo(),
+        &VibranceNode::GetStaticTypeInfo(),
+        &GuidedNode::GetStaticTypeInfo(),
         // fusion nodes
-        AlphaFusionNode::GetStaticTypeInfo(),
-        BlurFusionNode::GetStaticTypeInfo(),
-        DoorFusionNode::GetStaticTypeInfo(),
-        FadeFusionNode::GetStaticTypeInfo(),
-        MoveFusionNode::GetStaticTypeInfo(),
-        SliderFusionNode::GetStaticTypeInfo(),
-        BookFlipFusionNode::GetStaticTypeInfo(),
-        BounceFusionNode::GetStaticTypeInfo(),
-        BowTieFusionNode::GetStaticTypeInfo(),
-        ButterflyWaveFusionNode::GetStaticTypeInfo(),
-        SwapFusionNode::GetStaticTypeInfo(),
-        RadialFusionNode::GetStaticTypeInfo(),
-        WindowSliceFusionNode::GetStaticTypeInfo(),
-        PolkaDotsFusionNode::GetStaticTypeInfo(),
-        SimpleZoomFusionNode::GetStaticTypeInfo(),
-        WaterDropFusionNode::GetStaticTypeInfo(),
-        PageCurlFusionNode::GetStaticTypeInfo(),
-        GlitchMemoriesFusionNode::GetStaticTypeInfo(),
-        StereoViewerFusionNode::GetStaticTypeInfo(),
-        LuminanceMeltFusionNode::GetStaticTypeInfo(),
-        PerlinFusionNode::GetStaticTypeInfo(),
-        DirectionalWarpFusionNode::GetStaticTypeInfo(),
-        MorphFusionNode::GetStaticTypeInfo(),
-        ColourDistanceFusionNode::GetStaticTypeInfo(),
-        CircleCropFusionNode::GetStaticTypeInfo(),
-        SwirlFusionNode::GetStaticTypeInfo(),
-        CrossZoomFusionNode::GetStaticTypeInfo(),
-        DreamyFusionNode::GetStaticTypeInfo(),
-        GridFlipFusionNode::GetStaticTypeInfo(),
-        ZoomInCirclesFusionNode::GetStaticTypeInfo(),
-        MosaicFusionNode::GetStaticTypeInfo(),
-        BurnOutFusionNode::GetStaticTypeInfo(),
-        CrosshatchFusionNode::GetStaticTypeInfo(),
-        CannabisLeafFusionNode::GetStaticTypeInfo(),
-        CrazyParametricFusionNode::GetStaticTypeInfo(),
-        KaleidoScopeFusionNode::GetStaticTypeInfo(),
-        WindowBlindsFusionNode::GetStaticTypeInfo(),
-        HexagonalizeFusionNode::GetStaticTypeInfo(),
-        GlitchDisplaceFusionNode::GetStaticTypeInfo(),
-        DreamyZoomFusionNode::GetStaticTypeInfo(),
-        DoomScreenFusionNode::GetStaticTypeInfo(),
-        RippleFusionNode::GetStaticTypeInfo(),
-        PinwheelFusionNode::GetStaticTypeInfo(),
-        BurnFusionNode::GetStaticTypeInfo(),
-        CircleBlurFusionNode::GetStaticTypeInfo(),
-        ColorPhaseFusionNode::GetStaticTypeInfo(),
-        CrossWarpFusionNode::GetStaticTypeInfo(),
-        CubeFusionNode::GetStaticTypeInfo(),
-        DoorwayFusionNode::GetStaticTypeInfo(),
-        FlyeyeFusionNode::GetStaticTypeInfo(),
-        HeartFusionNode::GetStaticTypeInfo(),
-        MultiplyBlendFusionNode::GetStaticTypeInfo(),
-        PixelizeFusionNode::GetStaticTypeInfo(),
-        PolarFusionNode::GetStaticTypeInfo(),
-        RandomSquaresFusionNode::GetStaticTypeInfo(),
-        RotateScaleFusionNode::GetStaticTypeInfo(),
-        SquaresWireFusionNode::GetStaticTypeInfo(),
-        SqueezeFusionNode::GetStaticTypeInfo(),
-        WindFusionNode::GetStaticTypeInfo(),
-        WipeFusionNode::GetStaticTypeInfo(),
-        RollsFusionNode::GetStaticTypeInfo(),
+        &AlphaFusionNode::GetStaticTypeInfo(),
+        &BlurFusionNode::GetStaticTypeInfo(),
+        &DoorFusionNode::GetStaticTypeInfo(),
+        &FadeFusionNode::GetStaticTypeInfo(),
+        &MoveFusionNode::GetStaticTypeInfo(),
+        &SliderFusionNode::GetStaticTypeInfo(),
+        &BookFlipFusionNode::GetStaticTypeInfo(),
+        &BounceFusionNode::GetStaticTypeInfo(),
+        &BowTieFusionNode::GetStaticTypeInfo(),
+        &ButterflyWaveFusionNode::GetStaticTypeInfo(),
+        &SwapFusionNode::GetStaticTypeInfo(),
+        &RadialFusionNode::GetStaticTypeInfo(),
+        &WindowSliceFusionNode::GetStaticTypeInfo(),
+        &PolkaDotsFusionNode::GetStaticTypeInfo(),
+        &SimpleZoomFusionNode::GetStaticTypeInfo(),
+        &WaterDropFusionNode::GetStaticTypeInfo(),
+        &PageCurlFusionNode::GetStaticTypeInfo(),
+        &GlitchMemoriesFusionNode::GetStaticTypeInfo(),
+        &StereoViewerFusionNode::GetStaticTypeInfo(),
+        &LuminanceMeltFusionNode::GetStaticTypeInfo(),
+        &PerlinFusionNode::GetStaticTypeInfo(),
+        &DirectionalWarpFusionNode::GetStaticTypeInfo(),
+        &MorphFusionNode::GetStaticTypeInfo(),
+        &ColourDistanceFusionNode::GetStaticTypeInfo(),
+        &CircleCropFusionNode::GetStaticTypeInfo(),
+        &SwirlFusionNode::GetStaticTypeInfo(),
+        &CrossZoomFusionNode::GetStaticTypeInfo(),
+        &DreamyFusionNode::GetStaticTypeInfo(),
+        &GridFlipFusionNode::GetStaticTypeInfo(),
+        &ZoomInCirclesFusionNode::GetStaticTypeInfo(),
+        &MosaicFusionNode::GetStaticTypeInfo(),
+        &BurnOutFusionNode::GetStaticTypeInfo(),
+        &CrosshatchFusionNode::GetStaticTypeInfo(),
+        &CannabisLeafFusionNode::GetStaticTypeInfo(),
+        &CrazyParametricFusionNode::GetStaticTypeInfo(),
+        &KaleidoScopeFusionNode::GetStaticTypeInfo(),
+        &WindowBlindsFusionNode::GetStaticTypeInfo(),
+        &HexagonalizeFusionNode::GetStaticTypeInfo(),
+        &GlitchDisplaceFusionNode::GetStaticTypeInfo(),
+        &DreamyZoomFusionNode::GetStaticTypeInfo(),
+        &DoomScreenFusionNode::GetStaticTypeInfo(),
+        &RippleFusionNode::GetStaticTypeInfo(),
+        &PinwheelFusionNode::GetStaticTypeInfo(),
+        &BurnFusionNode::GetStaticTypeInfo(),
+        &CircleBlurFusionNode::GetStaticTypeInfo(),
+        &ColorPhaseFusionNode::GetStaticTypeInfo(),
+        &CrossWarpFusionNode::GetStaticTypeInfo(),
+        &CubeFusionNode::GetStaticTypeInfo(),
+        &DoorwayFusionNode::GetStaticTypeInfo(),
+        &FlyeyeFusionNode::GetStaticTypeInfo(),
+        &HeartFusionNode::GetStaticTypeInfo(),
+        &MultiplyBlendFusionNode::GetStaticTypeInfo(),
+        &PixelizeFusionNode::GetStaticTypeInfo(),
+        &PolarFusionNode::GetStaticTypeInfo(),
+        &RandomSquaresFusionNode::GetStaticTypeInfo(),
+        &RotateScaleFusionNode::GetStaticTypeInfo(),
+        &SquaresWireFusionNode::GetStaticTypeInfo(),
+        &SqueezeFusionNode::GetStaticTypeInfo(),
+        &WindFusionNode::GetStaticTypeInfo(),
+        &WipeFusionNode::GetStaticTypeInfo(),
+        &RollsFusionNode::GetStaticTypeInfo(),
         // Media node
-        MatCropNode::GetStaticTypeInfo(),
-        MatWarpPerspectiveNode::GetStaticTypeInfo(),
-        MatWarpAffineNode::GetStaticTypeInfo(),
+        &MatCropNode::GetStaticTypeInfo(),
+        &MatWarpPerspectiveNode::GetStaticTypeInfo(),
+        &MatWarpAffineNode::GetStaticTypeInfo(),
 #endif
 #ifdef SDK_WITH_SDL2
         // audio render node
-        SDLAudioRenderingNode::GetStaticTypeInfo(),
+        &SDLAudioRenderingNode::GetStaticTypeInfo(),
 #endif
+        // headless audio sink
+        &AudioSinkNode::GetStaticTypeInfo(),
         // audio filter nodes
-        AudioGainNode::GetStaticTypeInfo(),
+        &AudioGainNode::GetStaticTypeInfo(),
+        &AudioEqualizerNode::GetStaticTypeInfo(),
         // audio fusion nodes
-        AudioFadeNode::GetStaticTypeInfo(),
+        &AudioFadeNode::GetStaticTypeInfo(),
 #ifdef SDK_WITH_FFMPEG
-        MediaSourceNode::GetStaticTypeInfo(),
-        AudioEqualizerNode::GetStaticTypeInfo(),
+        &MediaSourceNode::GetStaticTypeInfo(),
 #endif
         // Media nodes
-        MatRenderNode::GetStaticTypeInfo(),
+        &MatRenderNode::GetStaticTypeInfo(),
     })
 {
-    RebuildTypes();
+    m_Types.reserve(m_BuildInNodes.size());
+    for (auto typeInfo : m_BuildInNodes)
+        AddType(typeInfo);
+}
+
+// Kept for the process lifetime, plugin types registered on it stay
+// available after the last BP using it is gone.
+shared_ptr<NodeRegistry> NodeRegistry::GetShared()
+{
+    static std::mutex mutex;
+    static shared_ptr<NodeRegistry> shared;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!shared)
+        shared = make_shared<NodeRegistry>();
+    return shared;
 }
 
 NodeRegistry::~NodeRegistry()
 {
+    EnablePluginWatch(false);
     for (auto node : m_Nodes)
     {
         delete node;
@@ -257,12 +284,18 @@ NodeRegistry::~NodeRegistry()
         delete obj;
     }
     m_ExternalObject.clear();
+    for (auto& plugin : m_Plugins)
+    {
+        if (!plugin.m_LoadedPath.empty())
+            remove(plugin.m_LoadedPath.c_str());
+    }
 }
 
 ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
 {
     // regiester static node which has NodeTypeInfo
     auto id = info->m_ID;
+    std::unique_lock<std::shared_timed_mutex> lock(m_TypesMutex);
 
     auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [id](const NodeTypeInfo& typeInfo)
     {
@@ -270,7 +303,10 @@ ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
     });
 
     if (it != m_CustomNodes.end())
+    {
+        RemoveType(&*it);
         m_CustomNodes.erase(it);
+    }
 
     NodeTypeInfo typeInfo;
     typeInfo.m_ID               = id;
@@ -284,7 +320,7 @@ ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
 
     m_CustomNodes.push_back(std::move(typeInfo));
 
-    RebuildTypes();
+    AddType(&m_CustomNodes.back());
 
     return id;
 }
@@ -311,95 +347,492 @@ ID_TYPE NodeRegistry::RegisterNodeType(std::string Path, BP* blueprint)
                 VERSION_MAJOR(VERSION_BLUEPRINT), VERSION_MINOR(VERSION_BLUEPRINT), VERSION_PATCH(VERSION_BLUEPRINT), VERSION_BUILT(VERSION_BLUEPRINT));
     }
     m_ExternalObject.push_back(dlobject);
-    return RegisterNodeType(info);
+    auto id = RegisterNodeType(info);
+    AddPlugin(Path, dlobject, id);
+    return id;
 }
 
-void NodeRegistry::UnregisterNodeType(std::string name)
+// manifest entry of a loaded plugin type, enough to register it again without opening the library
+static imgui_json::value TypeInfoToJson(const NodeTypeInfo& info)
 {
-    auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [name](const NodeTypeInfo& typeInfo)
+    imgui_json::value value;
+    value["type_id"] = imgui_json::number(info.m_ID);
+    value["type_name"] = info.m_NodeTypeName;
+    value["name"] = info.m_Name;
+    value["author"] = info.m_Author;
+    value["catalog"] = info.m_Catalog;
+    value["version"] = imgui_json::number(info.m_Version);
+    value["sdk_version"] = imgui_json::number(info.m_SDK_Version);
+    value["type"] = NodeTypeToString(info.m_Type);
+    value["style"] = NodeStyleToString(info.m_Style);
+    return value;
+}
+
+static bool TypeInfoFromJson(const imgui_json::value& value, NodeTypeInfo& info)
+{
+    std::string type, style;
+    if (!imgui_json::GetTo<imgui_json::number>(value, "type_id", info.m_ID) ||
+        !imgui_json::GetTo<imgui_json::string>(value, "type_name", info.m_NodeTypeName) ||
+        !imgui_json::GetTo<imgui_json::string>(value, "name", info.m_Name) ||
+        !imgui_json::GetTo<imgui_json::string>(value, "catalog", info.m_Catalog) ||
+        !imgui_json::GetTo<imgui_json::number>(value, "version", info.m_Version) ||
+        !imgui_json::GetTo<imgui_json::string>(value, "type", type) ||
+        !imgui_json::GetTo<imgui_json::string>(value, "style", style) ||
+        !NodeTypeFromString(type, info.m_Type) ||
+        !NodeStyleFromString(style, info.m_Style))
+        return false;
+    imgui_json::GetTo<imgui_json::string>(value, "author", info.m_Author); // optional
+    imgui_json::GetTo<imgui_json::number>(value, "sdk_version", info.m_SDK_Version); // optional
+    info.m_Factory = nullptr;
+    return true;
+}
+
+int NodeRegistry::RegisterNodeTypes(const std::vector<std::string>& paths, PluginManifest* manifest)
+{
+    int count = 0;
+    std::vector<std::string> probes;
+    for (auto& path : paths)
     {
-        return typeInfo.m_Name == name;
+        if (manifest && manifest->IsKnownBad(path))
+        {
+            LOGI("[RegisterNodeTypes] Skip %s, failed to load last time", path.c_str());
+            continue;
+        }
+        // unchanged since the last probe, the library is opened when a node is first created
+        auto cached = manifest ? manifest->GetInfo(path) : nullptr;
+        auto info = make_shared<NodeTypeInfo>();
+        if (cached && TypeInfoFromJson(*cached, *info))
+        {
+            auto id = RegisterNodeType(info);
+            AddPlugin(path, nullptr, id);
+            std::unique_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+            m_DeferredTypes.insert(id);
+            count++;
+            continue;
+        }
+        probes.push_back(path);
+    }
+
+    struct Probe
+    {
+        DLClass<NodeTypeInfo>*  m_Object {nullptr};
+        shared_ptr<NodeTypeInfo> m_Info;
+        int32_t                 m_Version {0};
+    };
+    std::vector<Probe> results(probes.size());
+    PluginManifest::ParallelFor(probes.size(), [&](size_t i)
+    {
+        auto dlobject = new DLClass<NodeTypeInfo>(probes[i].c_str());
+        auto info = dlobject->make_obj();
+        if (!info)
+        {
+            delete dlobject;
+            return;
+        }
+        results[i].m_Object = dlobject;
+        results[i].m_Info = info;
+        results[i].m_Version = dlobject->get_version();
     });
 
-    if (it == m_CustomNodes.end())
+    // register in directory order, same as calling RegisterNodeType one by one
+    for (size_t i = 0; i < probes.size(); i++)
+    {
+        auto& result = results[i];
+        if (!result.m_Info)
+        {
+            LOGE("Load Extra Node Failed %s", probes[i].c_str());
+            if (manifest) manifest->Update(probes[i], false);
+            continue;
+        }
+        if (result.m_Version < VERSION_BLUEPRINT)
+        {
+            LOGW("[RegisterNodeType] Warring Node BluePrint Version(%d.%d.%d.%d) less then App BluePrint Version(%d.%d.%d.%d)\n", 
+                    VERSION_MAJOR(result.m_Version), VERSION_MINOR(result.m_Version), VERSION_PATCH(result.m_Version), VERSION_BUILT(result.m_Version),
+                    VERSION_MAJOR(VERSION_BLUEPRINT), VERSION_MINOR(VERSION_BLUEPRINT), VERSION_PATCH(VERSION_BLUEPRINT), VERSION_BUILT(VERSION_BLUEPRINT));
+        }
+        m_ExternalObject.push_back(result.m_Object);
+        auto id = RegisterNodeType(result.m_Info);
+        AddPlugin(probes[i], result.m_Object, id);
+        auto& info = *result.m_Info;
+        LOGI("Load Extra Node %s(%d.%d.%d.%d)", info.m_NodeTypeName.c_str(),
+                                                VERSION_MAJOR(info.m_Version), 
+                                                VERSION_MINOR(info.m_Version), 
+                                                VERSION_PATCH(info.m_Version), 
+                                                VERSION_BUILT(info.m_Version));
+        if (manifest)
+            manifest->Update(probes[i], true, TypeInfoToJson(info));
+        count++;
+    }
+    return count;
+}
+
+// Called with m_TypesMutex held
+NodeTypeInfo::Factory NodeRegistry::GetFactory(const NodeTypeInfo* info) const
+{
+    if (m_DeferredTypes.find(info->m_ID) == m_DeferredTypes.end())
+        return info->m_Factory;
+    // loader threads may create the first node of a type at the same time
+    std::lock_guard<std::mutex> lock(m_PluginMutex);
+    if (!info->m_Factory)
+        const_cast<NodeRegistry*>(this)->LoadDeferredPlugin(info->m_ID);
+    return info->m_Factory;
+}
+
+void NodeRegistry::LoadDeferredPlugin(ID_TYPE typeId)
+{
+    auto plugin = std::find_if(m_Plugins.begin(), m_Plugins.end(), [typeId](const PluginRecord& record) { return record.m_TypeID == typeId; });
+    auto type = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [typeId](const NodeTypeInfo& typeInfo) { return typeInfo.m_ID == typeId; });
+    if (plugin == m_Plugins.end() || plugin->m_Object || type == m_CustomNodes.end())
         return;
 
-    m_CustomNodes.erase(it);
+    auto dlobject = new DLClass<NodeTypeInfo>(plugin->m_Path.c_str());
+    auto info = dlobject->make_obj();
+    if (!info || info->m_ID != typeId)
+    {
+        LOGE("[NodeRegistry] Load %s failed, it no longer provides the cached node type", plugin->m_Path.c_str());
+        info.reset();
+        delete dlobject;
+        return;
+    }
+    type->m_Factory = info->m_Factory;
+    m_ExternalObject.push_back(dlobject);
+    plugin->m_Object = dlobject;
+    LOGI("Load Extra Node %s(%d.%d.%d.%d)", info->m_NodeTypeName.c_str(),
+                                            VERSION_MAJOR(info->m_Version), 
+                                            VERSION_MINOR(info->m_Version), 
+                                            VERSION_PATCH(info->m_Version), 
+                                            VERSION_BUILT(info->m_Version));
+}
 
-    RebuildTypes();
+void NodeRegistry::AttachBlueprint(BP* blueprint)
+{
+    std::lock_guard<std::mutex> lock(m_BlueprintsMutex);
+    m_Blueprints.insert(blueprint);
 }
 
-void NodeRegistry::RebuildTypes()
+void NodeRegistry::DetachBlueprint(BP* blueprint)
 {
-    m_Types.resize(0);
-    m_Types.reserve(m_CustomNodes.size() + std::distance(std::begin(m_BuildInNodes), std::end(m_BuildInNodes)));
+    std::lock_guard<std::mutex> lock(m_BlueprintsMutex);
+    m_Blueprints.erase(blueprint);
+}
 
-    for (auto& typeInfo : m_CustomNodes)
-        m_Types.push_back(&typeInfo);
+void NodeRegistry::AddPlugin(const std::string& path, DLClass<NodeTypeInfo>* object, ID_TYPE id)
+{
+    PluginRecord plugin;
+    plugin.m_Path = path;
+    plugin.m_Object = object;
+    plugin.m_TypeID = id;
+    PluginManifest::Stat(path, plugin.m_MTime, plugin.m_Size);
+
+    auto it = std::find_if(m_Plugins.begin(), m_Plugins.end(), [&](const PluginRecord& record) { return record.m_Path == path; });
+    if (it != m_Plugins.end())
+        *it = std::move(plugin);
+    else
+        m_Plugins.push_back(std::move(plugin));
 
-    for (auto& typeInfo : m_BuildInNodes)
-        m_Types.push_back(&typeInfo);
+#if defined(__linux__)
+    if (m_WatchFD >= 0)
+    {
+        auto separator = path.find_last_of('/');
+        auto dir = separator == std::string::npos ? std::string(".") : path.substr(0, separator);
+        int wd = inotify_add_watch(m_WatchFD, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd >= 0) m_WatchDirs[wd] = dir;
+    }
+#endif
+}
 
-    std::sort(m_Types.begin(), m_Types.end(), [](const NodeTypeInfo* lhs, const NodeTypeInfo* rhs) { return lhs->m_ID < rhs->m_ID; });
-    m_Types.erase(std::unique(m_Types.begin(), m_Types.end()), m_Types.end());
+void NodeRegistry::EnablePluginWatch(bool enable)
+{
+#if defined(__linux__)
+    if (!enable)
+    {
+        if (m_WatchFD >= 0)
+            close(m_WatchFD);
+        m_WatchFD = -1;
+        m_WatchDirs.clear();
+        return;
+    }
+    if (m_WatchFD >= 0)
+        return;
+    m_WatchFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_WatchFD < 0)
+    {
+        LOGW("[NodeRegistry] inotify unavailable, polling plugin files");
+        return;
+    }
+    for (auto& plugin : m_Plugins)
+    {
+        auto separator = plugin.m_Path.find_last_of('/');
+        auto dir = separator == std::string::npos ? std::string(".") : plugin.m_Path.substr(0, separator);
+        int wd = inotify_add_watch(m_WatchFD, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd >= 0) m_WatchDirs[wd] = dir;
+    }
+#else
+    (void)enable;
+#endif
+}
+
+bool NodeRegistry::IsPluginWatchPolling() const
+{
+#if defined(__linux__)
+    return m_WatchFD < 0;
+#else
+    return true;
+#endif
+}
 
-    // rebuild catalog
-    for (auto type : m_Types)
+int NodeRegistry::CheckPluginUpdates()
+{
+    if (m_Plugins.empty())
+        return 0;
+
+    std::set<std::string> candidates;
+#if defined(__linux__)
+    if (m_WatchFD >= 0)
     {
-        bool alread_in_list = false;
-        for (auto catalog : m_Catalogs)
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(m_WatchFD, buffer, sizeof(buffer))) > 0)
         {
-            if (catalog.compare(type->m_Catalog) == 0)
+            for (char* ptr = buffer; ptr < buffer + length; )
             {
-                alread_in_list = true;
-                break;
+                auto event = (const struct inotify_event *)ptr;
+                auto dir = m_WatchDirs.find(event->wd);
+                if (event->len && dir != m_WatchDirs.end())
+                    candidates.insert(dir->second + "/" + event->name);
+                ptr += sizeof(struct inotify_event) + event->len;
             }
         }
-        if (!alread_in_list)
+        if (candidates.empty())
+            return 0;
+    }
+    else
+#endif
+    {
+        for (auto& plugin : m_Plugins)
+            candidates.insert(plugin.m_Path);
+    }
+
+    int count = 0;
+    for (auto& plugin : m_Plugins)
+    {
+        if (candidates.find(plugin.m_Path) == candidates.end())
+            continue;
+        int64_t mtime = 0, size = 0;
+        if (!PluginManifest::Stat(plugin.m_Path, mtime, size) || (mtime == plugin.m_MTime && size == plugin.m_Size))
+            continue;
+        // remember the attempt, a broken build is retried on the next change only
+        plugin.m_MTime = mtime;
+        plugin.m_Size = size;
+        if (ReloadPlugin(plugin))
+            count++;
+    }
+    return count;
+}
+
+void NodeRegistry::DropPrototype(ID_TYPE typeId)
+{
+    std::lock_guard<std::mutex> lock(m_NodesMutex);
+    auto it = m_NodeIndex.find(typeId);
+    if (it == m_NodeIndex.end())
+        return;
+    m_Nodes.erase(std::remove(m_Nodes.begin(), m_Nodes.end(), it->second), m_Nodes.end());
+    delete it->second;
+    m_NodeIndex.erase(it);
+}
+
+bool NodeRegistry::ReloadPlugin(PluginRecord& plugin)
+{
+    // the loader returns the already mapped library for a known path, load a copy instead
+    std::string tmpDir = GetUserCacheDir("reload");
+    if (tmpDir.empty())
+    {
+        LOGE("[NodeRegistry] Reload %s failed, no user cache directory", plugin.m_Path.c_str());
+        return false;
+    }
+    auto separator = plugin.m_Path.find_last_of("\\/");
+    auto name = separator == std::string::npos ? plugin.m_Path : plugin.m_Path.substr(separator + 1);
+    // the cache is shared by every running instance
+    auto loadedPath = tmpDir + "/bp_reload_" + std::to_string(getpid()) + "_" + std::to_string(++m_ReloadCount) + "_" + name;
+    {
+        std::ifstream src(plugin.m_Path, std::ios::binary);
+        std::ofstream dst(loadedPath, std::ios::binary);
+        if (!src || !dst || !(dst << src.rdbuf()))
         {
-            m_Catalogs.push_back(type->m_Catalog);
+            LOGE("[NodeRegistry] Reload %s failed, can't copy to %s", plugin.m_Path.c_str(), loadedPath.c_str());
+            remove(loadedPath.c_str());
+            return false;
         }
-        bool alread_in_nodes = false;
-        for (auto node : m_Nodes)
+    }
+
+    auto dlobject = new DLClass<NodeTypeInfo>(loadedPath.c_str());
+    auto info = dlobject->make_obj();
+    if (!info)
+    {
+        LOGE("[NodeRegistry] Reload %s failed, keep running the old version", plugin.m_Path.c_str());
+        delete dlobject;
+        remove(loadedPath.c_str());
+        return false;
+    }
+
+    auto oldTypeId = plugin.m_TypeID;
+    auto oldObject = plugin.m_Object;
+    auto oldLoadedPath = plugin.m_LoadedPath;
+
+    // the old type info points into the old library, replace it before anything is created
+    if (info->m_ID != oldTypeId)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+        auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [oldTypeId](const NodeTypeInfo& typeInfo) { return typeInfo.m_ID == oldTypeId; });
+        if (it != m_CustomNodes.end())
         {
-            if (node->GetTypeID() == type->m_ID)
+            RemoveType(&*it);
+            m_CustomNodes.erase(it);
+        }
+    }
+    m_ExternalObject.push_back(dlobject);
+    auto newTypeId = RegisterNodeType(info);
+    info.reset();
+    DropPrototype(oldTypeId);
+
+    plugin.m_Object = dlobject;
+    plugin.m_TypeID = newTypeId;
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+        m_DeferredTypes.erase(oldTypeId);
+    }
+    plugin.m_LoadedPath = loadedPath;
+
+    std::set<BP*> blueprints;
+    {
+        std::lock_guard<std::mutex> lock(m_BlueprintsMutex);
+        blueprints = m_Blueprints;
+    }
+    int migrated = 0;
+    for (auto blueprint : blueprints)
+        migrated += blueprint->ReloadNodes(oldTypeId, newTypeId);
+
+    // no live node references the old code anymore
+    m_ExternalObject.erase(std::remove(m_ExternalObject.begin(), m_ExternalObject.end(), oldObject), m_ExternalObject.end());
+    delete oldObject;
+    if (!oldLoadedPath.empty())
+        remove(oldLoadedPath.c_str());
+
+    LOGI("[NodeRegistry] Reloaded %s, %d live nodes migrated", plugin.m_Path.c_str(), migrated);
+    return true;
+}
+
+void NodeRegistry::UnregisterNodeType(std::string name)
+{
+    std::unique_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+    auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [name](const NodeTypeInfo& typeInfo)
+    {
+        return typeInfo.m_Name == name;
+    });
+
+    if (it == m_CustomNodes.end())
+        return;
+
+    auto id = it->m_ID;
+    RemoveType(&*it);
+    m_CustomNodes.erase(it);
+
+    // bring back the build-in type it was shadowing
+    for (auto typeInfo : m_BuildInNodes)
+    {
+        if (typeInfo->m_ID == id)
+        {
+            AddType(typeInfo);
+            break;
+        }
+    }
+}
+
+void NodeRegistry::AddType(const NodeTypeInfo* info)
+{
+    auto found = m_TypeIndex.find(info->m_ID);
+    if (found != m_TypeIndex.end())
+    {
+        if (found->second == info)
+            return;
+        RemoveType(found->second);
+    }
+
+    auto pos = std::lower_bound(m_Types.begin(), m_Types.end(), info, [](const NodeTypeInfo* lhs, const NodeTypeInfo* rhs) { return lhs->m_ID < rhs->m_ID; });
+    m_Types.insert(pos, info);
+    m_TypeIndex[info->m_ID] = info;
+    m_NameIndex.emplace(info->m_Name, info);
+
+    auto& catalogTypes = m_CatalogIndex[info->m_Catalog];
+    if (catalogTypes.empty())
+        m_Catalogs.push_back(info->m_Catalog);
+    catalogTypes.push_back(info);
+    m_Revision++;
+}
+
+void NodeRegistry::RemoveType(const NodeTypeInfo* info)
+{
+    auto pos = std::lower_bound(m_Types.begin(), m_Types.end(), info, [](const NodeTypeInfo* lhs, const NodeTypeInfo* rhs) { return lhs->m_ID < rhs->m_ID; });
+    if (pos != m_Types.end() && *pos == info)
+        m_Types.erase(pos);
+
+    auto typeIt = m_TypeIndex.find(info->m_ID);
+    if (typeIt != m_TypeIndex.end() && typeIt->second == info)
+        m_TypeIndex.erase(typeIt);
+
+    auto nameIt = m_NameIndex.find(info->m_Name);
+    if (nameIt != m_NameIndex.end() && nameIt->second == info)
+    {
+        m_NameIndex.erase(nameIt);
+        // another type may share the name
+        for (auto type : m_Types)
+        {
+            if (type->m_Name == info->m_Name)
             {
-                alread_in_nodes = true;
+                m_NameIndex.emplace(type->m_Name, type);
                 break;
             }
         }
-        if (!alread_in_nodes)
+    }
+
+    auto catalogIt = m_CatalogIndex.find(info->m_Catalog);
+    if (catalogIt != m_CatalogIndex.end())
+    {
+        auto& catalogTypes = catalogIt->second;
+        catalogTypes.erase(std::remove(catalogTypes.begin(), catalogTypes.end(), info), catalogTypes.end());
+        if (catalogTypes.empty())
         {
-            auto node = Create(type->m_ID, nullptr);
-            if (node) m_Nodes.push_back(node);
+            m_CatalogIndex.erase(catalogIt);
+            m_Catalogs.erase(std::remove(m_Catalogs.begin(), m_Catalogs.end(), info->m_Catalog), m_Catalogs.end());
         }
     }
+    m_Revision++;
 }
 
 Node* NodeRegistry::Create(ID_TYPE typeId, BP* blueprint)
 {
-    for (auto& nodeInfo : m_Types)
+    NodeTypeInfo::Factory factory = nullptr;
     {
-        if (nodeInfo->m_ID != typeId)
-            continue;
-
-        return nodeInfo->m_Factory(blueprint);
+        std::shared_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+        auto it = m_TypeIndex.find(typeId);
+        if (it == m_TypeIndex.end())
+            return nullptr;
+        factory = GetFactory(it->second);
     }
-
-    return nullptr;
+    return factory ? factory(blueprint) : nullptr;
 }
 
 Node* NodeRegistry::Create(std::string typeName, BP* blueprint)
 {
-    for (auto& nodeInfo : m_Types)
+    NodeTypeInfo::Factory factory = nullptr;
     {
-        if (nodeInfo->m_Name != typeName)
-            continue;
-
-        return nodeInfo->m_Factory(blueprint);
+        std::shared_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+        auto it = m_NameIndex.find(typeName);
+        if (it == m_NameIndex.end())
+            return nullptr;
+        factory = GetFactory(it->second);
     }
-
-    return nullptr;
+    return factory ? factory(blueprint) : nullptr;
 }
 
 span<const NodeTypeInfo* const> NodeRegistry::GetTypes() const
@@ -409,6 +842,16 @@ span<const NodeTypeInfo* const> NodeRegistry::GetTypes() const
     return make_span(begin, end);
 }
 
+span<const NodeTypeInfo* const> NodeRegistry::GetTypes(const std::string& catalog) const
+{
+    auto it = m_CatalogIndex.find(catalog);
+    if (it == m_CatalogIndex.end())
+        return {};
+    const NodeTypeInfo* const* begin = it->second.data();
+    const NodeTypeInfo* const* end   = it->second.data() + it->second.size();
+    return make_span(begin, end);
+}
+
 span<const std::string> NodeRegistry::GetCatalogs() const
 {
     const std::string *begin = m_Catalogs.data();
@@ -416,21 +859,58 @@ span<const std::string> NodeRegistry::GetCatalogs() const
     return make_span(begin, end);
 }
 
-span<const Node * const> NodeRegistry::GetNodes() const
+std::vector<const Node*> NodeRegistry::GetNodes() const
 {
-    const Node* const* begin = m_Nodes.data();
-    const Node* const* end   = m_Nodes.data() + m_Nodes.size();
-    return make_span(begin, end);
+    std::vector<const NodeTypeInfo*> types;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+        types = m_Types;
+    }
+    // prototypes not asked for yet are built here
+    std::vector<const Node*> nodes;
+    nodes.reserve(types.size());
+    for (auto type : types)
+        if (auto node = GetNode(type->m_ID))
+            nodes.push_back(node);
+    return nodes;
 }
 
-const NodeTypeInfo* NodeRegistry::GetTypeInfo(ID_TYPE typeId) const
+const Node* NodeRegistry::GetNode(ID_TYPE typeId) const
 {
-    for (auto& nodeInfo : m_Types)
+    std::lock_guard<std::mutex> lock(m_NodesMutex);
+    auto it = m_NodeIndex.find(typeId);
+    if (it != m_NodeIndex.end())
+        return it->second;
+
+    NodeTypeInfo::Factory factory = nullptr;
     {
-        if (nodeInfo->m_ID == typeId)
-            return nodeInfo;
+        std::shared_lock<std::shared_timed_mutex> types_lock(m_TypesMutex);
+        auto type = m_TypeIndex.find(typeId);
+        if (type != m_TypeIndex.end())
+            factory = GetFactory(type->second);
     }
-    return nullptr;
+    if (!factory)
+        return nullptr;
+    auto node = factory(nullptr);
+    if (!node)
+        return nullptr;
+    m_Nodes.push_back(node);
+    m_NodeIndex[typeId] = node;
+    return node;
+}
+
+const NodeTypeInfo* NodeRegistry::GetTypeInfo(ID_TYPE typeId) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+    auto it = m_TypeIndex.find(typeId);
+    return it != m_TypeIndex.end() ? it->second : nullptr;
+}
+
+const NodeTypeInfo* NodeRegistry::GetTypeInfo(const std::string& typeName) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(m_TypesMutex);
+    auto it = m_NameIndex.find(typeName);
+    return it != m_NameIndex.end() ? it->second : nullptr;
 }
 
 // ----------------------
@@ -531,11 +1011,21 @@ std::string Node::GetCatalog() const
 void Node::SetName(std::string name)
 {
     m_Name = name;
+    m_Dirty = true;
 }
 
 void Node::SetBreakPoint(bool breaken)
 {
     m_BreakPoint = breaken;
+    m_Dirty = true;
+}
+
+void Node::SetGroupID(ID_TYPE group_id)
+{
+    if (m_GroupID == group_id)
+        return;
+    m_GroupID = group_id;
+    m_Dirty = true;
 }
 
 bool Node::HasSetting() const
@@ -548,6 +1038,11 @@ bool Node::Skippable() const
     return false;
 }
 
+bool Node::ParallelLoad() const
+{
+    return false;
+}
+
 bool Node::CustomLayout() const
 {
     return false;
@@ -582,7 +1077,8 @@ void Node::DrawSettingLayout(ImGuiContext * ctx)
         if (m_Name.compare(value) != 0)
         {
             m_Name = value;
-            ed::SetNodeChanged(m_ID);
+            m_Dirty = true;
+            Editor::SetNodeChanged(m_ID);
         }
     }
 }
@@ -618,6 +1114,56 @@ ImTextureID Node::LoadNodeLogo(void * data, int size) const
     return logo;
 }
 
+struct NodeLogoEntry
+{
+    ImTextureID m_Texture   {nullptr};
+    int         m_RefCount  {0};
+};
+static std::mutex                               g_NodeLogoMutex;
+static std::unordered_map<const void*, NodeLogoEntry>  g_NodeLogos;     // keyed by blob address
+
+ImTextureID Node::AcquireNodeLogo(const void * data, int size)
+{
+    if (!data || !size)
+        return nullptr;
+    std::lock_guard<std::mutex> lock(g_NodeLogoMutex);
+    auto& entry = g_NodeLogos[data];
+    if (!entry.m_Texture)
+    {
+        int width = 0, height = 0, component = 0;
+        if (auto _data = stbi_load_from_memory((stbi_uc const *)data, size, &width, &height, &component, 4))
+        {
+            entry.m_Texture = ImGui::ImCreateTexture(_data, width, height);
+            stbi_image_free(_data);
+        }
+        if (!entry.m_Texture)
+        {
+            g_NodeLogos.erase(data);
+            return nullptr;
+        }
+    }
+    entry.m_RefCount++;
+    return entry.m_Texture;
+}
+
+void Node::ReleaseNodeLogo(ImTextureID logo)
+{
+    if (!logo)
+        return;
+    std::lock_guard<std::mutex> lock(g_NodeLogoMutex);
+    for (auto it = g_NodeLogos.begin(); it != g_NodeLogos.end(); ++it)
+    {
+        if (it->second.m_Texture != logo)
+            continue;
+        if (--it->second.m_RefCount <= 0)
+        {
+            ImGui::ImDestroyTexture(it->second.m_Texture);
+            g_NodeLogos.erase(it);
+        }
+        return;
+    }
+}
+
 void Node::DrawNodeLogo(ImTextureID logo, int& index, int cols, int rows, ImVec2 size) const
 {
     if (!logo)
@@ -663,6 +1209,26 @@ LinkQueryResult Node::AcceptLink(const Pin& receiver, const Pin& provider) const
     return {true};
 }
 
+const vector<Node*> GetGroupedNodes(Node& node)
+{
+    vector<Node*> result;
+    vector<ID_TYPE> nodes;
+    Editor::GetGroupedNodes(node.m_ID, nodes);
+    for (auto nodeId : nodes)
+    {
+        IM_ASSERT(node.m_Blueprint != nullptr);
+        auto _node = node.m_Blueprint->FindNode(nodeId);
+        if (_node && _node->GetStyle() != NodeStyle::Group)
+        {
+            if (_node->m_GroupID == 0)
+                result.push_back(_node);
+            else if (_node->m_GroupID == node.m_ID)
+                result.push_back(_node);
+        }
+    }
+    return result;
+}
+
 void Node::WasLinked(const Pin& receiver, const Pin& provider)
 {
 }
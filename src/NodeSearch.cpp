@@ -0,0 +1,141 @@
+#include <NodeSearch.h>
+#include <UI.h>
+#include <algorithm>
+#include <ctype.h>
+
+#define NODE_SEARCH_CACHE_SIZE  256
+
+namespace BluePrint
+{
+static std::string ToLower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)::tolower(c); });
+    return s;
+}
+
+void NodeSearchIndex::Update(const NodeRegistry* registry)
+{
+    if (!registry || (registry == m_Registry && registry->GetRevision() == m_Revision && !m_Entries.empty()))
+        return;
+
+    m_Registry = registry;
+    m_Revision = registry->GetRevision();
+    m_Entries.clear();
+    m_Cache.clear();
+    for (auto type : registry->GetTypes())
+    {
+        Entry entry;
+        entry.m_Type = type;
+        entry.m_Catalogs = GetCatalogInfo(type->m_Catalog);
+        if (entry.m_Catalogs.empty() || entry.m_Catalogs[0].compare("Dummy") == 0)
+            continue;
+        for (auto& label : entry.m_Catalogs)
+        {
+            entry.m_MenuLabel += label + " " + ICON_NODE_NEXT + " ";
+            if (!entry.m_Path.empty()) entry.m_Path += " ";
+            entry.m_Path += ToLower(label);
+        }
+        entry.m_MenuLabel += type->m_Name;
+        entry.m_Name = ToLower(type->m_Name);
+        entry.m_TypeName = ToLower(type->m_NodeTypeName);
+        m_Entries.push_back(std::move(entry));
+    }
+    std::sort(m_Entries.begin(), m_Entries.end(), [](const Entry& a, const Entry& b) {
+        return a.m_Type->m_Name < b.m_Type->m_Name;
+    });
+}
+
+bool NodeSearchIndex::MatchCatalog(const Entry& entry, const std::vector<std::string>& filters) const
+{
+    auto& catalogs = entry.m_Catalogs;
+    if (filters.empty())
+        return false;
+    if (catalogs[0].compare(filters[0]) != 0)
+        return entry.m_Type->m_Style == NodeStyle::Comment || entry.m_Type->m_Style == NodeStyle::Group;
+    if (catalogs.size() > 1 && filters.size() > 1)
+    {
+        if (catalogs[1].compare(filters[1]) != 0)
+            return false;
+        if (catalogs.size() > 2 && filters.size() > 2)
+            return catalogs[2].compare(filters[2]) == 0;
+    }
+    return true;
+}
+
+int NodeSearchIndex::FuzzyScore(const std::string& text, const std::string& pattern)
+{
+    if (pattern.empty())
+        return 1;
+
+    // plain substring beats any scattered match, earlier and on a word start is better
+    auto pos = text.find(pattern);
+    if (pos != std::string::npos)
+    {
+        int score = 1000 - (int)std::min<size_t>(pos, 100);
+        if (pos == 0) score += 500;
+        else if (!isalnum((unsigned char)text[pos - 1])) score += 200;
+        return score;
+    }
+
+    int score = 0;
+    int run = 0;
+    size_t next = 0;
+    for (auto c : pattern)
+    {
+        auto found = text.find(c, next);
+        if (found == std::string::npos)
+            return 0;
+        run = (found == next && next > 0) ? run + 1 : 0;
+        score += 10 + run * 5;
+        if (found == 0 || !isalnum((unsigned char)text[found - 1]))
+            score += 15;
+        next = found + 1;
+    }
+    return score;
+}
+
+const std::vector<const NodeSearchIndex::Entry*>& NodeSearchIndex::Query(const std::string& filter, const std::string& catalog_filter)
+{
+    auto pattern = ToLower(filter);
+    auto key = catalog_filter + "\n" + pattern;
+    auto found = m_Cache.find(key);
+    if (found != m_Cache.end())
+        return found->second;
+
+    if (m_Cache.size() >= NODE_SEARCH_CACHE_SIZE)
+        m_Cache.clear();
+
+    if (pattern.empty())
+    {
+        auto& result = m_Cache[key];
+        auto filters = GetCatalogInfo(catalog_filter);
+        for (auto& entry : m_Entries)
+        {
+            if (catalog_filter.empty() || MatchCatalog(entry, filters))
+                result.push_back(&entry);
+        }
+        return result;
+    }
+
+    // a match of "abc" is also a match of "ab", so start from the longest cached prefix
+    std::vector<const Entry*> candidates = Query(pattern.substr(0, pattern.size() - 1), catalog_filter);
+    std::vector<std::pair<int, const Entry*>> scored;
+    for (auto entry : candidates)
+    {
+        int score = std::max({ FuzzyScore(entry->m_Name, pattern) * 4,
+                               FuzzyScore(entry->m_TypeName, pattern) * 2,
+                               FuzzyScore(entry->m_Path, pattern) });
+        if (score > 0)
+            scored.emplace_back(score, entry);
+    }
+    std::sort(scored.begin(), scored.end(), [](const std::pair<int, const Entry*>& a, const std::pair<int, const Entry*>& b) {
+        return a.first != b.first ? a.first > b.first : a.second->m_Type->m_Name < b.second->m_Type->m_Name;
+    });
+
+    auto& result = m_Cache[key];
+    result.reserve(scored.size());
+    for (auto& item : scored)
+        result.push_back(item.second);
+    return result;
+}
+} // namespace BluePrint
@@ -1,10 +1,7 @@
 #include <BluePrint.h>
 #include <Node.h>
-#include <Utils.h>
-#include <imgui_node_editor.h>
-#include <imgui_node_editor_internal.h>
+#include <sstream>
 
-namespace ed = ax::NodeEditor;
 namespace BluePrint
 {
 string PinTypeToString(PinType type)
@@ -130,7 +127,10 @@ bool Pin::LinkTo(Pin& pin)
     {
         pin.m_LinkFrom.push_back(m_ID);
     }
-    ed::SetPinChanged(pin.m_ID);
+    m_Node->m_Dirty = true;
+    pin.m_Node->m_Dirty = true;
+    m_Node->m_Blueprint->TouchLinks();
+    Editor::SetPinChanged(pin.m_ID);
 
     return true;
 }
@@ -169,7 +169,10 @@ void Pin::Unlink()
         link->m_Flags &= ~PIN_FLAG_LINKED;
     }
 
-    ed::SetLinkChanged(link->m_ID);
+    m_Node->m_Dirty = true;
+    link->m_Node->m_Dirty = true;
+    bp->TouchLinks();
+    Editor::SetLinkChanged(link->m_ID);
 }
 
 bool Pin::IsLinked() const
@@ -241,6 +244,15 @@ bool Pin::IsMappedPin() const
     return (m_Flags & PIN_FLAG_BRIDGE) || (m_Flags & PIN_FLAG_SHADOW);
 }
 
+void Pin::SetFlag(ID_TYPE flag, bool enable)
+{
+    ID_TYPE flags = enable ? (m_Flags | flag) : (m_Flags & ~flag);
+    if (flags == m_Flags)
+        return;
+    m_Flags = flags;
+    if (m_Node) m_Node->m_Dirty = true;
+}
+
 bool Pin::IsLinkedExportedPin() const
 {
     if (!m_Node || !m_Node->m_Blueprint)
@@ -605,7 +617,9 @@ bool Vec2Pin::Load(const imgui_json::value& value)
 void Vec2Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
 {
     Pin::Save(value, MapID);
-    value["vec"] = ed::Detail::Serialization::ToJson(m_Value);
+    auto& vec = value["vec"];
+    vec["x"] = imgui_json::number(m_Value.x);
+    vec["y"] = imgui_json::number(m_Value.y);
 }
 
 // Vec4Pin
@@ -627,7 +641,11 @@ bool Vec4Pin::Load(const imgui_json::value& value)
 void Vec4Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
 {
     Pin::Save(value, MapID);
-    value["vec"] = ed::Detail::Serialization::ToJson(m_Value);
+    auto& vec = value["vec"];
+    vec["x"] = imgui_json::number(m_Value.x);
+    vec["y"] = imgui_json::number(m_Value.y);
+    vec["z"] = imgui_json::number(m_Value.z);
+    vec["w"] = imgui_json::number(m_Value.w);
 }
 
 // MatPin
@@ -713,51 +731,104 @@ LinkQueryResult CustomPin::CanLinkTo(const Pin& pin) const
 
 PinExRegistry::~PinExRegistry()
 {
-    if (m_dll_handle)
-        dlclose(m_dll_handle);
+    for (auto handle : m_dll_handles)
+        dlclose(handle);
 }
 
-const PinTypeEx* PinExRegistry::RegisterPinEx(std::string module_path)
+const PinExModuleInfo* PinExRegistry::OpenPinEx(const std::string& module_path, void*& handle)
 {
-    m_dll_handle = dlopen(module_path.c_str(), RTLD_LAZY);
-	if (!m_dll_handle) {
+    handle = dlopen(module_path.c_str(), RTLD_LAZY);
+	if (!handle) {
 		std::cerr << "Failed to open library: " << dlerror() << std::endl;
 		return nullptr;
 	}
 
-	// Reset errors
-	dlerror();
-
-	GET_PINEX_MODULE_INFO_FN* pfnGetPinExModuleInfo = (GET_PINEX_MODULE_INFO_FN*) dlsym(m_dll_handle, "GetPinExModuleInfo");
-	const char* err = dlerror();
-	if (err) {
-		std::cerr << "Failed to load version symbol: " << err << std::endl;
-		dlclose(m_dll_handle);
-        m_dll_handle = nullptr;
+	GET_PINEX_MODULE_INFO_FN* pfnGetPinExModuleInfo = (GET_PINEX_MODULE_INFO_FN*) dlsym(handle, "GetPinExModuleInfo");
+	if (!pfnGetPinExModuleInfo) {
+		std::cerr << "Failed to load version symbol from '" << module_path << "'!" << std::endl;
+		dlclose(handle);
+        handle = nullptr;
 		return nullptr;
 	}
 
     const PinExModuleInfo* pModInfo = pfnGetPinExModuleInfo();
     if (pModInfo == nullptr) {
         std::cerr << "PinExModulueInfo is NULL from '" << module_path << "'!" << std::endl;
-        dlclose(m_dll_handle);
-        m_dll_handle = nullptr;
+        dlclose(handle);
+        handle = nullptr;
         return nullptr;
     }
+    return pModInfo;
+}
 
+const PinTypeEx* PinExRegistry::AddPinEx(const std::string& module_path, const PinExModuleInfo* pModInfo, void* handle)
+{
     for (auto pInfo : m_TypeInfos) {
         if (pInfo->m_TypeEx == pModInfo->m_TypeEx) {
             std::cerr << "Conflict PinTypeEx '" << pModInfo->m_TypeEx.GetName() << "', FAILED to load PinEx from '" << module_path << "'!" << std::endl;
-            dlclose(m_dll_handle);
-            m_dll_handle = nullptr;
+            dlclose(handle);
             return nullptr;
         }
     }
 
     m_TypeInfos.push_back(pModInfo);
+    m_dll_handles.push_back(handle);
     return &pModInfo->m_TypeEx;
 }
 
+const PinTypeEx* PinExRegistry::RegisterPinEx(std::string module_path)
+{
+    void* handle = nullptr;
+    auto pModInfo = OpenPinEx(module_path, handle);
+    if (!pModInfo)
+        return nullptr;
+    return AddPinEx(module_path, pModInfo, handle);
+}
+
+int PinExRegistry::RegisterPinExs(const std::vector<std::string>& module_paths, PluginManifest* manifest)
+{
+    std::vector<std::string> probes;
+    for (auto& path : module_paths)
+    {
+        if (manifest && manifest->IsKnownBad(path))
+        {
+            LOGI("[RegisterPinExs] Skip %s, failed to load last time", path.c_str());
+            continue;
+        }
+        probes.push_back(path);
+    }
+
+    std::vector<const PinExModuleInfo*> infos(probes.size(), nullptr);
+    std::vector<void*> handles(probes.size(), nullptr);
+    PluginManifest::ParallelFor(probes.size(), [&](size_t i)
+    {
+        infos[i] = OpenPinEx(probes[i], handles[i]);
+    });
+
+    // conflicts are resolved in directory order, same as calling RegisterPinEx one by one
+    int count = 0;
+    for (size_t i = 0; i < probes.size(); i++)
+    {
+        auto pPinexType = infos[i] ? AddPinEx(probes[i], infos[i], handles[i]) : nullptr;
+        if (!pPinexType)
+        {
+            LOGE("FAILED to load PinEx from '%s'!", probes[i].c_str());
+            // a conflict depends on the other plugins, only remember broken libraries
+            if (manifest && !infos[i]) manifest->Update(probes[i], false);
+            continue;
+        }
+        LOGI("Successfully loaded PinEx from '%s'!", probes[i].c_str());
+        if (manifest)
+        {
+            imgui_json::value value;
+            value["name"] = pPinexType->GetName();
+            manifest->Update(probes[i], true, value);
+        }
+        count++;
+    }
+    return count;
+}
+
 PinEx* PinExRegistry::Create(std::string typeName)
 {
     for (auto typeInfo : m_TypeInfos) {
@@ -0,0 +1,151 @@
+#include <PluginManifest.h>
+#include <BluePrint.h>
+#include <Log.h>
+#include <sys/stat.h>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#define PLUGIN_MANIFEST_VERSION     1
+
+namespace BluePrint
+{
+bool PluginManifest::Load(const std::string& path)
+{
+    m_Path = path;
+    m_Entries.clear();
+    m_Modified = false;
+
+    auto loadResult = imgui_json::value::load(path);
+    if (!loadResult.second)
+        return false;
+
+    auto& value = loadResult.first;
+    int version = 0;
+    if (!imgui_json::GetTo<imgui_json::number>(value, "version", version) || version != PLUGIN_MANIFEST_VERSION)
+        return false;
+
+    const imgui_json::object* plugins = nullptr;
+    if (!imgui_json::GetPtrTo(value, "plugins", plugins))
+        return false;
+
+    for (auto& item : *plugins)
+    {
+        Entry entry;
+        double mtime = 0, size = 0;
+        if (!imgui_json::GetTo<imgui_json::number>(item.second, "mtime", mtime) ||
+            !imgui_json::GetTo<imgui_json::number>(item.second, "size", size) ||
+            !imgui_json::GetTo<imgui_json::boolean>(item.second, "valid", entry.m_Valid))
+            continue;
+        entry.m_MTime = (int64_t)mtime;
+        entry.m_Size = (int64_t)size;
+        if (item.second.contains("info"))
+            entry.m_Info = item.second["info"];
+        m_Entries[item.first] = std::move(entry);
+    }
+    return true;
+}
+
+bool PluginManifest::Save() const
+{
+    if (m_Path.empty() || !m_Modified)
+        return true;
+
+    imgui_json::value value;
+    value["version"] = imgui_json::number(PLUGIN_MANIFEST_VERSION);
+    auto& plugins = value["plugins"];
+    plugins = imgui_json::object();
+    for (auto& item : m_Entries)
+    {
+        imgui_json::value entry;
+        entry["mtime"] = imgui_json::number(item.second.m_MTime);
+        entry["size"] = imgui_json::number(item.second.m_Size);
+        entry["valid"] = imgui_json::boolean(item.second.m_Valid);
+        if (!item.second.m_Info.is_null())
+            entry["info"] = item.second.m_Info;
+        plugins[item.first] = std::move(entry);
+    }
+    if (!value.save(m_Path))
+    {
+        LOGW("[PluginManifest] Can't write %s", m_Path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool PluginManifest::Stat(const std::string& plugin, int64_t& mtime, int64_t& size)
+{
+    struct stat st;
+    if (stat(plugin.c_str(), &st) != 0)
+        return false;
+    mtime = (int64_t)st.st_mtime;
+    size = (int64_t)st.st_size;
+    return true;
+}
+
+std::string PluginManifest::DefaultPath(const std::string& plugin_dir)
+{
+    auto dir = GetUserCacheDir("plugins");
+    if (dir.empty())
+        return "";
+    return dir + "/" + IDToHexString(fnv1a_hash_32(plugin_dir)) + ".json";
+}
+
+const PluginManifest::Entry* PluginManifest::Find(const std::string& plugin) const
+{
+    auto it = m_Entries.find(plugin);
+    if (it == m_Entries.end())
+        return nullptr;
+    int64_t mtime = 0, size = 0;
+    if (!Stat(plugin, mtime, size) || mtime != it->second.m_MTime || size != it->second.m_Size)
+        return nullptr;
+    return &it->second;
+}
+
+bool PluginManifest::IsKnownBad(const std::string& plugin) const
+{
+    auto entry = Find(plugin);
+    return entry && !entry->m_Valid;
+}
+
+const imgui_json::value* PluginManifest::GetInfo(const std::string& plugin) const
+{
+    auto entry = Find(plugin);
+    return entry && entry->m_Valid ? &entry->m_Info : nullptr;
+}
+
+void PluginManifest::Update(const std::string& plugin, bool valid, const imgui_json::value& info)
+{
+    Entry entry;
+    if (!Stat(plugin, entry.m_MTime, entry.m_Size))
+        return;
+    entry.m_Valid = valid;
+    entry.m_Info = info;
+    m_Entries[plugin] = std::move(entry);
+    m_Modified = true;
+}
+
+void PluginManifest::ParallelFor(size_t count, const std::function<void(size_t)>& job)
+{
+    size_t workers = 1;
+#if !defined(__EMSCRIPTEN__)
+    workers = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+#endif
+    std::atomic<size_t> next {0};
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < count; i = next++)
+            job(i);
+    };
+    if (workers > 1)
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < workers; i++)
+            threads.emplace_back(worker);
+        for (auto& thread : threads)
+            thread.join();
+    }
+    else
+        worker();
+}
+} // namespace BluePrint
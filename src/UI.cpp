@@ -3,6 +3,7 @@
 #include <imgui_node_editor_internal.h>
 #include <iomanip>
 #include <utility>
+#include <unordered_set>
 #define THUMBNAIL_COUNT     100
 #define THUMBNAIL_HIDDEN    30
 #define DEBUG_NODE_DRAWING  0
@@ -21,6 +22,41 @@ const string titlebar_icons[] = {ICON_NODE_COPY, ICON_NODE_DELETE, ICON_NODE_SET
 
 namespace BluePrint
 {
+// Route the runtime's editor notifications to the current node editor
+static EditorHooks MakeNodeEditorHooks()
+{
+    EditorHooks hooks;
+    hooks.NodeChanged       = [](ID_TYPE node) { ed::SetNodeChanged(node); };
+    hooks.PinChanged        = [](ID_TYPE pin) { ed::SetPinChanged(pin); };
+    hooks.LinkChanged       = [](ID_TYPE link) { ed::SetLinkChanged(link); };
+    hooks.GetNodePosition   = [](ID_TYPE node) { return ed::GetNodePosition(node); };
+    hooks.SetNodePosition   = [](ID_TYPE node, const ImVec2& pos) { ed::SetNodePosition(node, pos); };
+    hooks.GetNodeSize       = [](ID_TYPE node) { return ed::GetNodeSize(node); };
+    hooks.SetNodeSize       = [](ID_TYPE node, const ImVec2& size) { ed::SetNodeSize(node, size); };
+    hooks.GetGroupSize      = [](ID_TYPE node) { return ed::GetGroupSize(node); };
+    hooks.SetGroupSize      = [](ID_TYPE node, const ImVec2& size) { ed::SetGroupSize(node, size); };
+    hooks.SetNodeGroupID    = [](ID_TYPE node, ID_TYPE group) { ed::SetNodeGroupID(node, group ? ed::NodeId(group) : ed::NodeId::Invalid); };
+    hooks.SetNodeZPosition  = [](ID_TYPE node, float z) { ed::SetNodeZPosition(node, z); };
+    hooks.GetGroupedNodes   = [](ID_TYPE group, vector<ID_TYPE>& nodes)
+    {
+        vector<ed::NodeId> nodeIds;
+        ed::GetGroupedNodes(nodeIds, group, ImVec2(40, 40));
+        for (auto nodeId : nodeIds) nodes.push_back(static_cast<ID_TYPE>(nodeId.Get()));
+    };
+    hooks.BeginFlow         = []()
+    {
+        ed::PushStyleVar(ed::StyleVar_FlowMarkerDistance, 30.0f);
+        ed::PushStyleVar(ed::StyleVar_FlowDuration, 1.0f);
+    };
+    hooks.Flow              = [](ID_TYPE pin, bool forward) { ed::Flow(pin, forward ? ed::FlowDirection::Forward : ed::FlowDirection::Backward); };
+    hooks.EndFlow           = []() { ed::PopStyleVar(2); };
+    hooks.ScreenToCanvas    = [](const ImVec2& pos) { return ed::ScreenToCanvas(pos); };
+    hooks.Suspend           = []() { ed::Suspend(); };
+    hooks.Resume            = []() { ed::Resume(); };
+    return hooks;
+}
+static const EditorHooks g_NodeEditorHooks = MakeNodeEditorHooks();
+
 BluePrintStyle BPStyleFromName(string name)
 {
     if (name.compare("Default") == 0)
@@ -305,6 +341,7 @@ void NodeSettingDialog::Show(BluePrintUI& UI)
         if (ImGui::Button("OK", ImVec2(120, 0))) 
         {
             UI.m_Document->m_IsModified = true;
+            node->m_Dirty = true;
             ed::SetNodeChanged(node->m_ID);
             ImGui::CloseCurrentPopup();
             if (UI.m_CallBacks.BluePrintOnChanged)
@@ -520,6 +557,7 @@ void BluePrintUI::Initialize(const char * bp_file, const char * plugin_path)
     m_Config.SettingsFile = nullptr;
 #endif
     InstallDocumentCallbacks();
+    SetEditorHooks(&g_NodeEditorHooks);
     m_Editor = ed::CreateEditor(&m_Config);
     ed::SetCurrentEditor(m_Editor);
     m_Document = make_unique<BluePrint::Document>();
@@ -531,29 +569,13 @@ void BluePrintUI::Initialize(const char * bp_file, const char * plugin_path)
     std::vector<std::string> plugins, plugin_names;
     std::vector<std::string> node_filter = {"node"};
     std::vector<std::string> pin_filter = {"pin"};
+    BluePrint::PluginManifest manifest;
+    if (!plugin_real_path.empty())
+        manifest.Load(BluePrint::PluginManifest::DefaultPath(plugin_real_path));
     if (DIR_Iterate(plugin_real_path, plugins, plugin_names, node_filter, false) == 0)
     {
         LOGI("Load Extra Node %s", plugin_real_path.c_str());
-        for (auto node_path : plugins)
-        {
-            auto nodetypeid = nodeRegistry->RegisterNodeType(node_path, &m_Document->m_Blueprint);
-            if (nodetypeid == 0)
-            {
-                LOGE("Load Extra Node Failed %s", node_path.c_str());
-                continue;
-            }
-            auto nodeinfo = nodeRegistry->GetTypeInfo(nodetypeid);
-            if (!nodeinfo)
-            {
-                LOGE("Load Extra Node Failed %s", node_path.c_str());
-                continue;
-            }
-            LOGI("Load Extra Node %s(%d.%d.%d.%d)", nodeinfo->m_NodeTypeName.c_str(),
-                                                    VERSION_MAJOR(nodeinfo->m_Version), 
-                                                    VERSION_MINOR(nodeinfo->m_Version), 
-                                                    VERSION_PATCH(nodeinfo->m_Version), 
-                                                    VERSION_BUILT(nodeinfo->m_Version));
-        }
+        nodeRegistry->RegisterNodeTypes(plugins, &manifest);
     }
 
     // load dynamic pin
@@ -562,16 +584,10 @@ void BluePrintUI::Initialize(const char * bp_file, const char * plugin_path)
     if (DIR_Iterate(plugin_real_path, plugins, plugin_names, pin_filter, false) == 0)
     {
         LOGI("Load Extra PinEx %s", plugin_real_path.c_str());
-        for (auto pinex_path : plugins)
-        {
-            auto pPinexType = pinexRegistry->RegisterPinEx(pinex_path);
-            if (pPinexType == nullptr) {
-                LOGE("FAILED to load PinEx from '%s'!", pinex_path.c_str());
-                continue;
-            }
-            LOGI("Successfully loaded PinEx from '%s'!", pinex_path.c_str());
-        }
+        pinexRegistry->RegisterPinExs(plugins, &manifest);
     }
+    manifest.Save();
+    nodeRegistry->EnablePluginWatch(true);
     if (bp_file)
     {
         m_Document->Load(bp_file);
@@ -749,6 +765,13 @@ bool BluePrintUI::Frame(bool child_window, bool show_node, bool bp_enabled, uint
     if (!m_Editor || !m_Document || ReadyToQuit)
         return true;
     auto& io = ImGui::GetIO();
+    // pick up rebuilt plugins, live nodes are migrated in place. Without inotify
+    // every plugin is stat'ed, so poll less often there
+    if (ImGui::GetTime() - m_PluginCheckTime > (m_Document->m_Blueprint.GetNodeRegistry()->IsPluginWatchPolling() ? 5.0 : 1.0))
+    {
+        m_PluginCheckTime = ImGui::GetTime();
+        m_Document->m_Blueprint.GetNodeRegistry()->CheckPluginUpdates();
+    }
     bool multiviewport = io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable;
     const ImGuiViewport* viewport = ImGui::GetMainViewport();
     if (!child_window)
@@ -925,6 +948,7 @@ void BluePrintUI::InstallDocumentCallbacks()
     m_Config.SaveNodeSettingsJson = [](ed::NodeId nodeId, const imgui_json::value& value, ed::SaveReasonFlags reason, void* userPointer) -> bool
     {
         auto self = reinterpret_cast<BluePrintUI*>(userPointer);
+        if (self) self->m_ThumbnailDirty = true;
         if (self && self->m_Document)
             return self->m_Document->OnSaveNodeState(static_cast<ID_TYPE>(nodeId.Get()), value, reason);
         else
@@ -1065,6 +1089,7 @@ float BluePrintUI::DrawNodeToolBar(Node *node, Node **need_clone_node)
         if (ImGui::Button((std::string((node->m_Enabled ? ICON_NODE_ENABLE : ICON_NODE_DISABLE)) + "##" + std::to_string(node->m_ID)).c_str())) 
         {
             node->m_Enabled = !node->m_Enabled;
+            node->m_Dirty = true;
             if (node->m_Enabled) LOGI("[HandleNodeToolBar] Enable for %" PRI_node, FMT_node(node));
             else                 LOGI("[HandleNodeToolBar] Disable for %" PRI_node, FMT_node(node));
             ed::SetNodeChanged(node->m_ID);
@@ -1141,46 +1166,66 @@ bool BluePrintUI::CheckNodeStyle(const Node* node, NodeStyle style)
 
 void BluePrintUI::CommitLinksToEditor()
 {
-    auto pins = m_Document->m_Blueprint.GetPins();
+    auto& blueprint = m_Document->m_Blueprint;
+    if (m_LinkCacheRevision != blueprint.GetLinkRevision())
+        RebuildLinkCache();
+    // the editor is immediate mode, every link is submitted each frame
+    for (auto& item : m_LinkCache)
+        ed::Link(item.m_Pin->m_ID, item.m_Pin->m_ID, item.m_Pin->m_Link, PinTypeToColor(this, item.m_Pin->GetValueType()), 3.0); // Maybe add to setting
+}
+
+void BluePrintUI::RebuildLinkCache()
+{
+    auto& blueprint = m_Document->m_Blueprint;
+    auto pins = blueprint.GetPins();
+    std::unordered_set<const Pin*> pinSet(pins.begin(), pins.end());
+    m_LinkCache.clear();
+
+    // pins removed by their node, e.g. group shadow pins, also move the revision
+    std::unordered_set<ID_TYPE> pinIds;
+    for (auto pin : pins) pinIds.insert(pin->m_ID);
+    for (auto it = m_PinRects.begin(); it != m_PinRects.end();)
+    {
+        if (pinIds.find(it->first) == pinIds.end())
+            it = m_PinRects.erase(it);
+        else
+            ++it;
+    }
+
     for (auto pin : pins)
     {
+        // repairs change what the nodes save, mark them dirty so SaveIncremental sees it
         if (!pin->m_Link)
         {
-            if (!(pin->m_Flags & PIN_FLAG_LINKED)) pin->m_LinkFrom.clear();
+            if (!(pin->m_Flags & PIN_FLAG_LINKED) && !pin->m_LinkFrom.empty())
+            {
+                pin->m_LinkFrom.clear();
+                pin->m_Node->m_Dirty = true;
+            }
             continue;
         }
 
-        auto link = pin->GetLink(&m_Document->m_Blueprint);
-        if (!link)
+        auto link = pin->GetLink(&blueprint);
+        if (!link || pinSet.find(link) == pinSet.end())
         {
             pin->m_Link = 0;
             pin->m_LinkPin = nullptr;
+            pin->m_Node->m_Dirty = true;
             continue;
         }
-        else
-        {
-            pin->m_LinkPin = link;
-        }
+        pin->m_LinkPin = link;
 
-        if (std::find(pins.begin(), pins.end(), link) == pins.end())
-        {
-            pin->m_Link = 0;
-            pin->m_LinkPin = nullptr;
-            continue;
-        }
-        
         // To keep things simple, link id is same as pin id.
-        // check link is between bridge and shadow
-        //bool inner_link = pin->IsMappedPin() && link->IsMappedPin() && pin->m_MappedPin && pin->m_MappedPin == link->m_MappedPin;
-        //ed::Link(pin->m_ID, pin->m_ID, pin->m_Link, (inner_link ? ImVec4(0, 0, 0,  0) : PinTypeToColor(this, pin->GetValueType())), 1.5); // Maybe add to setting
-        ed::Link(pin->m_ID, pin->m_ID, pin->m_Link, PinTypeToColor(this, pin->GetValueType()), 3.0); // Maybe add to setting
-        pin->m_Flags |= PIN_FLAG_LINKED;
-        link->m_Flags |= PIN_FLAG_LINKED;
+        m_LinkCache.push_back({ pin });
+        pin->SetFlag(PIN_FLAG_LINKED, true);
+        link->SetFlag(PIN_FLAG_LINKED, true);
         if (std::find(link->m_LinkFrom.begin(), link->m_LinkFrom.end(), pin->m_ID) == link->m_LinkFrom.end())
         {
             link->m_LinkFrom.push_back(pin->m_ID);
+            link->m_Node->m_Dirty = true;
         }
     }
+    m_LinkCacheRevision = blueprint.GetLinkRevision();
 }
 
 void BluePrintUI::DrawNodes()
@@ -1227,6 +1272,7 @@ void BluePrintUI::DrawNodes()
         {
             ed::SetNodeChanged(node->m_ID);
             node->m_NeedUpdate = false;
+            node->m_Dirty = true;
         }
         // Comment/Group node layout:
         //
@@ -1472,6 +1518,11 @@ void BluePrintUI::DrawNodes()
     }
 
     // Handling Default and SimpleNode
+    // Nodes outside the view, and every node once zoomed out past m_LODZoom,
+    // are submitted as proxies which keep node size and pin anchors for links.
+    auto viewRect = ed::GetViewRect();
+    viewRect.Expand(64.0f);
+    const bool lowDetail = ed::GetCurrentZoom() > m_LODZoom;
     for (auto& node : m_Document->m_Blueprint.GetNodes())
     {
         auto isDummy = node->GetStyle() == NodeStyle::Dummy;
@@ -1479,6 +1530,17 @@ void BluePrintUI::DrawNodes()
         if (!CheckNodeStyle(node, NodeStyle::Default) && !CheckNodeStyle(node, NodeStyle::Simple))
             continue;
         node->m_IconHovered = -1;
+        auto nodeOrigin = ed::GetNodePosition(node->m_ID);
+        if (m_NodeCulling && !isDummy && !node->m_NeedUpdate)
+        {
+            auto nodeRect = ImRect(nodeOrigin, nodeOrigin + ed::GetNodeSize(node->m_ID));
+            auto visible = viewRect.Overlaps(nodeRect);
+            if ((!visible || lowDetail) && DrawNodeProxy(node, visible))
+            {
+                if (m_DebugOverlay) m_DebugOverlay->DrawNode(this, *node);
+                continue;
+            }
+        }
         if (isDummy)
         {
             ed::PushStyleColor(ed::StyleColor_NodeBorder,    ImColor(255, 32,  32, 200));
@@ -1496,6 +1558,7 @@ void BluePrintUI::DrawNodes()
         {
             ed::SetNodeChanged(node->m_ID);
             node->m_NeedUpdate = false;
+            node->m_Dirty = true;
         }
         // Default node layout:                         Simple node layout:
         //
@@ -1534,6 +1597,7 @@ void BluePrintUI::DrawNodes()
                 auto pos = itemMin + ImVec2(6, (itemMax.y - itemMin.y) / 2 - size.y / 2);
                 if (ImGui::BulletToggleButton("##set_break_point", &node->m_BreakPoint, pos, size))
                 {
+                    node->m_Dirty = true;
                     ed::SetNodeChanged(node->m_ID);
                 }
                 //ImGui::Debug_DrawItemRect();
@@ -1606,6 +1670,7 @@ void BluePrintUI::DrawNodes()
             }
             
             ed::EndPin();
+            m_PinRects[pin->m_ID] = ImRect(ImGui::GetItemRectMin() - nodeOrigin, ImGui::GetItemRectMax() - nodeOrigin);
             // [Debug Overlay] Show value of the pin if node is currently executed
             //if (m_DebugOverlay) m_DebugOverlay->DrawInputPin(this, *pin);
             layout.NextRow();
@@ -1631,6 +1696,7 @@ void BluePrintUI::DrawNodes()
             ImVec2 origin = ed::GetCurrentOrigin();
             if (node->DrawCustomLayout(ImGui::GetCurrentContext(), zoom, origin))
             {
+                node->m_Dirty = true;
                 ed::SetNodeChanged(node->m_ID);
                 if (m_CallBacks.BluePrintOnChanged)
                 {
@@ -1683,6 +1749,7 @@ void BluePrintUI::DrawNodes()
                 pin->m_Flags & PIN_FLAG_PUBLICIZED,
                 PinTypeToColor(this, pin->GetValueType()));
             ed::EndPin();
+            m_PinRects[pin->m_ID] = ImRect(ImGui::GetItemRectMin() - nodeOrigin, ImGui::GetItemRectMax() - nodeOrigin);
             // [Debug Overlay] Show value of the pin if node is currently executed
             //if (m_DebugOverlay) m_DebugOverlay->DrawOutputPin(this, *pin);
             layout.NextRow();
@@ -1746,6 +1813,56 @@ void BluePrintUI::DrawNodes()
     if (m_DebugOverlay) m_DebugOverlay->End();
 }
 
+bool BluePrintUI::DrawNodeProxy(Node* node, bool show_title)
+{
+    // a proxy needs a full draw first, for the node size and pin bounds
+    auto nodeSize = ed::GetNodeSize(node->m_ID);
+    if (nodeSize.x <= 0 || nodeSize.y <= 0)
+        return false;
+    auto inputPins = node->GetInputPins();
+    auto outputPins = node->GetOutputPins();
+    for (auto pin : inputPins)
+        if (m_PinRects.find(pin->m_ID) == m_PinRects.end()) return false;
+    for (auto pin : outputPins)
+        if (m_PinRects.find(pin->m_ID) == m_PinRects.end()) return false;
+
+    auto nodeStart = ed::GetNodePosition(node->m_ID);
+    auto padding = ed::GetStyle().NodePadding;
+    auto submit_pin = [&](Pin* pin, ed::PinKind kind, float pivot)
+    {
+        auto& rect = m_PinRects[pin->m_ID];
+        ed::BeginPin(pin->m_ID, kind);
+        ed::PinPivotAlignment(ImVec2(pivot, 0.5f));
+        ed::PinRect(nodeStart + rect.Min, nodeStart + rect.Max);
+        ed::EndPin();
+    };
+    if (node->m_NoBackGround)
+        ed::PushStyleColor(ed::StyleColor_NodeBg, ImVec4(0.f, 0.f, 0.f, 0.f));
+    ed::BeginNode(node->m_ID);
+    for (auto pin : inputPins) submit_pin(pin, ed::PinKind::Input, 0.0f);
+    for (auto pin : outputPins) submit_pin(pin, ed::PinKind::Output, 1.0f);
+    ImGui::SetCursorScreenPos(nodeStart + ImVec2(padding.x, padding.y));
+    ImGui::Dummy(nodeSize - ImVec2(padding.x + padding.z, padding.y + padding.w));
+    if (show_title)
+    {
+        // keep the title at its normal on-screen size whatever the zoom
+        auto nodeName = node->GetName();
+        auto drawList = ImGui::GetWindowDrawList();
+        ImFont* font = HeaderFont();
+        if (!font) font = ImGui::GetFont();
+        float fontSize = font->FontSize * ed::GetCurrentZoom();
+        auto textSize = font->CalcTextSizeA(fontSize, FLT_MAX, 0.0f, nodeName.c_str());
+        auto textPos = nodeStart + ImMax((nodeSize - textSize) * 0.5f, ImVec2(0, 0));
+        ImVec4 clipRect(nodeStart.x, nodeStart.y, nodeStart.x + nodeSize.x, nodeStart.y + nodeSize.y);
+        drawList->AddRectFilled(nodeStart, nodeStart + nodeSize, ImColor(m_StyleColors[BluePrintStyleColor_TitleBg]), ed::GetStyle().NodeRounding);
+        drawList->AddText(font, fontSize, textPos, ImGui::GetColorU32(ImGuiCol_Text), nodeName.c_str(), nullptr, 0.0f, &clipRect);
+    }
+    if (node->m_NoBackGround)
+        ed::PopStyleColor();
+    ed::EndNode();
+    return true;
+}
+
 void BluePrintUI::DrawInfoTooltip()
 {
     if (!m_Document || !ed::IsActive())
@@ -1950,7 +2067,7 @@ void BluePrintUI::DrawInfoTooltip()
     if (hoveredNode)
     {
         auto isDummy = hoveredNode->GetStyle() == NodeStyle::Dummy;
-        auto nodeTypeInfo = hoveredNode->GetTypeInfo();
+        auto& nodeTypeInfo = hoveredNode->GetTypeInfo();
         auto nodeName = !isDummy ? hoveredNode->GetName() : ((DummyNode *)hoveredNode)->m_name + "*load fail*";
         auto nodeTypeName = !isDummy ? nodeTypeInfo.m_Name : ((DummyNode *)hoveredNode)->m_type_name;
         auto nodeType = !isDummy ? hoveredNode->GetType() : ((DummyNode *)hoveredNode)->m_type;
@@ -1990,6 +2107,7 @@ void BluePrintUI::DrawInfoTooltip()
                         {
                             hoveredPin->m_Flags |= PIN_FLAG_PUBLICIZED;
                         }
+                        hoveredPin->m_Node->m_Dirty = true;
                         ed::SetPinChanged(hoveredPin->m_ID);
                         m_Document->m_IsModified = true;
                     }
@@ -2199,11 +2317,9 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
     }
     ImGui::PopStyleVar();
     ImGui::Separator();
-    auto registryNode = m_Document->m_Blueprint.GetNodeRegistry()->GetTypes();
     auto registryCatalog = m_Document->m_Blueprint.GetNodeRegistry()->GetCatalogs();
     bool need_root = true;
     int start_level = 0;
-    std::vector<const BluePrint::NodeTypeInfo*> nodes;
     if (!catalog_filter.empty())
     {
         auto catalog_filters = GetCatalogInfo(catalog_filter);
@@ -2212,84 +2328,14 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
             need_root = false;
             start_level = catalog_filters.size();
         }
-        std::vector<const NodeTypeInfo *> array;
-        for (auto nodetype : registryNode)
-        {
-            auto catalogs = GetCatalogInfo(nodetype->m_Catalog);
-            if (catalogs.size() > 0 && catalog_filters.size() > 0 && catalogs[0].compare("Dummy") != 0)
-            {
-                if (catalogs[0].compare(catalog_filters[0]) == 0)
-                {
-                    if (catalogs.size() > 1 && catalog_filters.size() > 1)
-                    {
-                        if (catalogs[1].compare(catalog_filters[1]) == 0)
-                        {
-                            if (catalogs.size() > 2 && catalog_filters.size() > 2)
-                            {
-                                if (catalogs[2].compare(catalog_filters[2]) == 0)
-                                    array.push_back(nodetype);
-                            }
-                            else
-                                array.push_back(nodetype);
-                        }
-                    }
-                    else
-                        array.push_back(nodetype);
-                }
-                else if (nodetype->m_Style == NodeStyle::Comment || nodetype->m_Style == NodeStyle::Group)
-                {
-                    array.push_back(nodetype);
-                }
-            }
-        }
-        string low_case_filter_str = filter_string.size() > 0 ? to_lower(filter_string) : "";
-        for (auto nodetype : array)
-        {
-            string low_case_node_type_name = to_lower(nodetype->m_Name);
-            if (filter_string.size() == 0 || low_case_node_type_name.find(low_case_filter_str) != string::npos)
-            {
-                nodes.push_back(nodetype);
-            }
-        }
-    }
-    else if (filter_string.size() > 0)
-    {
-        string low_case_filter_str = to_lower(filter_string);
-        for (size_t i = 0; i < registryCatalog.size(); i++)
-        {
-            auto catalog = registryCatalog[i];
-            std::vector<const NodeTypeInfo *> array;
-            for (auto nodetype : registryNode)
-            {
-                auto catalogs = GetCatalogInfo(nodetype->m_Catalog);
-                if (catalogs.size() > 0 && catalogs[0].compare("Dummy") != 0 && catalogs[0].compare(catalog) == 0)
-                    array.push_back(nodetype);
-            }
-            for (auto nodetype : array)
-            {
-                string low_case_node_type_name = to_lower(nodetype->m_Name);
-                if (low_case_node_type_name.find(low_case_filter_str) != string::npos)
-                {
-                    nodes.push_back(nodetype);
-                }
-            }
-        }
-    }
-    else
-    {
-        for (auto nodetype : registryNode)
-        {
-            if (nodetype->m_Catalog.compare("Dummy") != 0)
-                nodes.push_back(nodetype);
-        }
     }
-    std::sort(nodes.begin(), nodes.end(), [](const NodeTypeInfo * a, const NodeTypeInfo * b) {
-        return a->m_Name < b->m_Name;
-    });
+    m_NodeSearch.Update(m_Document->m_Blueprint.GetNodeRegistry().get());
+    auto& nodes = m_NodeSearch.Query(filter_string, catalog_filter);
 
     auto AddNodeMenu = [&](void* data, bool tree_view = true, bool is_system_node = false)
     {
-        const BluePrint::NodeTypeInfo* nodetype = (const BluePrint::NodeTypeInfo*)data;
+        auto entry = (const NodeSearchIndex::Entry*)data;
+        auto nodetype = entry->m_Type;
         std::string menu_label;
         if (tree_view)
         {
@@ -2304,10 +2350,7 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
         }
         else
         {
-            auto catalogs = GetCatalogInfo(nodetype->m_Catalog);
-            for (auto label : catalogs)
-                menu_label += label + " " + ICON_NODE_NEXT + " ";
-            menu_label += nodetype->m_Name;
+            menu_label = entry->m_MenuLabel;
         }
         
         if (ImGui::MenuItem(menu_label.c_str(), nullptr, false, true, nodetype->m_Type == NodeType::External ? ICON_NODE_DLL : nullptr))
@@ -2332,9 +2375,9 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
 
     if (filter_string.size() > 0)
     {
-        for (auto nodetype : nodes)
+        for (auto entry : nodes)
         {
-            AddNodeMenu((void *)nodetype, false);
+            AddNodeMenu((void *)entry, false);
         }
     }
     else
@@ -2359,9 +2402,10 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
                 }
             }
         }
-        for (auto type : nodes)
+        for (auto entry : nodes)
         {
-            auto catalog = BluePrint::GetCatalogInfo(type->m_Catalog);
+            auto type = entry->m_Type;
+            auto& catalog = entry->m_Catalogs;
             if (!catalog.size())
                 continue;
             ImGui::ImTree * root = need_root ? node_tree.FindChildren(catalog[0]) : &node_tree;
@@ -2374,13 +2418,13 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
                     if (catalog.size() > 2)
                     {
                         ImGui::ImTree sub_sub_tree(catalog[2]);
-                        ImGui::ImTree end_sub(type->m_Name, (void *)type);
+                        ImGui::ImTree end_sub(type->m_Name, (void *)entry);
                         sub_sub_tree.childrens.push_back(end_sub);
                         subtree.childrens.push_back(sub_sub_tree);
                     }
                     else
                     {
-                        ImGui::ImTree end_sub(type->m_Name, (void *)type);
+                        ImGui::ImTree end_sub(type->m_Name, (void *)entry);
                         subtree.childrens.push_back(end_sub);
                     }
 
@@ -2394,26 +2438,26 @@ Node* BluePrintUI::ShowNewNodeMenu(ImVec2 popupPosition, std::string catalog_fil
                         if (!sub_children)
                         {
                             ImGui::ImTree subtree(catalog[2]);
-                            ImGui::ImTree end_sub(type->m_Name, (void *)type);
+                            ImGui::ImTree end_sub(type->m_Name, (void *)entry);
                             subtree.childrens.push_back(end_sub);
                             children->childrens.push_back(subtree);
                         }
                         else
                         {
-                            ImGui::ImTree end_sub(type->m_Name, (void *)type);
+                            ImGui::ImTree end_sub(type->m_Name, (void *)entry);
                             sub_children->childrens.push_back(end_sub);
                         }
                     }
                     else
                     {
-                        ImGui::ImTree end_sub(type->m_Name, (void *)type);
+                        ImGui::ImTree end_sub(type->m_Name, (void *)entry);
                         children->childrens.push_back(end_sub);
                     }
                 }
             }
             else
             {
-                ImGui::ImTree end_sub(type->m_Name, (void *)type);
+                ImGui::ImTree end_sub(type->m_Name, (void *)entry);
                 root->childrens.push_back(end_sub);
             }
         }
@@ -2708,6 +2752,8 @@ void BluePrintUI::HandleDestroyAction()
     for (auto node : nodesToDelete)
     {
         LOGI("[HandleDestroyAction] %" PRI_node, FMT_node(node));
+        for (auto pin : node->GetInputPins()) m_PinRects.erase(pin->m_ID);
+        for (auto pin : node->GetOutputPins()) m_PinRects.erase(pin->m_ID);
         m_Document->m_Blueprint.DeleteNode(node);
     }
 
@@ -2902,6 +2948,7 @@ bool BluePrintUI::File_Open(std::string path, string* error)
         ed::ClearSelection();
         m_Document->m_Blueprint.Clear();
     }
+    m_PinRects.clear();
     if (m_Document->Load(path) != BP_ERR_NONE)
     {
         if (error)
@@ -2972,6 +3019,7 @@ bool BluePrintUI::File_New()
     ed::SetCurrentEditor(m_Editor);
     ed::ClearSelection();
     m_Document->m_Blueprint.Clear();
+    m_PinRects.clear();
     CleanStateStorage();
     ed::NavigateToOrigin();
     CreateNewDocument();
@@ -2985,6 +3033,7 @@ bool BluePrintUI::File_New_Filter(imgui_json::value& bp, std::string name, std::
     ed::SetCurrentEditor(m_Editor);
     ed::ClearSelection();
     m_Document->m_Blueprint.Clear();
+    m_PinRects.clear();
     CleanStateStorage();
     if (bp.is_object())
     {
@@ -3024,6 +3073,7 @@ bool BluePrintUI::File_New_Fusion(imgui_json::value& bp, std::string name, std::
     ed::SetCurrentEditor(m_Editor);
     ed::ClearSelection();
     m_Document->m_Blueprint.Clear();
+    m_PinRects.clear();
     CleanStateStorage();
     if (bp.is_object())
     {
@@ -3121,6 +3171,7 @@ bool BluePrintUI::Edit_Undo()
     if (m_Document)
     {
         ret = m_Document->Undo();
+        m_PinRects.clear();
         if (m_DebugOverlay) m_DebugOverlay->Init(&m_Document->m_Blueprint);
     }
     return ret;
@@ -3128,7 +3179,10 @@ bool BluePrintUI::Edit_Undo()
 
 bool BluePrintUI::Edit_Redo()
 {
-    return m_Document ? m_Document->Redo() : false;
+    if (!m_Document || !m_Document->Redo())
+        return false;
+    m_PinRects.clear();
+    return true;
 }
 
 bool BluePrintUI::Edit_Cut()
@@ -3483,8 +3537,8 @@ void BluePrintUI::UpdateActions()
 {
     //auto mostRecentlyOpenFiles = ImGui::MostRecentlyUsedList("BluePrintOpenList");
     auto hasDocument = File_IsOpen();
-    auto hasUndo     = hasDocument && !m_Document->m_Undo.empty();
-    auto hasRedo     = hasDocument && !m_Document->m_Redo.empty();
+    auto hasUndo     = hasDocument && !m_Document->m_Undo.IsEmpty();
+    auto hasRedo     = hasDocument && !m_Document->m_Redo.IsEmpty();
     auto isModified  = hasDocument && File_IsModified();
     auto entryNode = FindEntryPointNode();
     auto exitNode = FindExitPointNode();
@@ -3827,6 +3881,27 @@ void BluePrintUI::ShowToolbar(bool* show)
     }
 }
 
+void BluePrintUI::UpdateThumbnailCache()
+{
+    // node bounds are kept in canvas space, so panning and zooming reuse them as is
+    auto& blueprint = m_Document->m_Blueprint;
+    auto nodes = blueprint.GetNodes();
+    bool dragging = ImGui::IsMouseDown(0) && ed::GetSelectedObjectCount() > 0;
+    if (!m_ThumbnailDirty && !dragging &&
+        m_ThumbnailRevision == blueprint.GetLinkRevision() &&
+        m_ThumbnailRects.size() == nodes.size())
+        return;
+    m_ThumbnailRects.clear();
+    m_ThumbnailRects.reserve(nodes.size());
+    for (auto& node : nodes)
+    {
+        auto node_pos = ed::GetNodePosition(node->m_ID);
+        m_ThumbnailRects.emplace_back(node_pos, node_pos + ed::GetNodeSize(node->m_ID));
+    }
+    m_ThumbnailRevision = blueprint.GetLinkRevision();
+    m_ThumbnailDirty = false;
+}
+
 void BluePrintUI::Thumbnails(float view_expand, ImVec2 size, ImVec2 pos)
 {
     auto& io = ImGui::GetIO();
@@ -3865,15 +3940,19 @@ void BluePrintUI::Thumbnails(float view_expand, ImVec2 size, ImVec2 pos)
         auto cursorPos = ImGui::GetCursorScreenPos();
         auto window = ImGui::GetCurrentWindow();
         auto drawList  = ImGui::GetWindowDrawList();
-        auto view_area_pos = (view_rect.Min - screen_rect.Min) * m_ThumbnailScale * view_scale / zoom;
-        auto view_area_size = view_size * m_ThumbnailScale * view_scale / zoom;
-        drawList->AddRect(cursorPos + view_area_pos, cursorPos + view_area_pos + view_area_size, ImGui::GetColorU32(ImGuiCol_Border, window_alpha));
-        for (auto& node : m_Document->m_Blueprint.GetNodes())
-        {
-            auto node_pos = (ed::GetNodePosition(node->m_ID) - screen_rect.Min) * m_ThumbnailScale * view_scale / zoom;
-            auto node_size = ed::GetNodeSize(node->m_ID) * m_ThumbnailScale * view_scale / zoom;
-            drawList->AddRectFilled(cursorPos + node_pos, cursorPos + node_pos + node_size, ImGui::GetColorU32(ImGuiCol_Border, window_alpha));
+        auto thumbnail_scale = m_ThumbnailScale * view_scale / zoom;
+        auto view_area_pos = (view_rect.Min - screen_rect.Min) * thumbnail_scale;
+        auto view_area_size = view_size * thumbnail_scale;
+        UpdateThumbnailCache();
+        auto node_color = ImGui::GetColorU32(ImGuiCol_Border, window_alpha);
+        auto origin = cursorPos - screen_rect.Min * thumbnail_scale;
+        for (auto& rect : m_ThumbnailRects)
+        {
+            if (!rect.Overlaps(screen_rect))
+                continue;
+            drawList->AddRectFilled(origin + rect.Min * thumbnail_scale, origin + rect.Max * thumbnail_scale, node_color);
         }
+        drawList->AddRect(cursorPos + view_area_pos, cursorPos + view_area_pos + view_area_size, ImGui::GetColorU32(ImGuiCol_Border, window_alpha));
     }
     ImGui::End();
     m_ThumbnailShowCount --;
@@ -16,39 +16,6 @@ ImFont* HeaderFont()
     return font;
 }
 
-const char* StepResultToString(StepResult stepResult)
-{
-    switch (stepResult)
-    {
-        case StepResult::Success:   return "Success";
-        case StepResult::Done:      return "Done";
-        case StepResult::Error:     return "Error";
-    }
-
-    return "";
-}
-
-std::string IDToHexString(const ID_TYPE i) 
-{
-    std::stringstream s;
-    s << "0x" << std::uppercase << std::hex << i;
-    return s.str();
-}
-
-ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID)
-{
-    if (MapID.size() > 0)
-    {
-        std::map<ID_TYPE, ID_TYPE>::iterator it;
-        it = MapID.find(ID);
-        if (it == MapID.end())
-            return 0;
-        else
-            return it->second;
-    }
-    return ID;
-}
-
 IconType PinTypeToIconType(PinType pinType)
 {
     switch (pinType)
@@ -345,27 +312,6 @@ void PinValueBackgroundRenderer::Discard()
         m_Splitter.Merge(m_DrawList);
 }
 
-const vector<Node*> GetGroupedNodes(Node& node)
-{
-    vector<Node*> result;
-    vector<ed::NodeId> nodes;
-    ed::GetGroupedNodes(nodes, node.m_ID, ImVec2(40, 40));
-    for (auto nodeId : nodes)
-    {
-        IM_ASSERT(node.m_Blueprint != nullptr);
-        auto _node = node.m_Blueprint->FindNode(static_cast<ID_TYPE>(nodeId.Get()));
-        //IM_ASSERT(_node != nullptr);
-        if (_node && _node->GetStyle() != NodeStyle::Group)
-        {
-            if (_node->m_GroupID == 0)
-                result.push_back(_node);
-            else if (_node->m_GroupID == node.m_ID)
-                result.push_back(_node);
-        }
-    }
-    return result;
-}
-
 const vector<Node*> GetSelectedNodes(BP* blueprint)
 {
     if (!blueprint) return {};
@@ -0,0 +1,376 @@
+#include <YUVConvert.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string.h>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#define YUV_BAND_ROWS       64      // fewest rows handed to one worker
+
+namespace BluePrint
+{
+// Q16 fixed point coefficients applied to samples normalized to 8 bits
+struct YUVCoeffs
+{
+    int32_t m_YOffset;
+    int32_t m_Y;
+    int32_t m_RV;
+    int32_t m_GU;
+    int32_t m_GV;
+    int32_t m_BU;
+};
+
+static YUVCoeffs MakeCoeffs(YUVMatrix matrix, bool full_range)
+{
+    double kr = 0.2126, kb = 0.0722;
+    if (matrix == YUVMatrix::BT601) { kr = 0.299; kb = 0.114; }
+    else if (matrix == YUVMatrix::BT2020) { kr = 0.2627; kb = 0.0593; }
+    double kg = 1.0 - kr - kb;
+    double y_scale = full_range ? 1.0 : 255.0 / 219.0;
+    double c_scale = full_range ? 1.0 : 255.0 / 224.0;
+    auto q16 = [](double v) { return (int32_t)(v * 65536.0 + 0.5); };
+    YUVCoeffs coeffs;
+    coeffs.m_YOffset = full_range ? 0 : 16;
+    coeffs.m_Y  = q16(y_scale);
+    coeffs.m_RV = q16(2.0 * (1.0 - kr) * c_scale);
+    coeffs.m_GU = q16(2.0 * kb * (1.0 - kb) / kg * c_scale);
+    coeffs.m_GV = q16(2.0 * kr * (1.0 - kr) / kg * c_scale);
+    coeffs.m_BU = q16(2.0 * (1.0 - kb) * c_scale);
+    return coeffs;
+}
+
+static inline uint8_t Clamp8(int32_t v)
+{
+    return (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+static inline void ConvertPixel(const YUVCoeffs& k, int32_t y, int32_t u, int32_t v, uint8_t* rgba)
+{
+    y = (y - k.m_YOffset) * k.m_Y + (1 << 15);
+    u -= 128;
+    v -= 128;
+    rgba[0] = Clamp8((y + v * k.m_RV) >> 16);
+    rgba[1] = Clamp8((y - u * k.m_GU - v * k.m_GV) >> 16);
+    rgba[2] = Clamp8((y + u * k.m_BU) >> 16);
+    rgba[3] = 255;
+}
+
+// full width 8 bit Y/U/V rows to RGBA, returns how many pixels were done with SIMD
+static int ConvertRowSIMD(const YUVCoeffs& k, const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width)
+{
+    int x = 0;
+#if defined(__AVX2__)
+    const __m256i yoff = _mm256_set1_epi32(k.m_YOffset);
+    const __m256i ky = _mm256_set1_epi32(k.m_Y);
+    const __m256i rv = _mm256_set1_epi32(k.m_RV);
+    const __m256i gu = _mm256_set1_epi32(k.m_GU);
+    const __m256i gv = _mm256_set1_epi32(k.m_GV);
+    const __m256i bu = _mm256_set1_epi32(k.m_BU);
+    const __m256i center = _mm256_set1_epi32(128);
+    const __m256i round = _mm256_set1_epi32(1 << 15);
+    const __m256i alpha = _mm256_set1_epi32(255);
+    // [r0..3 g0..3 b0..3 a0..3] -> [r0 g0 b0 a0 r1 ...] in each 128 bit lane
+    const __m256i interleave = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                                0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    for (; x + 8 <= width; x += 8)
+    {
+        __m256i yy = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(y + x)));
+        __m256i uu = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(u + x))), center);
+        __m256i vv = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(v + x))), center);
+        yy = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(yy, yoff), ky), round);
+        __m256i r = _mm256_srai_epi32(_mm256_add_epi32(yy, _mm256_mullo_epi32(vv, rv)), 16);
+        __m256i g = _mm256_srai_epi32(_mm256_sub_epi32(_mm256_sub_epi32(yy, _mm256_mullo_epi32(uu, gu)), _mm256_mullo_epi32(vv, gv)), 16);
+        __m256i b = _mm256_srai_epi32(_mm256_add_epi32(yy, _mm256_mullo_epi32(uu, bu)), 16);
+        __m256i rgba = _mm256_packus_epi16(_mm256_packs_epi32(r, g), _mm256_packs_epi32(b, alpha));
+        _mm256_storeu_si256((__m256i*)(dst + x * 4), _mm256_shuffle_epi8(rgba, interleave));
+    }
+#elif defined(__SSE4_1__)
+    const __m128i yoff = _mm_set1_epi32(k.m_YOffset);
+    const __m128i ky = _mm_set1_epi32(k.m_Y);
+    const __m128i rv = _mm_set1_epi32(k.m_RV);
+    const __m128i gu = _mm_set1_epi32(k.m_GU);
+    const __m128i gv = _mm_set1_epi32(k.m_GV);
+    const __m128i bu = _mm_set1_epi32(k.m_BU);
+    const __m128i center = _mm_set1_epi32(128);
+    const __m128i round = _mm_set1_epi32(1 << 15);
+    const __m128i alpha = _mm_set1_epi32(255);
+    const __m128i interleave = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    for (; x + 4 <= width; x += 4)
+    {
+        int32_t y4, u4, v4;
+        memcpy(&y4, y + x, 4);
+        memcpy(&u4, u + x, 4);
+        memcpy(&v4, v + x, 4);
+        __m128i yy = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(y4));
+        __m128i uu = _mm_sub_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(u4)), center);
+        __m128i vv = _mm_sub_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(v4)), center);
+        yy = _mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(yy, yoff), ky), round);
+        __m128i r = _mm_srai_epi32(_mm_add_epi32(yy, _mm_mullo_epi32(vv, rv)), 16);
+        __m128i g = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(yy, _mm_mullo_epi32(uu, gu)), _mm_mullo_epi32(vv, gv)), 16);
+        __m128i b = _mm_srai_epi32(_mm_add_epi32(yy, _mm_mullo_epi32(uu, bu)), 16);
+        __m128i rgba = _mm_packus_epi16(_mm_packs_epi32(r, g), _mm_packs_epi32(b, alpha));
+        _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_shuffle_epi8(rgba, interleave));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const int32x4_t yoff = vdupq_n_s32(k.m_YOffset);
+    const int32x4_t round = vdupq_n_s32(1 << 15);
+    const int32x4_t center = vdupq_n_s32(128);
+    for (; x + 8 <= width; x += 8)
+    {
+        int16x8_t y16 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + x)));
+        int16x8_t u16 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + x)));
+        int16x8_t v16 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + x)));
+        int16x4_t r4[2], g4[2], b4[2];
+        for (int h = 0; h < 2; h++)
+        {
+            int32x4_t yy = vmovl_s16(h ? vget_high_s16(y16) : vget_low_s16(y16));
+            int32x4_t uu = vsubq_s32(vmovl_s16(h ? vget_high_s16(u16) : vget_low_s16(u16)), center);
+            int32x4_t vv = vsubq_s32(vmovl_s16(h ? vget_high_s16(v16) : vget_low_s16(v16)), center);
+            yy = vaddq_s32(vmulq_n_s32(vsubq_s32(yy, yoff), k.m_Y), round);
+            r4[h] = vqmovn_s32(vshrq_n_s32(vmlaq_n_s32(yy, vv, k.m_RV), 16));
+            g4[h] = vqmovn_s32(vshrq_n_s32(vmlsq_n_s32(vmlsq_n_s32(yy, uu, k.m_GU), vv, k.m_GV), 16));
+            b4[h] = vqmovn_s32(vshrq_n_s32(vmlaq_n_s32(yy, uu, k.m_BU), 16));
+        }
+        uint8x8x4_t rgba;
+        rgba.val[0] = vqmovun_s16(vcombine_s16(r4[0], r4[1]));
+        rgba.val[1] = vqmovun_s16(vcombine_s16(g4[0], g4[1]));
+        rgba.val[2] = vqmovun_s16(vcombine_s16(b4[0], b4[1]));
+        rgba.val[3] = vdup_n_u8(255);
+        vst4_u8(dst + x * 4, rgba);
+    }
+#else
+    (void)k; (void)y; (void)u; (void)v; (void)dst; (void)width;
+#endif
+    return x;
+}
+
+static void ConvertRow(const YUVCoeffs& k, const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst, int width)
+{
+    for (int x = ConvertRowSIMD(k, y, u, v, dst, width); x < width; x++)
+        ConvertPixel(k, y[x], u[x], v[x], dst + x * 4);
+}
+
+// 16 bit samples down to 8 bits, step is in samples (2 for interleaved UV)
+static void UnpackDeep(const uint8_t* src, int step, int shift, uint8_t* dst, int count)
+{
+    const uint16_t* s = (const uint16_t*)src;
+    const int round = shift > 0 ? 1 << (shift - 1) : 0;
+    for (int i = 0; i < count; i++)
+        dst[i] = (uint8_t)std::min((s[i * step] + round) >> shift, 255);
+}
+
+// chroma samples to full width, repeating each one when chroma is halved
+static void Upsample(const uint8_t* src, int step, bool halved, uint8_t* dst, int width)
+{
+    if (!halved)
+    {
+        for (int x = 0; x < width; x++)
+            dst[x] = src[x * step];
+        return;
+    }
+    int x = 0;
+    for (; x + 1 < width; x += 2)
+        dst[x] = dst[x + 1] = src[(x >> 1) * step];
+    if (x < width)
+        dst[x] = src[(x >> 1) * step];
+}
+
+static void ConvertRows(const YUVFrame& src, const YUVCoeffs& k, uint8_t* dst, int dst_stride, int row_start, int row_end)
+{
+    const int width = src.m_Width;
+    const bool deep = src.m_Depth > 8;
+    const int shift = src.m_Shift + src.m_Depth - 8;
+    const bool nv12 = src.m_Layout == YUVLayout::NV12;
+    const bool half_w = src.m_Layout != YUVLayout::I444;
+    const bool half_h = src.m_Layout == YUVLayout::I420 || nv12;
+    const int chroma_width = half_w ? (width + 1) >> 1 : width;
+    std::vector<uint8_t> buffer(width * 3 + chroma_width * 2);
+    uint8_t* y_row = buffer.data();
+    uint8_t* u_row = y_row + width;
+    uint8_t* v_row = u_row + width;
+    uint8_t* u_tmp = v_row + width;
+    uint8_t* v_tmp = u_tmp + chroma_width;
+
+    for (int row = row_start; row < row_end; row++)
+    {
+        int crow = half_h ? row >> 1 : row;
+        const uint8_t* y_src = src.m_Data[0] + (size_t)row * src.m_Stride[0];
+        const uint8_t* u_src = src.m_Data[1] + (size_t)crow * src.m_Stride[1];
+        const uint8_t* v_src = nv12 ? u_src + (deep ? 2 : 1) : src.m_Data[2] + (size_t)crow * src.m_Stride[2];
+        const int step = nv12 ? 2 : 1;
+
+        const uint8_t* y = y_src;
+        const uint8_t* u = u_row;
+        const uint8_t* v = v_row;
+        if (deep)
+        {
+            UnpackDeep(y_src, 1, shift, y_row, width);
+            UnpackDeep(u_src, step, shift, u_tmp, chroma_width);
+            UnpackDeep(v_src, step, shift, v_tmp, chroma_width);
+            y = y_row;
+            Upsample(u_tmp, 1, half_w, u_row, width);
+            Upsample(v_tmp, 1, half_w, v_row, width);
+        }
+        else if (!half_w && !nv12)
+        {
+            u = u_src;
+            v = v_src;
+        }
+        else
+        {
+            Upsample(u_src, step, half_w, u_row, width);
+            Upsample(v_src, step, half_w, v_row, width);
+        }
+        ConvertRow(k, y, u, v, dst + (size_t)row * dst_stride, width);
+    }
+}
+
+// Workers live for the whole process, a conversion per video frame can't
+// afford to spawn and join threads. The calling thread takes bands too.
+class YUVWorkerPool
+{
+public:
+    static YUVWorkerPool& Get()
+    {
+        static YUVWorkerPool pool;
+        return pool;
+    }
+
+    int Size() const { return (int)m_Workers.size() + 1; }
+
+    // runs job(0) .. job(count - 1) and returns once all of them are done
+    void Run(int count, const std::function<void(int)>& job)
+    {
+        Batch batch;
+        batch.m_Job = &job;
+        batch.m_Count = count;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Batches.push_back(&batch);
+        }
+        m_Wake.notify_all();
+
+        int done = 0;
+        for (int index = batch.m_Next++; index < count; index = batch.m_Next++, done++)
+            job(index);
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        batch.m_Done += done;
+        m_Finished.wait(lock, [&] { return batch.m_Done == count; });
+        auto it = std::find(m_Batches.begin(), m_Batches.end(), &batch);
+        if (it != m_Batches.end())
+            m_Batches.erase(it);
+    }
+
+private:
+    struct Batch
+    {
+        const std::function<void(int)>* m_Job {nullptr};
+        int                             m_Count {0};
+        std::atomic<int>                m_Next {0};
+        int                             m_Done {0};     // guarded by m_Mutex
+    };
+
+    YUVWorkerPool()
+    {
+        int count = (int)std::thread::hardware_concurrency() - 1;
+        for (int i = 0; i < count; i++)
+            m_Workers.emplace_back(&YUVWorkerPool::WorkerThread, this);
+    }
+
+    ~YUVWorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Quit = true;
+        }
+        m_Wake.notify_all();
+        for (auto& worker : m_Workers)
+            worker.join();
+    }
+
+    void WorkerThread()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true)
+        {
+            m_Wake.wait(lock, [&] { return m_Quit || !m_Batches.empty(); });
+            if (m_Quit)
+                return;
+            auto batch = m_Batches.front();
+            int index = batch->m_Next++;
+            if (index >= batch->m_Count)
+            {
+                // every band is taken, the caller removes the batch once they finish
+                m_Batches.pop_front();
+                continue;
+            }
+            lock.unlock();
+            (*batch->m_Job)(index);
+            lock.lock();
+            if (++batch->m_Done == batch->m_Count)
+                m_Finished.notify_all();
+        }
+    }
+
+    std::vector<std::thread>    m_Workers;
+    std::deque<Batch*>          m_Batches;
+    std::mutex                  m_Mutex;
+    std::condition_variable     m_Wake;
+    std::condition_variable     m_Finished;
+    bool                        m_Quit {false};
+};
+
+void ConvertYUVToRGBA(const YUVFrame& src, uint8_t* dst, int dst_stride, int threads)
+{
+    if (!dst || src.m_Width <= 0 || src.m_Height <= 0 || !src.m_Data[0] || !src.m_Data[1])
+        return;
+    if (src.m_Layout != YUVLayout::NV12 && !src.m_Data[2])
+        return;
+
+    auto coeffs = MakeCoeffs(src.m_Matrix, src.m_FullRange);
+    int max_threads = std::max(1, (src.m_Height + YUV_BAND_ROWS - 1) / YUV_BAND_ROWS);
+#if defined(__EMSCRIPTEN__)
+    threads = 1;
+#else
+    if (threads != 1)
+        threads = std::min(threads <= 0 ? YUVWorkerPool::Get().Size() : threads, max_threads);
+#endif
+    if (threads == 1)
+    {
+        ConvertRows(src, coeffs, dst, dst_stride, 0, src.m_Height);
+        return;
+    }
+
+    // bands start on even rows so halved chroma rows aren't split
+    int band = ((src.m_Height + threads - 1) / threads + 1) & ~1;
+    int bands = (src.m_Height + band - 1) / band;
+    YUVWorkerPool::Get().Run(bands, [&](int index)
+    {
+        int row = index * band;
+        ConvertRows(src, coeffs, dst, dst_stride, row, std::min(row + band, src.m_Height));
+    });
+}
+
+const char* YUVConvertBackend()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE4_1__)
+    return "SSE4.1";
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return "NEON";
+#else
+    return "C";
+#endif
+}
+} // namespace BluePrint
@@ -0,0 +1,91 @@
+#include <BluePrint.h>
+#include <BluePrintBinary.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Compare blueprint load time between the json and the binary container.
+// usage: bench_blueprint_binary <blueprint.json> [iterations]
+
+using namespace BluePrint;
+
+static double now_ms()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static long file_size(const std::string& path)
+{
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) return -1;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+static const imgui_json::value& blueprint_value(const imgui_json::value& value)
+{
+    if (value.contains("document") && value["document"].contains("blueprint"))
+        return value["document"]["blueprint"];
+    return value;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <blueprint.json> [iterations]\n", argv[0]);
+        return 1;
+    }
+    std::string json_path = argv[1];
+    std::string binary_path = json_path + BP_BINARY_EXTENSION;
+    int iterations = argc > 2 ? atoi(argv[2]) : 20;
+    if (iterations <= 0) iterations = 1;
+
+    if (ConvertJsonToBinary(json_path, binary_path) != BP_ERR_NONE)
+    {
+        fprintf(stderr, "convert %s failed\n", json_path.c_str());
+        return 1;
+    }
+
+    // lossless round trip check
+    auto original = imgui_json::value::load(json_path);
+    imgui_json::value restored;
+    if (!original.second || LoadBinaryBlueprint(binary_path, restored) != BP_ERR_NONE)
+    {
+        fprintf(stderr, "reload failed\n");
+        return 1;
+    }
+    bool lossless = original.first.dump() == restored.dump();
+
+    double json_parse = 0, json_load = 0, binary_open = 0, binary_load = 0;
+    BP bp;
+    for (int i = 0; i < iterations; i++)
+    {
+        double t0 = now_ms();
+        auto value = imgui_json::value::load(json_path);
+        double t1 = now_ms();
+        bp.Load(blueprint_value(value.first));
+        double t2 = now_ms();
+        json_parse += t1 - t0;
+        json_load += t2 - t0;
+
+        t0 = now_ms();
+        BinaryBlueprint file;
+        file.Open(binary_path);
+        t1 = now_ms();
+        bp.Load(file);
+        t2 = now_ms();
+        binary_open += t1 - t0;
+        binary_load += t2 - t0;
+    }
+
+    printf("nodes       : %zu\n", bp.GetNodes().size());
+    printf("round trip  : %s\n", lossless ? "lossless" : "MISMATCH");
+    printf("file size   : json %ld bytes, binary %ld bytes\n", file_size(json_path), file_size(binary_path));
+    printf("json        : parse %8.3f ms, parse+load %8.3f ms\n", json_parse / iterations, json_load / iterations);
+    printf("binary      : open  %8.3f ms, open+load  %8.3f ms\n", binary_open / iterations, binary_load / iterations);
+    return lossless ? 0 : 1;
+}
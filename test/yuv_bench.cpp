@@ -0,0 +1,129 @@
+#include <YUVConvert.h>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef SDK_WITH_FFMPEG
+extern "C" {
+#include <libswscale/swscale.h>
+#include <libavutil/pixfmt.h>
+}
+#endif
+
+// Throughput of the SDK YUV to RGBA converter against sws_scale.
+// usage: bench_yuv_convert [width] [height] [iterations]
+
+using namespace BluePrint;
+
+static double now_ms()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct BenchFormat
+{
+    const char* m_Name;
+    YUVLayout   m_Layout;
+    int         m_Depth;
+    int         m_Shift;
+#ifdef SDK_WITH_FFMPEG
+    AVPixelFormat m_Format;
+#endif
+};
+
+#ifdef SDK_WITH_FFMPEG
+#define BENCH_FORMAT(name, layout, depth, shift, format) { name, layout, depth, shift, format }
+#else
+#define BENCH_FORMAT(name, layout, depth, shift, format) { name, layout, depth, shift }
+#endif
+
+static const BenchFormat s_Formats[] =
+{
+    BENCH_FORMAT("yuv420p",     YUVLayout::I420, 8,  0, AV_PIX_FMT_YUV420P),
+    BENCH_FORMAT("yuv420p10",   YUVLayout::I420, 10, 0, AV_PIX_FMT_YUV420P10LE),
+    BENCH_FORMAT("yuv420p16",   YUVLayout::I420, 16, 0, AV_PIX_FMT_YUV420P16LE),
+    BENCH_FORMAT("yuv422p",     YUVLayout::I422, 8,  0, AV_PIX_FMT_YUV422P),
+    BENCH_FORMAT("yuv422p10",   YUVLayout::I422, 10, 0, AV_PIX_FMT_YUV422P10LE),
+    BENCH_FORMAT("yuv444p",     YUVLayout::I444, 8,  0, AV_PIX_FMT_YUV444P),
+    BENCH_FORMAT("yuv444p10",   YUVLayout::I444, 10, 0, AV_PIX_FMT_YUV444P10LE),
+    BENCH_FORMAT("nv12",        YUVLayout::NV12, 8,  0, AV_PIX_FMT_NV12),
+    BENCH_FORMAT("p010",        YUVLayout::NV12, 10, 6, AV_PIX_FMT_P010LE),
+};
+
+int main(int argc, char** argv)
+{
+    int width = argc > 1 ? atoi(argv[1]) : 3840;
+    int height = argc > 2 ? atoi(argv[2]) : 2160;
+    int iterations = argc > 3 ? atoi(argv[3]) : 20;
+    if (width <= 0 || height <= 0) { fprintf(stderr, "usage: %s [width] [height] [iterations]\n", argv[0]); return 1; }
+    if (iterations <= 0) iterations = 1;
+
+    printf("backend %s, %d x %d, %d iterations, MPixel/s\n", YUVConvertBackend(), width, height, iterations);
+    printf("%-12s %10s %10s %10s\n", "format", "sdk x1", "sdk xN", "sws");
+    std::vector<uint8_t> rgba((size_t)width * height * 4);
+    double mpixel = (double)width * height * iterations / 1e6;
+    for (auto& format : s_Formats)
+    {
+        int bps = format.m_Depth > 8 ? 2 : 1;
+        bool half_w = format.m_Layout != YUVLayout::I444;
+        bool half_h = format.m_Layout == YUVLayout::I420 || format.m_Layout == YUVLayout::NV12;
+        int chroma_w = half_w ? (width + 1) / 2 : width;
+        int chroma_h = half_h ? (height + 1) / 2 : height;
+        bool nv12 = format.m_Layout == YUVLayout::NV12;
+
+        std::vector<uint8_t> planes[3];
+        planes[0].resize((size_t)width * height * bps);
+        planes[1].resize((size_t)chroma_w * chroma_h * bps * (nv12 ? 2 : 1));
+        planes[2].resize(nv12 ? 0 : (size_t)chroma_w * chroma_h * bps);
+        for (auto& plane : planes)
+        {
+            if (bps == 1)
+                for (auto& sample : plane) sample = (uint8_t)rand();
+            else
+                for (size_t i = 0; i < plane.size() / 2; i++) ((uint16_t*)plane.data())[i] = (uint16_t)((rand() % (1 << format.m_Depth)) << format.m_Shift);
+        }
+
+        YUVFrame frame;
+        frame.m_Width = width;
+        frame.m_Height = height;
+        frame.m_Layout = format.m_Layout;
+        frame.m_Depth = format.m_Depth;
+        frame.m_Shift = format.m_Shift;
+        frame.m_Matrix = YUVMatrix::BT709;
+        for (int i = 0; i < 3; i++) frame.m_Data[i] = planes[i].empty() ? nullptr : planes[i].data();
+        frame.m_Stride[0] = width * bps;
+        frame.m_Stride[1] = chroma_w * bps * (nv12 ? 2 : 1);
+        frame.m_Stride[2] = nv12 ? 0 : chroma_w * bps;
+
+        double t0 = now_ms();
+        for (int i = 0; i < iterations; i++)
+            ConvertYUVToRGBA(frame, rgba.data(), width * 4, 1);
+        double single = now_ms() - t0;
+        t0 = now_ms();
+        for (int i = 0; i < iterations; i++)
+            ConvertYUVToRGBA(frame, rgba.data(), width * 4);
+        double multi = now_ms() - t0;
+
+        double sws = 0;
+#ifdef SDK_WITH_FFMPEG
+        auto ctx = sws_getContext(width, height, format.m_Format, width, height, AV_PIX_FMT_RGBA, SWS_BICUBIC, nullptr, nullptr, nullptr);
+        if (ctx)
+        {
+            const uint8_t* src[4] = { frame.m_Data[0], frame.m_Data[1], frame.m_Data[2], nullptr };
+            int src_stride[4] = { frame.m_Stride[0], frame.m_Stride[1], frame.m_Stride[2], 0 };
+            uint8_t* dst[4] = { rgba.data(), nullptr, nullptr, nullptr };
+            int dst_stride[4] = { width * 4, 0, 0, 0 };
+            t0 = now_ms();
+            for (int i = 0; i < iterations; i++)
+                sws_scale(ctx, src, src_stride, 0, height, dst, dst_stride);
+            sws = now_ms() - t0;
+            sws_freeContext(ctx);
+        }
+#endif
+        auto rate = [&](double ms) { return ms > 0 ? mpixel / (ms / 1000.0) : 0.0; };
+        printf("%-12s %10.1f %10.1f %10.1f\n", format.m_Name, rate(single), rate(multi), rate(sws));
+    }
+    return 0;
+}
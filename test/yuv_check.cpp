@@ -0,0 +1,153 @@
+#include <YUVConvert.h>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+extern "C" {
+#include <libswscale/swscale.h>
+#include <libavutil/pixfmt.h>
+}
+
+// Checks the SDK YUV to RGBA converter against sws_scale within a tolerance.
+// The converter repeats chroma samples and reduces deep samples to 8 bits
+// before the matrix, so sws runs in point mode on a slowly varying image
+// where those shortcuts stay within a few code values.
+// usage: check_yuv_convert [width] [height]
+
+using namespace BluePrint;
+
+#define CHECK_MAX_DIFF      6       // largest per channel difference allowed
+#define CHECK_MEAN_DIFF     1.0     // average per channel difference allowed
+
+struct CheckFormat
+{
+    const char*     m_Name;
+    YUVLayout       m_Layout;
+    int             m_Depth;
+    int             m_Shift;
+    AVPixelFormat   m_Format;
+};
+
+static const CheckFormat s_Formats[] =
+{
+    { "yuv420p",    YUVLayout::I420, 8,  0, AV_PIX_FMT_YUV420P },
+    { "yuv420p10",  YUVLayout::I420, 10, 0, AV_PIX_FMT_YUV420P10LE },
+    { "yuv422p",    YUVLayout::I422, 8,  0, AV_PIX_FMT_YUV422P },
+    { "yuv422p10",  YUVLayout::I422, 10, 0, AV_PIX_FMT_YUV422P10LE },
+    { "yuv444p",    YUVLayout::I444, 8,  0, AV_PIX_FMT_YUV444P },
+    { "yuv444p10",  YUVLayout::I444, 10, 0, AV_PIX_FMT_YUV444P10LE },
+    { "nv12",       YUVLayout::NV12, 8,  0, AV_PIX_FMT_NV12 },
+    { "p010",       YUVLayout::NV12, 10, 6, AV_PIX_FMT_P010LE },
+};
+
+// limited range sample at the format depth, v in [0, 1]
+static int Sample(double v, int lo, int hi, int depth)
+{
+    double s = (lo + v * (hi - lo)) * (1 << (depth - 8));
+    return (int)(s + 0.5);
+}
+
+static void Store(std::vector<uint8_t>& plane, size_t index, int value, const CheckFormat& format)
+{
+    if (format.m_Depth > 8)
+        ((uint16_t*)plane.data())[index] = (uint16_t)(value << format.m_Shift);
+    else
+        plane[index] = (uint8_t)value;
+}
+
+static bool CheckFormatAt(const CheckFormat& format, int width, int height)
+{
+    int bps = format.m_Depth > 8 ? 2 : 1;
+    bool nv12 = format.m_Layout == YUVLayout::NV12;
+    bool half_w = format.m_Layout != YUVLayout::I444;
+    bool half_h = format.m_Layout == YUVLayout::I420 || nv12;
+    int chroma_w = half_w ? (width + 1) / 2 : width;
+    int chroma_h = half_h ? (height + 1) / 2 : height;
+
+    std::vector<uint8_t> planes[3];
+    planes[0].resize((size_t)width * height * bps);
+    planes[1].resize((size_t)chroma_w * chroma_h * bps * (nv12 ? 2 : 1));
+    planes[2].resize(nv12 ? 0 : (size_t)chroma_w * chroma_h * bps);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            Store(planes[0], (size_t)y * width + x, Sample((double)(x + y) / (width + height), 16, 235, format.m_Depth), format);
+    for (int y = 0; y < chroma_h; y++)
+    {
+        for (int x = 0; x < chroma_w; x++)
+        {
+            int u = Sample(0.5 + 0.4 * sin(x * 6.28 / chroma_w), 16, 240, format.m_Depth);
+            int v = Sample(0.5 + 0.4 * cos(y * 6.28 / chroma_h), 16, 240, format.m_Depth);
+            if (nv12)
+            {
+                Store(planes[1], ((size_t)y * chroma_w + x) * 2, u, format);
+                Store(planes[1], ((size_t)y * chroma_w + x) * 2 + 1, v, format);
+            }
+            else
+            {
+                Store(planes[1], (size_t)y * chroma_w + x, u, format);
+                Store(planes[2], (size_t)y * chroma_w + x, v, format);
+            }
+        }
+    }
+
+    YUVFrame frame;
+    frame.m_Width = width;
+    frame.m_Height = height;
+    frame.m_Layout = format.m_Layout;
+    frame.m_Depth = format.m_Depth;
+    frame.m_Shift = format.m_Shift;
+    frame.m_Matrix = YUVMatrix::BT709;
+    frame.m_FullRange = false;
+    for (int i = 0; i < 3; i++) frame.m_Data[i] = planes[i].empty() ? nullptr : planes[i].data();
+    frame.m_Stride[0] = width * bps;
+    frame.m_Stride[1] = chroma_w * bps * (nv12 ? 2 : 1);
+    frame.m_Stride[2] = nv12 ? 0 : chroma_w * bps;
+    std::vector<uint8_t> sdk((size_t)width * height * 4);
+    ConvertYUVToRGBA(frame, sdk.data(), width * 4);
+
+    std::vector<uint8_t> ref((size_t)width * height * 4);
+    auto ctx = sws_getContext(width, height, format.m_Format, width, height, AV_PIX_FMT_RGBA,
+                              SWS_POINT | SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT, nullptr, nullptr, nullptr);
+    if (!ctx)
+    {
+        printf("%-12s sws_getContext failed\n", format.m_Name);
+        return false;
+    }
+    int *inv_table, *table, src_range, dst_range, brightness, contrast, saturation;
+    sws_getColorspaceDetails(ctx, &inv_table, &src_range, &table, &dst_range, &brightness, &contrast, &saturation);
+    sws_setColorspaceDetails(ctx, sws_getCoefficients(SWS_CS_ITU709), 0, table, 1, brightness, contrast, saturation);
+    const uint8_t* src[4] = { frame.m_Data[0], frame.m_Data[1], frame.m_Data[2], nullptr };
+    int src_stride[4] = { frame.m_Stride[0], frame.m_Stride[1], frame.m_Stride[2], 0 };
+    uint8_t* dst[4] = { ref.data(), nullptr, nullptr, nullptr };
+    int dst_stride[4] = { width * 4, 0, 0, 0 };
+    sws_scale(ctx, src, src_stride, 0, height, dst, dst_stride);
+    sws_freeContext(ctx);
+
+    int max_diff = 0;
+    double sum_diff = 0;
+    for (size_t i = 0; i < sdk.size(); i++)
+    {
+        if ((i & 3) == 3)
+            continue;
+        int diff = abs((int)sdk[i] - (int)ref[i]);
+        max_diff = diff > max_diff ? diff : max_diff;
+        sum_diff += diff;
+    }
+    double mean_diff = sum_diff / ((double)width * height * 3);
+    bool pass = max_diff <= CHECK_MAX_DIFF && mean_diff <= CHECK_MEAN_DIFF;
+    printf("%-12s max %3d mean %6.3f %s\n", format.m_Name, max_diff, mean_diff, pass ? "ok" : "FAILED");
+    return pass;
+}
+
+int main(int argc, char** argv)
+{
+    int width = argc > 1 ? atoi(argv[1]) : 1921;
+    int height = argc > 2 ? atoi(argv[2]) : 1081;
+    if (width <= 0 || height <= 0) { fprintf(stderr, "usage: %s [width] [height]\n", argv[0]); return 1; }
+
+    printf("backend %s, %d x %d\n", YUVConvertBackend(), width, height);
+    bool pass = true;
+    for (auto& format : s_Formats)
+        pass = CheckFormatAt(format, width, height) && pass;
+    return pass ? 0 : 1;
+}